@@ -0,0 +1,268 @@
+#include <benchmark/benchmark.h>
+#include <fea/entitysystem.hpp>
+#if defined(USE_JSONCPP)
+#include <fea/entity/jsonentityloader.hpp>
+#endif
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const std::set<std::string> entityAttributes = {"position", "velocity", "health"};
+    const uint32_t inheritanceDepth = 8;
+
+    void registerAttributes(fea::EntityManager& manager)
+    {
+        manager.registerAttribute<float>("position");
+        manager.registerAttribute<float>("velocity");
+        manager.registerAttribute<int32_t>("health");
+    }
+
+    void createEntities(fea::EntityManager& manager, std::vector<fea::EntityId>& ids, int64_t amount)
+    {
+        for(int64_t i = 0; i < amount; i++)
+            ids.push_back(manager.createEntityHandle(entityAttributes).mIndex);
+    }
+
+    //every template adds one attribute and overrides the value of its parent, the last one inherits all of them
+    void addInheritedTemplates(fea::EntityFactory& factory)
+    {
+        fea::addBasicDataTypes(factory);
+
+        for(uint32_t level = 0; level < inheritanceDepth; level++)
+        {
+            factory.registerAttribute("attribute" + std::to_string(level), "int32");
+
+            fea::EntityTemplate entityTemplate;
+
+            if(level > 0)
+            {
+                entityTemplate.mInherits.push_back("level" + std::to_string(level - 1));
+                entityTemplate.mAttributes["attribute" + std::to_string(level - 1)] = std::to_string(level);
+            }
+
+            entityTemplate.mAttributes["attribute" + std::to_string(level)] = std::to_string(level);
+            factory.addTemplate("level" + std::to_string(level), entityTemplate);
+        }
+    }
+
+    void createRemoveChurn(benchmark::State& state)
+    {
+        fea::EntityManager manager;
+        registerAttributes(manager);
+        std::vector<fea::EntityHandle> handles(state.range(0));
+
+        for(auto _ : state)
+        {
+            for(auto& handle : handles)
+                handle = manager.createEntityHandle(entityAttributes);
+
+            for(auto handle : handles)
+                manager.removeEntity(handle);
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void setAttributeByName(benchmark::State& state)
+    {
+        fea::EntityManager manager;
+        registerAttributes(manager);
+        std::vector<fea::EntityId> ids;
+        createEntities(manager, ids, state.range(0));
+
+        for(auto _ : state)
+        {
+            for(fea::EntityId id : ids)
+                manager.setAttribute<int32_t>(id, "health", static_cast<int32_t>(id));
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void getAttributeByName(benchmark::State& state)
+    {
+        fea::EntityManager manager;
+        registerAttributes(manager);
+        std::vector<fea::EntityId> ids;
+        createEntities(manager, ids, state.range(0));
+
+        for(fea::EntityId id : ids)
+            manager.setAttribute<int32_t>(id, "health", static_cast<int32_t>(id));
+
+        const fea::EntityManager& constManager = manager;
+
+        for(auto _ : state)
+        {
+            int64_t sum = 0;
+
+            for(fea::EntityId id : ids)
+                sum += constManager.getAttribute<int32_t>(id, "health");
+
+            benchmark::DoNotOptimize(sum);
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void getAll(benchmark::State& state)
+    {
+        fea::EntityManager manager;
+        registerAttributes(manager);
+        std::vector<fea::EntityId> ids;
+        createEntities(manager, ids, state.range(0));
+
+        for(auto _ : state)
+        {
+            fea::EntitySet all = manager.getAll();
+            benchmark::DoNotOptimize(all);
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void instantiateInherited(benchmark::State& state)
+    {
+        fea::EntityManager manager;
+        fea::EntityFactory factory(manager);
+        addInheritedTemplates(factory);
+        const std::string name = "level" + std::to_string(inheritanceDepth - 1);
+
+        for(auto _ : state)
+        {
+            for(int64_t i = 0; i < state.range(0); i++)
+                benchmark::DoNotOptimize(factory.instantiate(name));
+
+            state.PauseTiming();
+            manager.removeAll();
+            state.ResumeTiming();
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void instantiateInheritedBatch(benchmark::State& state)
+    {
+        fea::EntityManager manager;
+        fea::EntityFactory factory(manager);
+        addInheritedTemplates(factory);
+        const std::string name = "level" + std::to_string(inheritanceDepth - 1);
+
+        for(auto _ : state)
+        {
+            benchmark::DoNotOptimize(factory.instantiate(name, static_cast<uint32_t>(state.range(0))));
+
+            state.PauseTiming();
+            manager.removeAll();
+            state.ResumeTiming();
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+#if defined(USE_JSONCPP)
+    const std::string templatePath = "fea-entity-bench-templates.json";
+    const std::string templateCachePath = "fea-entity-bench-templates.cache";
+
+    void writeTemplateFile(int64_t amount)
+    {
+        std::ofstream file(templatePath, std::ios::trunc);
+        file << "{\"entities\":[\n{\"name\":\"base\",\"attributes\":{\"position\":\"0\",\"velocity\":\"1\",\"health\":\"\"}}";
+
+        for(int64_t i = 0; i < amount; i++)
+            file << ",\n{\"name\":\"entity" << i << "\",\"inherits\":[\"base\"],\"attributes\":{\"position\":\"" << i << "\",\"health\":\"" << i % 100 << "\"}}";
+
+        file << "]}";
+    }
+
+    void addTemplateAttributes(fea::EntityFactory& factory)
+    {
+        fea::addBasicDataTypes(factory);
+        factory.registerAttribute("position", "float");
+        factory.registerAttribute("velocity", "float");
+        factory.registerAttribute("health", "int32");
+    }
+
+    void loadJsonTemplates(benchmark::State& state)
+    {
+        writeTemplateFile(state.range(0));
+
+        for(auto _ : state)
+        {
+            state.PauseTiming();
+            fea::EntityManager manager;
+            fea::EntityFactory factory(manager);
+            addTemplateAttributes(factory);
+            state.ResumeTiming();
+
+            fea::JsonEntityLoader loader;
+            for(const auto& entityTemplate : loader.loadEntityTemplates(templatePath))
+                factory.addTemplate(entityTemplate.first, entityTemplate.second);
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+        std::remove(templatePath.c_str());
+    }
+
+    void loadCachedJsonTemplates(benchmark::State& state)
+    {
+        writeTemplateFile(state.range(0));
+        std::remove(templateCachePath.c_str());
+
+        //the cache is written by the first load, so that only loading from it is measured
+        {
+            fea::EntityManager manager;
+            fea::EntityFactory factory(manager);
+            addTemplateAttributes(factory);
+            fea::JsonEntityLoader().loadEntityTemplates(templatePath, templateCachePath, factory);
+        }
+
+        for(auto _ : state)
+        {
+            state.PauseTiming();
+            fea::EntityManager manager;
+            fea::EntityFactory factory(manager);
+            addTemplateAttributes(factory);
+            state.ResumeTiming();
+
+            fea::JsonEntityLoader loader;
+            loader.loadEntityTemplates(templatePath, templateCachePath, factory);
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+        std::remove(templatePath.c_str());
+        std::remove(templateCachePath.c_str());
+    }
+#endif
+}
+
+BENCHMARK(createRemoveChurn)->RangeMultiplier(10)->Range(1000, 100000);
+BENCHMARK(setAttributeByName)->RangeMultiplier(10)->Range(1000, 100000);
+BENCHMARK(getAttributeByName)->RangeMultiplier(10)->Range(1000, 100000);
+BENCHMARK(getAll)->RangeMultiplier(10)->Range(1000, 100000);
+BENCHMARK(instantiateInherited)->RangeMultiplier(10)->Range(1000, 100000);
+BENCHMARK(instantiateInheritedBatch)->RangeMultiplier(10)->Range(1000, 100000);
+#if defined(USE_JSONCPP)
+BENCHMARK(loadJsonTemplates)->RangeMultiplier(10)->Range(1000, 100000);
+BENCHMARK(loadCachedJsonTemplates)->RangeMultiplier(10)->Range(1000, 100000);
+#endif
+
+int main(int argc, char** argv)
+{
+    //results are printed as JSON unless another format is asked for, later arguments take precedence
+    std::vector<char*> arguments(argv, argv + argc);
+    char jsonFormat[] = "--benchmark_format=json";
+    arguments.insert(arguments.begin() + 1, jsonFormat);
+    int argumentCount = static_cast<int>(arguments.size());
+
+    benchmark::Initialize(&argumentCount, arguments.data());
+
+    if(benchmark::ReportUnrecognizedArguments(argumentCount, arguments.data()))
+        return 1;
+
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <fea/config.hpp>
+#include <fea/entity/attributecolumn.hpp>
+#include <vector>
+#include <memory>
+#include <stdint.h>
+
+namespace fea
+{
+    class FEA_API Archetype
+    {
+        public:
+            Archetype(const std::vector<uint32_t>& attributes, std::vector<std::unique_ptr<AttributeColumnBase>> columns);
+            const std::vector<uint32_t>& getAttributes() const;
+            bool hasAttribute(uint32_t attribute) const;
+            AttributeColumnBase& getColumn(uint32_t attribute);
+            const AttributeColumnBase& getColumn(uint32_t attribute) const;
+            template<class DataType>
+            AttributeColumn<DataType>& getColumn(uint32_t attribute);
+            template<class DataType>
+            const AttributeColumn<DataType>& getColumn(uint32_t attribute) const;
+            void replaceColumn(uint32_t attribute, std::unique_ptr<AttributeColumnBase> column);
+            uint32_t addRow(uint32_t entityId);
+            void reserve(uint32_t rows);
+            uint32_t removeRow(uint32_t row);
+            uint32_t moveRowTo(uint32_t row, Archetype& target);
+            void swapRows(uint32_t first, uint32_t second);
+            void permuteRows(const std::vector<uint32_t>& order);
+            void markChanged(uint32_t attribute, uint32_t firstRow, uint32_t amount, uint32_t version);
+            uint32_t getChangeVersion(uint32_t attribute, uint32_t row) const;
+            uint32_t getLatestChange(uint32_t attribute) const;
+            void collectMemoryStats(std::vector<AttributeMemoryStats>& attributes, EntityMemoryStats& stats) const;
+            const std::vector<uint32_t>& getEntities() const;
+            uint32_t size() const;
+            void clear();
+        private:
+            std::vector<uint32_t> mAttributes;
+            std::vector<std::unique_ptr<AttributeColumnBase>> mColumns;
+            std::vector<int32_t> mColumnIndices;
+            std::vector<uint32_t> mEntities;
+            std::vector<std::vector<uint32_t>> mChangeVersions;
+            std::vector<uint32_t> mLatestChanges;
+    };
+
+#include <fea/entity/archetype.inl>
+}
@@ -0,0 +1,13 @@
+    template<class DataType>
+    AttributeColumn<DataType>& Archetype::getColumn(uint32_t attribute)
+    {
+        FEA_ASSERT(hasAttribute(attribute), "Trying to access the column of attribute index " + std::to_string(attribute) + " in an archetype which does not have it!");
+        return static_cast<AttributeColumn<DataType>&>(*mColumns[mColumnIndices[attribute]]);
+    }
+
+    template<class DataType>
+    const AttributeColumn<DataType>& Archetype::getColumn(uint32_t attribute) const
+    {
+        FEA_ASSERT(hasAttribute(attribute), "Trying to access the column of attribute index " + std::to_string(attribute) + " in an archetype which does not have it!");
+        return static_cast<const AttributeColumn<DataType>&>(*mColumns[mColumnIndices[attribute]]);
+    }
@@ -0,0 +1,91 @@
+#pragma once
+#include <fea/config.hpp>
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include <new>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <string>
+#include <typeinfo>
+#include <stdint.h>
+#include <fea/assert.hpp>
+#include <fea/entity/binarystream.hpp>
+#include <fea/entity/attributeserializer.hpp>
+#include <fea/entity/entitymemorystats.hpp>
+
+namespace fea
+{
+    class FEA_API AttributeColumnBase
+    {
+        public:
+            virtual std::unique_ptr<AttributeColumnBase> createEmpty() const = 0;
+            virtual uint32_t size() const = 0;
+            virtual void pushUninitialized() = 0;
+            virtual void reserve(uint32_t capacity) = 0;
+            virtual void fillFrom(uint32_t firstRow, uint32_t amount, const void* value) = 0;
+            virtual void swapRemove(uint32_t row) = 0;
+            virtual void moveRowTo(uint32_t row, AttributeColumnBase& target) = 0;
+            virtual void swapRows(uint32_t first, uint32_t second) = 0;
+            virtual void permute(const std::vector<uint32_t>& order) = 0;
+            virtual bool isInitialized(uint32_t row) const = 0;
+            virtual bool isFullyInitialized() const = 0;
+            virtual void serialize(BinaryWriter& writer, const AttributeSerializerBase* serializer) const = 0;
+            virtual bool deserialize(BinaryReader& reader, const AttributeSerializerBase* serializer) = 0;
+            virtual void collectMemoryStats(AttributeMemoryStats& stats) const = 0;
+            virtual void clear() = 0;
+            virtual ~AttributeColumnBase() {}
+    };
+
+    template<class DataType>
+    class AttributeColumn : public AttributeColumnBase
+    {
+        public:
+            AttributeColumn();
+            AttributeColumn(const AttributeColumn& other) = delete;
+            AttributeColumn& operator=(const AttributeColumn& other) = delete;
+            std::unique_ptr<AttributeColumnBase> createEmpty() const override;
+            uint32_t size() const override;
+            void pushUninitialized() override;
+            void reserve(uint32_t capacity) override;
+            void fillFrom(uint32_t firstRow, uint32_t amount, const void* value) override;
+            void swapRemove(uint32_t row) override;
+            void moveRowTo(uint32_t row, AttributeColumnBase& target) override;
+            void swapRows(uint32_t first, uint32_t second) override;
+            void permute(const std::vector<uint32_t>& order) override;
+            bool isInitialized(uint32_t row) const override;
+            bool isFullyInitialized() const override;
+            void serialize(BinaryWriter& writer, const AttributeSerializerBase* serializer) const override;
+            bool deserialize(BinaryReader& reader, const AttributeSerializerBase* serializer) override;
+            void collectMemoryStats(AttributeMemoryStats& stats) const override;
+            void clear() override;
+            void set(uint32_t row, const DataType& value);
+            void fill(uint32_t firstRow, uint32_t amount, const DataType& value);
+            void copy(uint32_t firstRow, uint32_t amount, const DataType* values);
+            const DataType& get(uint32_t row) const;
+            DataType& get(uint32_t row);
+            DataType* data();
+            const DataType* data() const;
+            ~AttributeColumn();
+        private:
+            void reallocate(uint32_t capacity);
+            void destroy(uint32_t row);
+            void fill(uint32_t firstRow, uint32_t amount, const DataType& value, std::true_type);
+            void fill(uint32_t firstRow, uint32_t amount, const DataType& value, std::false_type);
+            void copy(uint32_t firstRow, uint32_t amount, const DataType* values, std::true_type);
+            void copy(uint32_t firstRow, uint32_t amount, const DataType* values, std::false_type);
+            void serialize(BinaryWriter& writer, const AttributeSerializerBase* serializer, std::true_type) const;
+            void serialize(BinaryWriter& writer, const AttributeSerializerBase* serializer, std::false_type) const;
+            bool deserialize(BinaryReader& reader, const AttributeSerializerBase* serializer, const uint8_t* initialized, std::true_type);
+            bool deserialize(BinaryReader& reader, const AttributeSerializerBase* serializer, const uint8_t* initialized, std::false_type);
+            void markInitialized(uint32_t firstRow, uint32_t amount);
+
+            DataType* mData;
+            uint32_t mSize;
+            uint32_t mCapacity;
+            uint32_t mUninitializedCount;
+            std::vector<uint8_t> mInitialized;
+    };
+#include <fea/entity/attributecolumn.inl>
+}
@@ -0,0 +1,411 @@
+    template<class DataType>
+    AttributeColumn<DataType>::AttributeColumn() : mData(nullptr), mSize(0), mCapacity(0), mUninitializedCount(0)
+    {
+    }
+
+    template<class DataType>
+    std::unique_ptr<AttributeColumnBase> AttributeColumn<DataType>::createEmpty() const
+    {
+        return std::unique_ptr<AttributeColumnBase>(new AttributeColumn<DataType>());
+    }
+
+    template<class DataType>
+    uint32_t AttributeColumn<DataType>::size() const
+    {
+        return mSize;
+    }
+
+    template<class DataType>
+    void AttributeColumn<DataType>::pushUninitialized()
+    {
+        if(mSize == mCapacity)
+            reallocate(mCapacity == 0 ? 16 : mCapacity * 2);
+
+        mInitialized.push_back(false);
+        mUninitializedCount++;
+        mSize++;
+    }
+
+    template<class DataType>
+    void AttributeColumn<DataType>::reserve(uint32_t capacity)
+    {
+        //grow geometrically so that repeated small reservations stay cheap
+        if(capacity > mCapacity)
+        {
+            reallocate(std::max(capacity, mCapacity * 2));
+            mInitialized.reserve(mCapacity);
+        }
+    }
+
+    template<class DataType>
+    void AttributeColumn<DataType>::fillFrom(uint32_t firstRow, uint32_t amount, const void* value)
+    {
+        fill(firstRow, amount, *static_cast<const DataType*>(value));
+    }
+
+    template<class DataType>
+    void AttributeColumn<DataType>::swapRemove(uint32_t row)
+    {
+        FEA_ASSERT(row < mSize, "Trying to remove row " + std::to_string(row) + " from an attribute column of size " + std::to_string(mSize) + "!");
+        uint32_t last = mSize - 1;
+
+        if(!mInitialized[row])
+            mUninitializedCount--;
+
+        if(row != last)
+        {
+            if(mInitialized[last])
+            {
+                if(mInitialized[row])
+                    mData[row] = std::move(mData[last]);
+                else
+                    new(mData + row) DataType(std::move(mData[last]));
+                mInitialized[row] = true;
+            }
+            else
+            {
+                destroy(row);
+            }
+        }
+
+        destroy(last);
+        mInitialized.pop_back();
+        mSize--;
+    }
+
+    template<class DataType>
+    void AttributeColumn<DataType>::moveRowTo(uint32_t row, AttributeColumnBase& target)
+    {
+        AttributeColumn<DataType>& targetColumn = static_cast<AttributeColumn<DataType>&>(target);
+        targetColumn.pushUninitialized();
+
+        if(mInitialized[row])
+        {
+            uint32_t targetRow = targetColumn.mSize - 1;
+            new(targetColumn.mData + targetRow) DataType(std::move(mData[row]));
+            targetColumn.mInitialized[targetRow] = true;
+            targetColumn.mUninitializedCount--;
+        }
+    }
+
+    template<class DataType>
+    void AttributeColumn<DataType>::swapRows(uint32_t first, uint32_t second)
+    {
+        FEA_ASSERT(first < mSize && second < mSize, "Trying to swap rows " + std::to_string(first) + " and " + std::to_string(second) + " of an attribute column of size " + std::to_string(mSize) + "!");
+
+        if(mInitialized[first] && mInitialized[second])
+        {
+            using std::swap;
+            swap(mData[first], mData[second]);
+        }
+        else if(mInitialized[first] != mInitialized[second])
+        {
+            uint32_t source = mInitialized[first] ? first : second;
+            uint32_t target = source == first ? second : first;
+            new(mData + target) DataType(std::move(mData[source]));
+            destroy(source);
+            mInitialized[target] = true;
+        }
+    }
+
+    template<class DataType>
+    void AttributeColumn<DataType>::permute(const std::vector<uint32_t>& order)
+    {
+        FEA_ASSERT(order.size() == mSize, "Trying to reorder an attribute column of size " + std::to_string(mSize) + " using an order of " + std::to_string(order.size()) + " rows!");
+        DataType* newData = static_cast<DataType*>(::operator new(sizeof(DataType) * mCapacity));
+        std::vector<uint8_t> newInitialized(mSize, 0);
+        newInitialized.reserve(mInitialized.capacity());
+
+        for(uint32_t row = 0; row < mSize; row++)
+        {
+            uint32_t source = order[row];
+
+            if(mInitialized[source])
+            {
+                new(newData + row) DataType(std::move(mData[source]));
+                mData[source].~DataType();
+                newInitialized[row] = true;
+            }
+        }
+
+        ::operator delete(mData);
+        mData = newData;
+        mInitialized.swap(newInitialized);
+    }
+
+    template<class DataType>
+    bool AttributeColumn<DataType>::isInitialized(uint32_t row) const
+    {
+        return mInitialized[row] != 0;
+    }
+
+    template<class DataType>
+    bool AttributeColumn<DataType>::isFullyInitialized() const
+    {
+        return mUninitializedCount == 0;
+    }
+
+    template<class DataType>
+    void AttributeColumn<DataType>::serialize(BinaryWriter& writer, const AttributeSerializerBase* serializer) const
+    {
+        writer.writeBytes(mInitialized.data(), mSize);
+        serialize(writer, serializer, std::integral_constant<bool, std::is_trivially_copyable<DataType>::value>());
+    }
+
+    template<class DataType>
+    bool AttributeColumn<DataType>::deserialize(BinaryReader& reader, const AttributeSerializerBase* serializer)
+    {
+        //the rows must already exist, only their values are read
+        const uint8_t* initialized = reader.readBytes(mSize);
+
+        if(!initialized)
+            return false;
+
+        return deserialize(reader, serializer, initialized, std::integral_constant<bool, std::is_trivially_copyable<DataType>::value>());
+    }
+
+    template<class DataType>
+    void AttributeColumn<DataType>::collectMemoryStats(AttributeMemoryStats& stats) const
+    {
+        stats.mValueCount += mSize - mUninitializedCount;
+        stats.mSlotCount += mSize;
+        stats.mUsedBytes += sizeof(DataType) * mSize + mInitialized.size();
+        stats.mReservedBytes += sizeof(DataType) * mCapacity + mInitialized.capacity();
+        stats.mAllocationCount += (mData ? 1 : 0) + (mInitialized.capacity() > 0 ? 1 : 0);
+    }
+
+    template<class DataType>
+    void AttributeColumn<DataType>::clear()
+    {
+        for(uint32_t i = 0; i < mSize; i++)
+            destroy(i);
+
+        mInitialized.clear();
+        mUninitializedCount = 0;
+        mSize = 0;
+    }
+
+    template<class DataType>
+    void AttributeColumn<DataType>::set(uint32_t row, const DataType& value)
+    {
+        if(mInitialized[row])
+        {
+            mData[row] = value;
+        }
+        else
+        {
+            new(mData + row) DataType(value);
+            mInitialized[row] = true;
+            mUninitializedCount--;
+        }
+    }
+
+    template<class DataType>
+    void AttributeColumn<DataType>::fill(uint32_t firstRow, uint32_t amount, const DataType& value)
+    {
+        FEA_ASSERT(firstRow + amount <= mSize, "Trying to fill rows " + std::to_string(firstRow) + " to " + std::to_string(firstRow + amount) + " of an attribute column of size " + std::to_string(mSize) + "!");
+        fill(firstRow, amount, value, std::integral_constant<bool, std::is_trivially_copyable<DataType>::value>());
+    }
+
+    template<class DataType>
+    void AttributeColumn<DataType>::copy(uint32_t firstRow, uint32_t amount, const DataType* values)
+    {
+        FEA_ASSERT(firstRow + amount <= mSize, "Trying to copy into rows " + std::to_string(firstRow) + " to " + std::to_string(firstRow + amount) + " of an attribute column of size " + std::to_string(mSize) + "!");
+        copy(firstRow, amount, values, std::integral_constant<bool, std::is_trivially_copyable<DataType>::value>());
+    }
+
+    template<class DataType>
+    const DataType& AttributeColumn<DataType>::get(uint32_t row) const
+    {
+        return mData[row];
+    }
+
+    template<class DataType>
+    DataType& AttributeColumn<DataType>::get(uint32_t row)
+    {
+        return mData[row];
+    }
+
+    template<class DataType>
+    DataType* AttributeColumn<DataType>::data()
+    {
+        return mData;
+    }
+
+    template<class DataType>
+    const DataType* AttributeColumn<DataType>::data() const
+    {
+        return mData;
+    }
+
+    template<class DataType>
+    AttributeColumn<DataType>::~AttributeColumn()
+    {
+        clear();
+        ::operator delete(mData);
+    }
+
+    template<class DataType>
+    void AttributeColumn<DataType>::reallocate(uint32_t capacity)
+    {
+        DataType* newData = static_cast<DataType*>(::operator new(sizeof(DataType) * capacity));
+
+        for(uint32_t i = 0; i < mSize; i++)
+        {
+            if(mInitialized[i])
+            {
+                new(newData + i) DataType(std::move(mData[i]));
+                mData[i].~DataType();
+            }
+        }
+
+        ::operator delete(mData);
+        mData = newData;
+        mCapacity = capacity;
+    }
+
+    template<class DataType>
+    void AttributeColumn<DataType>::fill(uint32_t firstRow, uint32_t amount, const DataType& value, std::true_type)
+    {
+        if(amount == 0)
+            return;
+
+        //every memcpy doubles the amount of filled rows
+        DataType* first = mData + firstRow;
+        std::memcpy(first, &value, sizeof(DataType));
+        uint32_t filled = 1;
+
+        while(filled < amount)
+        {
+            uint32_t chunk = std::min(filled, amount - filled);
+            std::memcpy(first + filled, first, sizeof(DataType) * chunk);
+            filled += chunk;
+        }
+
+        markInitialized(firstRow, amount);
+    }
+
+    template<class DataType>
+    void AttributeColumn<DataType>::fill(uint32_t firstRow, uint32_t amount, const DataType& value, std::false_type)
+    {
+        for(uint32_t row = firstRow; row < firstRow + amount; row++)
+            set(row, value);
+    }
+
+    template<class DataType>
+    void AttributeColumn<DataType>::copy(uint32_t firstRow, uint32_t amount, const DataType* values, std::true_type)
+    {
+        if(amount == 0)
+            return;
+
+        std::memcpy(mData + firstRow, values, sizeof(DataType) * amount);
+        markInitialized(firstRow, amount);
+    }
+
+    template<class DataType>
+    void AttributeColumn<DataType>::copy(uint32_t firstRow, uint32_t amount, const DataType* values, std::false_type)
+    {
+        for(uint32_t i = 0; i < amount; i++)
+            set(firstRow + i, values[i]);
+    }
+
+    template<class DataType>
+    void AttributeColumn<DataType>::markInitialized(uint32_t firstRow, uint32_t amount)
+    {
+        for(uint32_t row = firstRow; row < firstRow + amount; row++)
+        {
+            if(!mInitialized[row])
+            {
+                mInitialized[row] = true;
+                mUninitializedCount--;
+            }
+        }
+    }
+
+    template<class DataType>
+    void AttributeColumn<DataType>::destroy(uint32_t row)
+    {
+        if(mInitialized[row])
+        {
+            mData[row].~DataType();
+            mInitialized[row] = false;
+        }
+    }
+
+    template<class DataType>
+    void AttributeColumn<DataType>::serialize(BinaryWriter& writer, const AttributeSerializerBase*, std::true_type) const
+    {
+        if(mSize > 0)
+            writer.writeBytes(mData, sizeof(DataType) * mSize);
+    }
+
+    template<class DataType>
+    void AttributeColumn<DataType>::serialize(BinaryWriter& writer, const AttributeSerializerBase* serializer, std::false_type) const
+    {
+        const AttributeSerializer<DataType>* typedSerializer = static_cast<const AttributeSerializer<DataType>*>(serializer);
+
+        for(uint32_t row = 0; row < mSize; row++)
+        {
+            if(mInitialized[row])
+            {
+                FEA_ASSERT(typedSerializer != nullptr, std::string("Trying to serialize a value of type '") + typeid(DataType).name() + "' which is not trivially copyable, but no serializer has been registered for it!");
+                typedSerializer->mSerialize(mData[row], writer);
+            }
+        }
+    }
+
+    template<class DataType>
+    bool AttributeColumn<DataType>::deserialize(BinaryReader& reader, const AttributeSerializerBase*, const uint8_t* initialized, std::true_type)
+    {
+        const uint8_t* data = reader.readBytes(sizeof(DataType) * mSize);
+
+        if(!data)
+            return false;
+
+        if(mSize > 0)
+            std::memcpy(mData, data, sizeof(DataType) * mSize);
+
+        mUninitializedCount = 0;
+
+        for(uint32_t row = 0; row < mSize; row++)
+        {
+            mInitialized[row] = initialized[row] != 0;
+
+            if(!mInitialized[row])
+                mUninitializedCount++;
+        }
+
+        return true;
+    }
+
+    template<class DataType>
+    bool AttributeColumn<DataType>::deserialize(BinaryReader& reader, const AttributeSerializerBase* serializer, const uint8_t* initialized, std::false_type)
+    {
+        const AttributeSerializer<DataType>* typedSerializer = static_cast<const AttributeSerializer<DataType>*>(serializer);
+
+        for(uint32_t row = 0; row < mSize; row++)
+        {
+            if(initialized[row])
+            {
+                if(!typedSerializer)
+                {
+                    reader.invalidate();
+                    return false;
+                }
+
+                DataType value = typedSerializer->mDeserialize(reader);
+
+                if(!reader.isValid())
+                    return false;
+
+                set(row, value);
+            }
+            else if(mInitialized[row])
+            {
+                destroy(row);
+                mUninitializedCount++;
+            }
+        }
+
+        return true;
+    }
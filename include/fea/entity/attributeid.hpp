@@ -0,0 +1,51 @@
+#pragma once
+#include <fea/config.hpp>
+#include <stdint.h>
+
+namespace fea
+{
+    template<class DataType>
+    struct AttributeId
+    {
+        AttributeId() : mIndex(static_cast<uint32_t>(-1)) {}
+        explicit AttributeId(uint32_t index) : mIndex(index) {}
+        bool isValid() const { return mIndex != static_cast<uint32_t>(-1); }
+        bool operator==(const AttributeId& other) const { return mIndex == other.mIndex; }
+        bool operator!=(const AttributeId& other) const { return mIndex != other.mIndex; }
+        uint32_t mIndex;
+    };
+
+    /** @addtogroup EntitySystem
+     *@{
+     *  @class AttributeId
+     *@}
+     ***
+     *  @class AttributeId
+     *  @brief Compact typed handle to a registered attribute.
+     *
+     *  An AttributeId is returned by EntityManager::registerAttribute and can be passed to the attribute accessing functions of EntityManager and Entity instead of the attribute name. Accessing an attribute through an AttributeId is a couple of array lookups where accessing it by name has to hash the string, so it should be preferred in code that runs every frame. The name based functions remain for loading and tooling.
+     *
+     *  The handle is only valid for the EntityManager that created it, and becomes invalid if that manager is cleared.
+     *  @code
+     *  fea::AttributeId<glm::vec2> positionId = entityManager.registerAttribute<glm::vec2>("position");
+     *  entity->setAttribute(positionId, glm::vec2(1.0f, 2.0f));
+     *  @endcode
+     *  @tparam DataType Type of the attribute.
+     ***
+     *  @fn AttributeId::AttributeId()
+     *  @brief Construct an invalid AttributeId.
+     ***
+     *  @fn AttributeId::AttributeId(uint32_t index)
+     *  @brief Construct an AttributeId referring to the given attribute index.
+     *
+     *  Not meant to be used directly. Get AttributeId instances from EntityManager::registerAttribute or EntityManager::getAttributeId.
+     *  @param index Index of the attribute.
+     ***
+     *  @fn bool AttributeId::isValid() const
+     *  @brief Check if the AttributeId refers to an attribute.
+     *  @return True if valid.
+     ***
+     *  @var AttributeId::mIndex
+     *  @brief Index of the attribute in the EntityStorage.
+     ***/
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include <fea/config.hpp>
+#include <fea/entity/binarystream.hpp>
+#include <functional>
+
+namespace fea
+{
+    struct FEA_API AttributeSerializerBase
+    {
+        virtual ~AttributeSerializerBase() {}
+    };
+
+    template<class DataType>
+    struct AttributeSerializer : public AttributeSerializerBase
+    {
+        std::function<void(const DataType&, BinaryWriter&)> mSerialize;
+        std::function<DataType(BinaryReader&)> mDeserialize;
+    };
+    /** @addtogroup EntitySystem
+     *@{
+     *  @class AttributeSerializer
+     *@}
+     ***
+     *  @class AttributeSerializer
+     *  @brief Functions turning attribute values of one type into bytes and back.
+     *
+     *  Serializers are needed to include attributes of types which are not trivially copyable in an EntitySnapshot. Trivially copyable types are copied as they are and need no serializer. Register serializers using EntityManager::registerSerializer.
+     *  @tparam DataType Type to serialize.
+     ***
+     *  @var AttributeSerializer::mSerialize
+     *  @brief Function writing a value.
+     ***
+     *  @var AttributeSerializer::mDeserialize
+     *  @brief Function reading back a value written by AttributeSerializer::mSerialize.
+     ***/
+}
@@ -0,0 +1,110 @@
+#pragma once
+#include <fea/config.hpp>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace fea
+{
+    class FEA_API BinaryWriter
+    {
+        public:
+            BinaryWriter(std::vector<uint8_t>& buffer);
+            template<class DataType>
+            void write(const DataType& value);
+            void writeBytes(const void* data, size_t size);
+            void writeString(const std::string& string);
+            size_t size() const;
+        private:
+            std::vector<uint8_t>& mBuffer;
+    };
+
+    class FEA_API BinaryReader
+    {
+        public:
+            BinaryReader(const uint8_t* data, size_t size);
+            template<class DataType>
+            DataType read();
+            const uint8_t* readBytes(size_t size);
+            std::string readString();
+            bool isValid() const;
+            bool isAtEnd() const;
+            void invalidate();
+        private:
+            const uint8_t* mCurrent;
+            const uint8_t* mEnd;
+            bool mValid;
+    };
+#include <fea/entity/binarystream.inl>
+    /** @addtogroup EntitySystem
+     *@{
+     *  @class BinaryWriter
+     *  @class BinaryReader
+     *@}
+     ***
+     *  @class BinaryWriter
+     *  @brief Appends values to a byte buffer.
+     *
+     *  Used for the binary formats of the entity system, such as EntityTemplateCache files and EntitySnapshot instances. Values are written in the native byte order and without any padding.
+     ***
+     *  @fn BinaryWriter::BinaryWriter(std::vector<uint8_t>& buffer)
+     *  @brief Construct a writer appending to the given buffer.
+     *  @param buffer Buffer to append to. Must outlive the writer.
+     ***
+     *  @fn void BinaryWriter::write(const DataType& value)
+     *  @brief Append the bytes of a trivially copyable value.
+     *  @tparam DataType Type of the value.
+     *  @param value Value to write.
+     ***
+     *  @fn void BinaryWriter::writeBytes(const void* data, size_t size)
+     *  @brief Append raw bytes.
+     *  @param data Bytes to append.
+     *  @param size Amount of bytes.
+     ***
+     *  @fn void BinaryWriter::writeString(const std::string& string)
+     *  @brief Append a string, prefixed by its length.
+     *  @param string String to write.
+     ***
+     *  @fn size_t BinaryWriter::size() const
+     *  @brief Get the size of the buffer written to.
+     *  @return Size in bytes.
+     ***
+     *  @class BinaryReader
+     *  @brief Reads values from a byte buffer written by a BinaryWriter.
+     *
+     *  Every read is bounds checked. Reading past the end of the buffer invalidates the reader, after which all reads return default values. This makes it safe to read data coming from files or the network, as long as BinaryReader::isValid is checked after reading.
+     ***
+     *  @fn BinaryReader::BinaryReader(const uint8_t* data, size_t size)
+     *  @brief Construct a reader over the given bytes.
+     *  @param data Bytes to read. Must outlive the reader.
+     *  @param size Amount of bytes.
+     ***
+     *  @fn DataType BinaryReader::read()
+     *  @brief Read a trivially copyable value.
+     *  @tparam DataType Type of the value.
+     *  @return The value read, or a default constructed value if the reader is invalid.
+     ***
+     *  @fn const uint8_t* BinaryReader::readBytes(size_t size)
+     *  @brief Read raw bytes.
+     *  @param size Amount of bytes.
+     *  @return Pointer to the bytes, or nullptr if the reader is invalid. The bytes are not necessarily aligned.
+     ***
+     *  @fn std::string BinaryReader::readString()
+     *  @brief Read a string written with BinaryWriter::writeString.
+     *  @return The string read.
+     ***
+     *  @fn bool BinaryReader::isValid() const
+     *  @brief Check if all reads so far stayed inside the buffer.
+     *  @return True if valid.
+     ***
+     *  @fn bool BinaryReader::isAtEnd() const
+     *  @brief Check if the whole buffer has been read.
+     *  @return True if at the end.
+     ***
+     *  @fn void BinaryReader::invalidate()
+     *  @brief Mark the data as invalid.
+     *
+     *  Used when the bytes read do not make sense, so that the rest of the reading fails as well.
+     ***/
+}
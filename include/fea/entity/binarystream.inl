@@ -0,0 +1,17 @@
+    template<class DataType>
+    void BinaryWriter::write(const DataType& value)
+    {
+        writeBytes(&value, sizeof(DataType));
+    }
+
+    template<class DataType>
+    DataType BinaryReader::read()
+    {
+        DataType value = DataType();
+        const uint8_t* data = readBytes(sizeof(DataType));
+
+        if(data)
+            std::memcpy(&value, data, sizeof(DataType));
+
+        return value;
+    }
@@ -0,0 +1,142 @@
+#pragma once
+#include <fea/config.hpp>
+#include <fea/entity/attributeid.hpp>
+#include <fea/assert.hpp>
+#include <new>
+#include <vector>
+#include <stdint.h>
+
+namespace fea
+{
+    class FEA_API CompiledPrototype
+    {
+        struct ValueOperations
+        {
+            void (*mCopy)(void* target, const void* source);
+            void (*mDestroy)(void* value);
+            uint32_t mSize;
+            uint32_t mAlignment;
+        };
+
+        template<class DataType>
+        struct TypedOperations
+        {
+            static void copy(void* target, const void* source);
+            static void destroy(void* value);
+            static const ValueOperations mOperations;
+        };
+
+        public:
+            struct Value
+            {
+                uint32_t mAttribute;
+                uint32_t mOffset;
+                const ValueOperations* mOperations;
+            };
+
+            CompiledPrototype();
+            CompiledPrototype(const CompiledPrototype& other);
+            CompiledPrototype(CompiledPrototype&& other);
+            CompiledPrototype& operator=(CompiledPrototype other);
+            void addAttribute(uint32_t attribute);
+            template<class DataType>
+            void setValue(AttributeId<DataType> attribute, const DataType& value);
+            void clearValue(uint32_t attribute);
+            void merge(const CompiledPrototype& other);
+            const std::vector<uint32_t>& getAttributes() const;
+            const std::vector<Value>& getValues() const;
+            const void* getValueData(const Value& value) const;
+            void setArchetype(uint32_t archetype);
+            uint32_t getArchetype() const;
+            ~CompiledPrototype();
+        private:
+            void insertValue(uint32_t attribute, const ValueOperations* operations, const void* source);
+            uint32_t allocate(uint32_t size, uint32_t alignment);
+            void reallocate(uint32_t capacity);
+
+            std::vector<uint32_t> mAttributes;
+            std::vector<Value> mValues;
+            uint8_t* mData;
+            uint32_t mSize;
+            uint32_t mCapacity;
+            uint32_t mArchetype;
+    };
+#include <fea/entity/compiledprototype.inl>
+
+    /** @addtogroup EntitySystem
+     *@{
+     *  @class CompiledPrototype
+     *@}
+     ***
+     *  @class CompiledPrototype
+     *  @brief Flat, pre-resolved description of an entity to create.
+     *
+     *  A CompiledPrototype holds the sorted list of attribute indices an entity should have, the archetype those attributes resolve to in the EntityManager, and the default values of the attributes. The default values are constructed once and laid out next to each other in a single buffer, sorted by attribute, so creating entities from a prototype only walks that buffer and copies every value into storage, with no name lookups and no per value function objects involved.
+     *
+     *  The EntityFactory compiles all of its templates into instances of this class. They can also be built manually and instantiated using EntityManager::createEntities(const CompiledPrototype& prototype, uint32_t amount), after being resolved with EntityManager::resolvePrototype. A resolved prototype is only valid for the EntityManager it was resolved with, and becomes invalid if that EntityManager is cleared.
+     ***
+     *  @fn CompiledPrototype::CompiledPrototype()
+     *  @brief Construct an empty prototype.
+     ***
+     *  @fn CompiledPrototype::CompiledPrototype(const CompiledPrototype& other)
+     *  @brief Copy a prototype, including all default values.
+     *  @param other Prototype to copy.
+     ***
+     *  @fn CompiledPrototype::CompiledPrototype(CompiledPrototype&& other)
+     *  @brief Move a prototype.
+     *  @param other Prototype to move.
+     ***
+     *  @fn CompiledPrototype& CompiledPrototype::operator=(CompiledPrototype other)
+     *  @brief Assign another prototype to this one.
+     *  @param other Prototype to assign.
+     *  @return Reference to this prototype.
+     ***
+     *  @fn void CompiledPrototype::addAttribute(uint32_t attribute)
+     *  @brief Add an attribute without a default value.
+     *
+     *  Adding an attribute which already exists does nothing. This invalidates the resolved archetype.
+     *  @param attribute Index of the attribute, as given by AttributeId::mIndex.
+     ***
+     *  @fn void CompiledPrototype::setValue(AttributeId<DataType> attribute, const DataType& value)
+     *  @brief Set the default value of an attribute, adding the attribute if needed.
+     *  @tparam DataType Type of the attribute.
+     *  @param attribute ID of the attribute.
+     *  @param value Default value.
+     ***
+     *  @fn void CompiledPrototype::clearValue(uint32_t attribute)
+     *  @brief Remove the default value of an attribute while keeping the attribute.
+     *  @param attribute Index of the attribute.
+     ***
+     *  @fn void CompiledPrototype::merge(const CompiledPrototype& other)
+     *  @brief Add all attributes and default values of another prototype to this one.
+     *
+     *  Default values of the other prototype replace the ones already present. This is how templates inherit from already compiled parent templates.
+     *  @param other Prototype to merge.
+     ***
+     *  @fn const std::vector<uint32_t>& CompiledPrototype::getAttributes() const
+     *  @brief Get the indices of all attributes of the prototype.
+     *  @return Sorted list of attribute indices.
+     ***
+     *  @fn const std::vector<Value>& CompiledPrototype::getValues() const
+     *  @brief Get the default values of the prototype.
+     *  @return List of default values, sorted by attribute index.
+     ***
+     *  @fn const void* CompiledPrototype::getValueData(const Value& value) const
+     *  @brief Get a pointer to the data of a default value.
+     *  @param value Value to get the data of.
+     *  @return Pointer to the stored value.
+     ***
+     *  @fn void CompiledPrototype::setArchetype(uint32_t archetype)
+     *  @brief Set the archetype the attributes of this prototype resolve to.
+     *
+     *  This is done by EntityManager::resolvePrototype.
+     *  @param archetype Index of the archetype.
+     ***
+     *  @fn uint32_t CompiledPrototype::getArchetype() const
+     *  @brief Get the archetype the attributes of this prototype resolve to.
+     *  @return Index of the archetype, or uint32_t(-1) if not resolved.
+     ***
+     *  @fn CompiledPrototype::~CompiledPrototype()
+     *  @brief Destructor.
+     ***/
+}
@@ -0,0 +1,28 @@
+    template<class DataType>
+    void CompiledPrototype::TypedOperations<DataType>::copy(void* target, const void* source)
+    {
+        new(target) DataType(*static_cast<const DataType*>(source));
+    }
+
+    template<class DataType>
+    void CompiledPrototype::TypedOperations<DataType>::destroy(void* value)
+    {
+        static_cast<DataType*>(value)->~DataType();
+    }
+
+    template<class DataType>
+    const CompiledPrototype::ValueOperations CompiledPrototype::TypedOperations<DataType>::mOperations =
+    {
+        &CompiledPrototype::TypedOperations<DataType>::copy,
+        &CompiledPrototype::TypedOperations<DataType>::destroy,
+        static_cast<uint32_t>(sizeof(DataType)),
+        static_cast<uint32_t>(alignof(DataType))
+    };
+
+    template<class DataType>
+    void CompiledPrototype::setValue(AttributeId<DataType> attribute, const DataType& value)
+    {
+        FEA_ASSERT(attribute.isValid(), "Trying to set a prototype value through an invalid attribute ID!");
+        addAttribute(attribute.mIndex);
+        insertValue(attribute.mIndex, &TypedOperations<DataType>::mOperations, &value);
+    }
@@ -11,12 +11,24 @@ namespace fea
             template<class DataType>
             const DataType& getAttribute(const std::string& attribute) const;
             template<class DataType>
+            const DataType& getAttribute(AttributeId<DataType> attribute) const;
+            template<class DataType>
             DataType& getAttribute(const std::string& attribute);
             template<class DataType>
+            DataType& getAttribute(AttributeId<DataType> attribute);
+            template<class DataType>
             void setAttribute(const std::string& attribute, const DataType& value) const;
             template<class DataType>
+            void setAttribute(AttributeId<DataType> attribute, const DataType& value) const;
+            template<class DataType>
             void addToAttribute(const std::string& attribute, const DataType& value) const;
+            template<class DataType>
+            void addToAttribute(AttributeId<DataType> attribute, const DataType& value) const;
             bool hasAttribute(const std::string& attribute) const;
+            template<class DataType>
+            bool hasAttribute(AttributeId<DataType> attribute) const;
+            void addAttribute(const std::string& attribute) const;
+            void removeAttribute(const std::string& attribute) const;
             EntityId getId() const;
             std::unordered_set<std::string> getAttributes() const;
         private:
@@ -53,6 +65,15 @@ namespace fea
      *  @param attribute Name of the attribute to get.
      *  @return Attribute value.
      ***
+     *  @fn const DataType& Entity::getAttribute(AttributeId<DataType> attribute) const
+     *  @brief Get the value of an attribute of the entity using an AttributeId.
+     *
+     *  This avoids hashing the attribute name and should be preferred in code which runs often.
+     *  Assert/undefined behavior when the attribute ID is invalid or the entity does not have the attribute.
+     *  @tparam Type of the attribute to get.
+     *  @param attribute ID of the attribute to get.
+     *  @return Attribute value.
+     ***
      *  @fn DataType& Entity::getAttribute(const std::string& attribute)
      *  @brief Get the value of an attribute of the entity.
      *
@@ -61,6 +82,14 @@ namespace fea
      *  @param attribute Name of the attribute to get.
      *  @return Attribute value.
      ***
+     *  @fn DataType& Entity::getAttribute(AttributeId<DataType> attribute)
+     *  @brief Get the value of an attribute of the entity using an AttributeId.
+     *
+     *  Assert/undefined behavior when the attribute ID is invalid or the entity does not have the attribute.
+     *  @tparam Type of the attribute to get.
+     *  @param attribute ID of the attribute to get.
+     *  @return Attribute value.
+     ***
      *  @fn void Entity::setAttribute(const std::string& attribute, DataType value) const
      *  @brief Set the value of an attribute of the entity.
      *
@@ -69,6 +98,14 @@ namespace fea
      *  @param attribute Name of the attribute to set.
      *  @param value Value to set the attribute to.
      ***
+     *  @fn void Entity::setAttribute(AttributeId<DataType> attribute, const DataType& value) const
+     *  @brief Set the value of an attribute of the entity using an AttributeId.
+     *
+     *  Assert/undefined behavior when the attribute ID is invalid or the entity does not have the attribute.
+     *  @tparam Type of the attribute to set.
+     *  @param attribute ID of the attribute to set.
+     *  @param value Value to set the attribute to.
+     ***
      *  @fn void Entity::addToAttribute(const std::string& attribute, DataType value) const
      *  @brief Add the given value to an attribute of the entity.
      *
@@ -79,12 +116,39 @@ namespace fea
      *  @param attribute Name of the attribute to add to.
      *  @param value Value to add to the attribute.
      ***
+     *  @fn void Entity::addToAttribute(AttributeId<DataType> attribute, const DataType& value) const
+     *  @brief Add the given value to an attribute of the entity using an AttributeId.
+     *
+     *  Needs the operator+ function to be implemented for the target type.
+     *  Assert/undefined behavior when the attribute ID is invalid or the entity does not have the attribute.
+     *  @tparam Type of the attribute to add to.
+     *  @param attribute ID of the attribute to add to.
+     *  @param value Value to add to the attribute.
+     ***
      *  @fn bool Entity::hasAttribute(const std::string& attribute) const
      *  @brief Check if the entity has an attribute.
      *
      *  @param attribute Name of the attribute to check.
      *  @return True if the attribute exists.
      ***
+     *  @fn bool Entity::hasAttribute(AttributeId<DataType> attribute) const
+     *  @brief Check if the entity has an attribute using an AttributeId.
+     *
+     *  @param attribute ID of the attribute to check.
+     *  @return True if the attribute exists.
+     ***
+     *  @fn void Entity::addAttribute(const std::string& attribute) const
+     *  @brief Give the entity an additional attribute.
+     *
+     *  The new attribute is uninitialized until it is set. See EntityManager::addAttribute.
+     *  @param attribute Name of the attribute to add.
+     ***
+     *  @fn void Entity::removeAttribute(const std::string& attribute) const
+     *  @brief Take an attribute away from the entity.
+     *
+     *  See EntityManager::removeAttribute.
+     *  @param attribute Name of the attribute to remove.
+     ***
      *  @fn EntityId Entity::getId() const
      *  @brief Get the ID of an entity.
      *  @return The ID.
@@ -5,6 +5,12 @@ const DataType& Entity::getAttribute(const std::string& attribute) const
     return mEntityManager.getAttribute<DataType>(mId, attribute);
 }
 
+template<class DataType>
+const DataType& Entity::getAttribute(AttributeId<DataType> attribute) const
+{
+    return mEntityManager.getAttribute(mId, attribute);
+}
+
 template<class DataType>
 DataType& Entity::getAttribute(const std::string& attribute)
 {
@@ -12,15 +18,38 @@ DataType& Entity::getAttribute(const std::string& attribute)
     return mEntityManager.getAttribute<DataType>(mId, attribute);
 }
 
+template<class DataType>
+DataType& Entity::getAttribute(AttributeId<DataType> attribute)
+{
+    return mEntityManager.getAttribute(mId, attribute);
+}
+
 template<class DataType>
 void Entity::setAttribute(const std::string& attribute, const DataType& value) const
 {
     mEntityManager.setAttribute<DataType>(mId, attribute, value);
 }
 
+template<class DataType>
+void Entity::setAttribute(AttributeId<DataType> attribute, const DataType& value) const
+{
+    mEntityManager.setAttribute(mId, attribute, value);
+}
+
 template<class DataType>
 void Entity::addToAttribute(const std::string& attribute, const DataType& value) const
 {
     mEntityManager.addToAttribute<DataType>(mId, attribute, value);
 }
 
+template<class DataType>
+void Entity::addToAttribute(AttributeId<DataType> attribute, const DataType& value) const
+{
+    mEntityManager.addToAttribute(mId, attribute, value);
+}
+
+template<class DataType>
+bool Entity::hasAttribute(AttributeId<DataType> attribute) const
+{
+    return mEntityManager.hasAttribute(mId, attribute);
+}
@@ -0,0 +1,169 @@
+#pragma once
+#include <fea/config.hpp>
+#include <fea/entity/entitystorage.hpp>
+#include <fea/entity/attributeid.hpp>
+#include <fea/entity/entityhandle.hpp>
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace fea
+{
+    struct DeferredEntity
+    {
+        DeferredEntity() : mIndex(static_cast<uint32_t>(-1)) {}
+        explicit DeferredEntity(uint32_t index) : mIndex(index) {}
+        uint32_t mIndex;
+    };
+
+    class FEA_API EntityCommandBuffer
+    {
+        class PendingWritesBase
+        {
+            public:
+                virtual void playback(EntityStorage& storage, const std::vector<EntityHandle>& created) = 0;
+                virtual bool isEmpty() const = 0;
+                virtual void clear() = 0;
+                virtual ~PendingWritesBase() {}
+        };
+
+        template<class DataType>
+        class PendingWrites : public PendingWritesBase
+        {
+            struct Write
+            {
+                uint64_t mOrder;
+                uint32_t mId;
+                uint32_t mIndex;
+                bool operator<(const Write& other) const { return mOrder != other.mOrder ? mOrder < other.mOrder : mIndex < other.mIndex; }
+            };
+
+            public:
+                PendingWrites(AttributeId<DataType> attribute);
+                void add(EntityHandle target, bool deferred, const DataType& value);
+                void playback(EntityStorage& storage, const std::vector<EntityHandle>& created) override;
+                bool isEmpty() const override;
+                void clear() override;
+            private:
+                AttributeId<DataType> mAttribute;
+                std::vector<EntityHandle> mTargets;
+                std::vector<uint8_t> mDeferred;
+                std::vector<DataType> mValues;
+        };
+
+        public:
+            DeferredEntity createEntity(const std::set<std::string>& attributes);
+            void removeEntity(EntityHandle handle);
+            template<class DataType>
+            void setAttribute(EntityHandle handle, AttributeId<DataType> attribute, const DataType& attributeData);
+            template<class DataType>
+            void setAttribute(DeferredEntity entity, AttributeId<DataType> attribute, const DataType& attributeData);
+            EntityHandle getCreatedEntity(DeferredEntity entity) const;
+            bool isEmpty() const;
+            void clear();
+        private:
+            template<class DataType>
+            PendingWrites<DataType>& getPendingWrites(AttributeId<DataType> attribute);
+            void playbackCreations(EntityStorage& storage);
+            void playbackWrites(EntityStorage& storage);
+            std::vector<uint32_t> collectRemovals(const EntityStorage& storage) const;
+            void clearCommands();
+
+            std::map<std::set<std::string>, uint32_t> mGroupIndices;
+            std::vector<const std::set<std::string>*> mGroupAttributes;
+            std::vector<uint32_t> mCreations;
+            std::vector<EntityHandle> mCreated;
+            std::vector<std::unique_ptr<PendingWritesBase>> mWrites;
+            std::vector<EntityHandle> mRemovals;
+
+            friend class EntityManager;
+    };
+#include <fea/entity/entitycommandbuffer.inl>
+
+    /** @addtogroup EntitySystem
+     *@{
+     *  @class DeferredEntity
+     *  @class EntityCommandBuffer
+     *@}
+     ***
+     *  @class DeferredEntity
+     *  @brief Refers to an entity which has been recorded for creation in an EntityCommandBuffer but not yet created.
+     ***
+     *  @fn DeferredEntity::DeferredEntity()
+     *  @brief Construct a DeferredEntity which does not refer to anything.
+     ***
+     *  @fn DeferredEntity::DeferredEntity(uint32_t index)
+     *  @brief Construct a DeferredEntity.
+     *
+     *  These are not meant to be constructed manually, but received from EntityCommandBuffer::createEntity.
+     *  @param index Index of the creation command in the buffer.
+     ***
+     *  @var DeferredEntity::mIndex
+     *  @brief Index of the creation command in the buffer.
+     ***
+     *  @class EntityCommandBuffer
+     *  @brief Records structural changes to be applied to an EntityManager at a later point.
+     *
+     *  Creating and removing entities and setting attribute values modifies the EntityManager directly, which is neither thread safe nor allowed while iterating entities. An EntityCommandBuffer records these operations instead, without touching the EntityManager at all, and they are then applied in one go using EntityManager::playback at a point where that is safe, typically after SystemScheduler::run has returned.
+     *
+     *  Recording into a buffer is not synchronised, so every thread should use its own buffer. The buffers are then played back one after the other from a single thread.
+     *
+     *  During playback, commands are not applied in the order they were recorded but sorted to touch the storage in bulk: first all entities are created, grouped by their set of attributes, then all attribute values are written, grouped by attribute and in the order the entities are stored in, and finally all entities are removed. When the same attribute of the same entity is written several times, the value recorded last is kept. Commands referring to entities which no longer exist at playback time are ignored.
+     *
+     *  Example of spawning entities from a worker thread:
+     *  @code
+     *  fea::DeferredEntity bullet = commandBuffer.createEntity({"position", "velocity"});
+     *  commandBuffer.setAttribute(bullet, positionId, position);
+     *  commandBuffer.setAttribute(bullet, velocityId, velocity);
+     *  commandBuffer.removeEntity(shooterHandle);
+     *
+     *  //later, on the main thread
+     *  entityManager.playback(commandBuffer);
+     *  @endcode
+     ***
+     *  @fn DeferredEntity EntityCommandBuffer::createEntity(const std::set<std::string>& attributes)
+     *  @brief Record the creation of an entity.
+     *  @param attributes The names of the attributes the entity should have.
+     *  @return Reference to the entity, usable to set its attributes before it is created and to get its handle after playback.
+     ***
+     *  @fn void EntityCommandBuffer::removeEntity(EntityHandle handle)
+     *  @brief Record the removal of an entity.
+     *  @param handle Handle to the entity to remove.
+     ***
+     *  @fn void EntityCommandBuffer::setAttribute(EntityHandle handle, AttributeId<DataType> attribute, const DataType& attributeData)
+     *  @brief Record setting an attribute of an existing entity.
+     *
+     *  The value is copied into the buffer. Assert/undefined behavior at playback if the entity does not have the attribute.
+     *  @tparam DataType Type of the attribute.
+     *  @param handle Handle to the entity.
+     *  @param attribute ID of the attribute to set.
+     *  @param attributeData Value to set the attribute to.
+     ***
+     *  @fn void EntityCommandBuffer::setAttribute(DeferredEntity entity, AttributeId<DataType> attribute, const DataType& attributeData)
+     *  @brief Record setting an attribute of an entity which is created by this buffer.
+     *
+     *  The value is copied into the buffer. Assert/undefined behavior at playback if the entity is not created with the attribute.
+     *  @tparam DataType Type of the attribute.
+     *  @param entity Entity created by this buffer.
+     *  @param attribute ID of the attribute to set.
+     *  @param attributeData Value to set the attribute to.
+     ***
+     *  @fn EntityHandle EntityCommandBuffer::getCreatedEntity(DeferredEntity entity) const
+     *  @brief Get a handle to an entity which has been created by the last playback of this buffer.
+     *
+     *  This is available until the buffer starts recording entity creations again or is cleared.
+     *  @param entity Entity recorded for creation.
+     *  @return Handle to the created entity.
+     ***
+     *  @fn bool EntityCommandBuffer::isEmpty() const
+     *  @brief Check if the buffer has any recorded commands.
+     *  @return True if there are no commands.
+     ***
+     *  @fn void EntityCommandBuffer::clear()
+     *  @brief Discard all recorded commands.
+     ***/
+}
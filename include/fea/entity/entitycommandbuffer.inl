@@ -0,0 +1,75 @@
+    template<class DataType>
+    EntityCommandBuffer::PendingWrites<DataType>::PendingWrites(AttributeId<DataType> attribute) :
+        mAttribute(attribute)
+    {
+    }
+
+    template<class DataType>
+    void EntityCommandBuffer::PendingWrites<DataType>::add(EntityHandle target, bool deferred, const DataType& value)
+    {
+        mTargets.push_back(target);
+        mDeferred.push_back(deferred);
+        mValues.push_back(value);
+    }
+
+    template<class DataType>
+    void EntityCommandBuffer::PendingWrites<DataType>::playback(EntityStorage& storage, const std::vector<EntityHandle>& created)
+    {
+        std::vector<Write> writes;
+        writes.reserve(mValues.size());
+
+        for(uint32_t i = 0; i < mValues.size(); i++)
+        {
+            EntityHandle target = mDeferred[i] ? created[mTargets[i].mIndex] : mTargets[i];
+
+            if(storage.isValid(target))
+                writes.push_back({storage.getStorageOrder(target.mIndex), target.mIndex, i});
+        }
+
+        //visiting entities in storage order makes the writes walk the columns linearly
+        std::sort(writes.begin(), writes.end());
+
+        for(const Write& write : writes)
+            storage.setData(write.mId, mAttribute, mValues[write.mIndex]);
+    }
+
+    template<class DataType>
+    bool EntityCommandBuffer::PendingWrites<DataType>::isEmpty() const
+    {
+        return mValues.empty();
+    }
+
+    template<class DataType>
+    void EntityCommandBuffer::PendingWrites<DataType>::clear()
+    {
+        mTargets.clear();
+        mDeferred.clear();
+        mValues.clear();
+    }
+
+    template<class DataType>
+    void EntityCommandBuffer::setAttribute(EntityHandle handle, AttributeId<DataType> attribute, const DataType& attributeData)
+    {
+        getPendingWrites(attribute).add(handle, false, attributeData);
+    }
+
+    template<class DataType>
+    void EntityCommandBuffer::setAttribute(DeferredEntity entity, AttributeId<DataType> attribute, const DataType& attributeData)
+    {
+        FEA_ASSERT(entity.mIndex < mCreations.size(), "Trying to set an attribute on a deferred entity which was not created by this command buffer!");
+        getPendingWrites(attribute).add(EntityHandle(entity.mIndex, 0), true, attributeData);
+    }
+
+    template<class DataType>
+    EntityCommandBuffer::PendingWrites<DataType>& EntityCommandBuffer::getPendingWrites(AttributeId<DataType> attribute)
+    {
+        FEA_ASSERT(attribute.isValid(), "Trying to record an attribute write through an invalid attribute ID!");
+
+        if(attribute.mIndex >= mWrites.size())
+            mWrites.resize(attribute.mIndex + 1);
+
+        if(!mWrites[attribute.mIndex])
+            mWrites[attribute.mIndex] = std::unique_ptr<PendingWritesBase>(new PendingWrites<DataType>(attribute));
+
+        return static_cast<PendingWrites<DataType>&>(*mWrites[attribute.mIndex]);
+    }
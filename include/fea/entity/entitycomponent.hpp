@@ -1,23 +1,59 @@
 #pragma once
 #include <fea/config.hpp>
 #include <unordered_map>
+#include <vector>
 #include <fea/entity/entity.hpp>
+#include <fea/entity/attributeid.hpp>
+#include <fea/assert.hpp>
 
 namespace fea
 {
+    class SystemScheduler;
+
     class FEA_API EntityComponent
     {
         public:
+            EntityComponent();
             void entityCreated(WeakEntityPtr entity);
             void entityRemoved(EntityId entityId);
             virtual bool keepEntity(WeakEntityPtr entity) const;
             virtual void entityKept(WeakEntityPtr entity);
             virtual void entityDropped(WeakEntityPtr entity);
             const std::unordered_map<EntityId, WeakEntityPtr>& getEntities() const;
+            virtual void update(SystemScheduler& scheduler);
+            const std::vector<uint32_t>& getReadAttributes() const;
+            const std::vector<uint32_t>& getWrittenAttributes() const;
+            bool conflictsWith(const EntityComponent& other) const;
+            const std::vector<uint32_t>& getSignature() const;
+            bool matchesSignature(const std::vector<uint32_t>& attributes) const;
+            const std::vector<EntityId>& getMembers() const;
+            bool isMember(EntityId id) const;
             virtual ~EntityComponent();
         protected:
+            template<class DataType>
+            void reads(AttributeId<DataType> attribute);
+            template<class DataType>
+            void writes(AttributeId<DataType> attribute);
+            template<class DataType>
+            void require(AttributeId<DataType> attribute);
+            virtual void memberAdded(EntityId id);
+            virtual void memberRemoved(EntityId id);
             std::unordered_map<EntityId, WeakEntityPtr> mEntities;
+        private:
+            void addAccess(std::vector<uint32_t>& accessList, uint32_t attribute);
+            void addMember(EntityId id);
+            void removeMember(EntityId id);
+            void clearMembers();
+            std::vector<uint32_t> mReadAttributes;
+            std::vector<uint32_t> mWrittenAttributes;
+            std::vector<uint32_t> mSignature;
+            std::vector<EntityId> mMembers;
+            std::vector<uint32_t> mMemberIndices;
+            EntityManager* mManager;
+
+            friend class EntityManager;
     };
+#include <fea/entity/entitycomponent.inl>
 
     /** @addtogroup EntitySystem
      *@{
@@ -32,6 +68,23 @@ namespace fea
      *  Components are created by inheriting this class and then specializing their behavior. 
      *
      *  When entities are created and removed, all components must be notified using the EntityComponent::entityCreated and EntityComponent::entityRemoved functions.
+     *
+     *  Alternatively, a component can declare the attributes an entity must have to be processed by it, using EntityComponent::require, and be added to an EntityManager with EntityManager::addComponent. The EntityManager then keeps the list of matching entities, available through EntityComponent::getMembers, up to date as entities are created, removed or gain or lose attributes. The list is a plain array of entity IDs, so iterating it involves no hashing and no Entity instances. The order of the members is not stable since removing a member moves the last member into its place.
+     *
+     *  Components can be run by a SystemScheduler, which calls EntityComponent::update on every component once per frame and runs components at the same time on different threads when that is safe. For this to work, a component declares which attributes it reads and writes, using EntityComponent::reads and EntityComponent::writes, typically in its constructor. Two components which write the same attribute, or where one reads an attribute the other one writes, are never run at the same time. A component which does not declare any attribute access is assumed to access everything, and is therefore never run at the same time as any other component.
+     *
+     *  Example of a component declaring its access:
+     *  @code
+     *  MovementComponent::MovementComponent(fea::EntityManager& entityManager) :
+     *      mMovables(entityManager.view(positionId, velocityId))
+     *  {
+     *      writes(positionId);
+     *      reads(velocityId);
+     *  }
+     *  @endcode
+     ***
+     *  @fn EntityComponent::EntityComponent()
+     *  @brief Construct a component which does not access or require any attributes.
      ***
      *  @fn void EntityComponent::entityCreated(WeakEntityPtr entity)
      *  @brief Let the component know that an entity has been created.
@@ -67,8 +120,78 @@ namespace fea
      *  @brief Get the entities that this component is keeping track of.
      *  @return Map with entities.
      ***
+     *  @fn virtual void EntityComponent::update(SystemScheduler& scheduler)
+     *  @brief Run the component for one frame.
+     *
+     *  Override this function to implement the per frame processing of the component. This is called by SystemScheduler::run, possibly from a worker thread. Only the attributes declared with EntityComponent::reads and EntityComponent::writes may be accessed, and entities must not be created or removed nor gain or lose attributes from within this function. The scheduler can be used to split up the work further with SystemScheduler::parallelForEach.
+     *  @param scheduler Scheduler running the component.
+     ***
+     *  @fn const std::vector<uint32_t>& EntityComponent::getReadAttributes() const
+     *  @brief Get the indices of the attributes this component has declared to read.
+     *  @return Sorted list of attribute indices.
+     ***
+     *  @fn const std::vector<uint32_t>& EntityComponent::getWrittenAttributes() const
+     *  @brief Get the indices of the attributes this component has declared to write.
+     *  @return Sorted list of attribute indices.
+     ***
+     *  @fn bool EntityComponent::conflictsWith(const EntityComponent& other) const
+     *  @brief Check if this component can not safely run at the same time as another component.
+     *  @param other Component to check against.
+     *  @return True if the components access the same attribute and at least one of them writes it, or if one of them does not declare any access.
+     ***
+     *  @fn const std::vector<uint32_t>& EntityComponent::getSignature() const
+     *  @brief Get the indices of the attributes an entity must have to be a member of this component.
+     *  @return Sorted list of attribute indices.
+     ***
+     *  @fn bool EntityComponent::matchesSignature(const std::vector<uint32_t>& attributes) const
+     *  @brief Check if an entity with the given attributes would be a member of this component.
+     *  @param attributes Sorted list of attribute indices of the entity.
+     *  @return True if all required attributes are in the list.
+     ***
+     *  @fn const std::vector<EntityId>& EntityComponent::getMembers() const
+     *  @brief Get the entities which have all attributes required by this component.
+     *
+     *  Only filled in while the component is added to an EntityManager using EntityManager::addComponent.
+     *  @return IDs of the matching entities, in no particular order.
+     ***
+     *  @fn bool EntityComponent::isMember(EntityId id) const
+     *  @brief Check if an entity is a member of this component.
+     *  @param id ID of the entity.
+     *  @return True if the entity is in the list returned by EntityComponent::getMembers.
+     ***
+     *  @fn void EntityComponent::reads(AttributeId<DataType> attribute)
+     *  @brief Declare that this component reads an attribute during EntityComponent::update.
+     *  @tparam DataType Type of the attribute.
+     *  @param attribute ID of the attribute.
+     ***
+     *  @fn void EntityComponent::writes(AttributeId<DataType> attribute)
+     *  @brief Declare that this component writes an attribute during EntityComponent::update.
+     *
+     *  Writing implies reading, so there is no need to also declare the attribute with EntityComponent::reads.
+     *  @tparam DataType Type of the attribute.
+     *  @param attribute ID of the attribute.
+     ***
+     *  @fn void EntityComponent::require(AttributeId<DataType> attribute)
+     *  @brief Declare that only entities having an attribute are members of this component.
+     *
+     *  Must be done before the component is added to an EntityManager, typically in the constructor. Requiring an attribute does not declare any access to it.
+     *  @tparam DataType Type of the attribute.
+     *  @param attribute ID of the attribute.
+     ***
+     *  @fn virtual void EntityComponent::memberAdded(EntityId id)
+     *  @brief Handle an entity which has become a member of this component.
+     *
+     *  Override this function to react to entities matching the attributes declared with EntityComponent::require. It is called by the EntityManager right after the entity is created or gains the attributes, so the values of the attributes may not be set yet.
+     *  @param id ID of the new member.
+     ***
+     *  @fn virtual void EntityComponent::memberRemoved(EntityId id)
+     *  @brief Handle an entity which is no longer a member of this component.
+     *
+     *  Called when the entity is removed, loses one of the required attributes, or when the component is removed from the EntityManager. The entity may no longer exist.
+     *  @param id ID of the removed member.
+     ***
      *  @fn virtual EntityComponent::~EntityComponent()
-     *  @brief Destructor.
+     *  @brief Destructor. Removes the component from the EntityManager it has been added to, if any.
      ***
      *  @var EntityComponent::mEntities
      *  @brief Set containing all entities.
@@ -0,0 +1,21 @@
+    template<class DataType>
+    void EntityComponent::reads(AttributeId<DataType> attribute)
+    {
+        FEA_ASSERT(attribute.isValid(), "Trying to declare read access to an invalid attribute ID!");
+        addAccess(mReadAttributes, attribute.mIndex);
+    }
+
+    template<class DataType>
+    void EntityComponent::writes(AttributeId<DataType> attribute)
+    {
+        FEA_ASSERT(attribute.isValid(), "Trying to declare write access to an invalid attribute ID!");
+        addAccess(mWrittenAttributes, attribute.mIndex);
+    }
+
+    template<class DataType>
+    void EntityComponent::require(AttributeId<DataType> attribute)
+    {
+        FEA_ASSERT(attribute.isValid(), "Trying to require an invalid attribute ID!");
+        FEA_ASSERT(mManager == nullptr, "Trying to change the required attributes of a component which has already been added to an EntityManager!");
+        addAccess(mSignature, attribute.mIndex);
+    }
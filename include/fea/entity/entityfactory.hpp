@@ -3,13 +3,17 @@
 #include <fea/entity/entitymanager.hpp>
 #include <fea/entity/entitytemplate.hpp>
 #include <fea/entity/entity.hpp>
+#include <fea/entity/instanceoverrides.hpp>
+#include <fea/entity/compiledprototype.hpp>
 #include <functional>
+#include <type_traits>
+#include <typeinfo>
+#include <cstring>
 
 namespace fea
 {
     using Parameters     = std::vector<std::string>;
-    using Setter         = std::function<void(EntityPtr&)>;
-    using Parser         = std::function<Setter(const std::string&)>;
+    using Parser         = std::function<void(CompiledPrototype&, const std::string&)>;
     using Registrator   = std::function<Parser(const std::string&)>;
 
     class FEA_API EntityFactory
@@ -22,26 +26,33 @@ namespace fea
             void addDataType(const std::string& dataTypeName);
             void registerAttribute(const std::string& attribute, const std::string& dataType);
             void addTemplate(const std::string& name, const EntityTemplate& entityTemplate);
+            void addTemplate(const std::string& name, CompiledPrototype prototype);
             bool hasTemplate(const std::string& name) const;
             WeakEntityPtr instantiate(const std::string& name);
+            std::vector<EntityHandle> instantiate(const std::string& name, uint32_t amount);
+            std::vector<EntityHandle> instantiate(const std::string& name, uint32_t amount, const InstanceOverrides& overrides);
+            const CompiledPrototype& getPrototype(const std::string& name) const;
+            bool hasAttribute(const std::string& attribute) const;
+            void parseValue(CompiledPrototype& prototype, const std::string& attribute, const std::string& arguments) const;
+            uint32_t getRawValueSize(const std::string& attribute) const;
+            const std::string& getRawValueType(const std::string& attribute) const;
+            void setRawValue(CompiledPrototype& prototype, const std::string& attribute, const void* data) const;
         private:
-            Parameters splitByDelimeter(const std::string& in, char delimeter) const;
-
-            struct Prototype
+            struct RawParser
             {
-                struct Value
-                {
-                    bool operator<(const Value& other) const;
-                    std::string mKey;
-                    Setter mSetter;
-                };
-
-                std::set<std::string> attributes;
-                std::set<Value> values;
+                uint32_t mSize;
+                std::string mType;
+                std::function<void(CompiledPrototype&, const void*)> mParse;
             };
+            template<typename Type>
+            void addRawParser(const std::string& attribute, const std::string& dataTypeName, AttributeId<Type> attributeId, std::true_type);
+            template<typename Type>
+            void addRawParser(const std::string& attribute, const std::string& dataTypeName, AttributeId<Type> attributeId, std::false_type);
+            Parameters splitByDelimeter(const std::string& in, char delimeter) const;
 
-            std::unordered_map<std::string, Prototype> mPrototypes;
+            std::unordered_map<std::string, CompiledPrototype> mPrototypes;
             std::unordered_map<std::string, Parser> mParsers;
+            std::unordered_map<std::string, RawParser> mRawParsers;
             std::unordered_map<std::string, Registrator> mRegistrators;
 
             EntityManager& mManager;
@@ -65,6 +76,8 @@ namespace fea
      *
      *  This template describing a turtle entity has five attributes: health, position, velocity, maxvelocity and collisiontype. All of the attributes have to be registered at the entity manager. The numerical values next to the attribute names are their default values. These are the values that the attributes of a created turtle entity will attain. To give default values to an attribute, a parser function must be provided to the data type registration.
      *
+     *  When a template is added, it is compiled into a CompiledPrototype: the attribute names are resolved to attribute indices and a storage layout once, and the default values are parsed and stored in a flat buffer. Templates inheriting from other templates start out from the already compiled prototypes of their parents. Instantiating a template then only has to copy the prepared values into storage.
+     *
      *  This class needs a reference to an EntityManager instance.
      ***
      *  @fn EntityFactory::EntityFactory(EntityManager& entityManager)
@@ -118,6 +131,15 @@ namespace fea
      *  @param name Name of the template.
      *  @param entityTemplate Template.
      ***
+     *  @fn void EntityFactory::addTemplate(const std::string& name, CompiledPrototype prototype)
+     *  @brief Add an already compiled template.
+     *
+     *  The prototype is resolved with the EntityManager of the factory before it is stored. This is used when loading templates from a binary cache, see EntityTemplateCache.
+     *
+     *  Assert/undefined behavior if the template already exists.
+     *  @param name Name of the template.
+     *  @param prototype Compiled template.
+     ***
      *  @fn bool EntityFactory::hasTemplate(const std::string& name) const
      *  @brief Check if a template has been added.
      *  @param name Name of the template.
@@ -132,5 +154,72 @@ namespace fea
      *
      *  @param name The name of the template to instantiate.
      *  @return A pointer to the created Entity.
+     ***
+     *  @fn std::vector<EntityHandle> EntityFactory::instantiate(const std::string& name, uint32_t amount)
+     *  @brief Create several entities from the given template at once.
+     *
+     *  This is much faster than calling EntityFactory::instantiate(const std::string& name) repeatedly. Storage for all instances is allocated in one go and every default value of the template is copied to all instances in bulk, using memcpy for trivially copyable types. No Entity instances are allocated.
+     *
+     *  Assert/undefined behavior if the template given does not exist.
+     *  @param name The name of the template to instantiate.
+     *  @param amount Amount of entities to create.
+     *  @return Handles to the created entities.
+     ***
+     *  @fn const CompiledPrototype& EntityFactory::getPrototype(const std::string& name) const
+     *  @brief Get the compiled form of a template.
+     *
+     *  Assert/undefined behavior if the template given does not exist.
+     *  @param name The name of the template.
+     *  @return The compiled prototype.
+     ***
+     *  @fn std::vector<EntityHandle> EntityFactory::instantiate(const std::string& name, uint32_t amount, const InstanceOverrides& overrides)
+     *  @brief Create several entities from the given template at once, giving each instance its own value for some attributes.
+     *
+     *  Works like EntityFactory::instantiate(const std::string& name, uint32_t amount) and then writes the values held by the overrides on top of the template values.
+     *
+     *  Assert/undefined behavior if the template given does not exist, or the overrides do not hold exactly one value per instance.
+     *  @param name The name of the template to instantiate.
+     *  @param amount Amount of entities to create.
+     *  @param overrides Per instance attribute values.
+     *  @return Handles to the created entities.
+     ***
+     *  @fn bool EntityFactory::hasAttribute(const std::string& attribute) const
+     *  @brief Check if an attribute has been registered.
+     *  @param attribute Name of the attribute.
+     *  @return True if it exists.
+     ***
+     *  @fn void EntityFactory::parseValue(CompiledPrototype& prototype, const std::string& attribute, const std::string& arguments) const
+     *  @brief Parse a default value and store it in a prototype.
+     *
+     *  This works the same way as the values of an EntityTemplate. If the arguments are empty, the attribute is added to the prototype without a default value.
+     *
+     *  Assert/undefined behavior if the attribute does not exist.
+     *  @param prototype Prototype to store the value in.
+     *  @param attribute Name of the attribute.
+     *  @param arguments Comma separated arguments for the parser of the attribute.
+     ***
+     *  @fn uint32_t EntityFactory::getRawValueSize(const std::string& attribute) const
+     *  @brief Get the size of the raw bytes of a value of an attribute.
+     *
+     *  Only values of trivially copyable data types which have been added with a parser can be stored as raw bytes. For all other attributes, 0 is returned.
+     *
+     *  Assert/undefined behavior if the attribute does not exist.
+     *  @param attribute Name of the attribute.
+     *  @return Size in bytes, or 0 if values of the attribute can't be stored as raw bytes.
+     ***
+     *  @fn const std::string& EntityFactory::getRawValueType(const std::string& attribute) const
+     *  @brief Get a name identifying how the raw bytes of a value of an attribute are interpreted.
+     *
+     *  The name is made of the name of the data type the attribute was registered as and the name of its C++ type, so raw bytes stored for one attribute registration can be checked to be valid for another. Assert/undefined behavior if the attribute does not exist or EntityFactory::getRawValueSize returns 0 for it.
+     *  @param attribute Name of the attribute.
+     *  @return Name of the raw value type.
+     ***
+     *  @fn void EntityFactory::setRawValue(CompiledPrototype& prototype, const std::string& attribute, const void* data) const
+     *  @brief Store a default value given as raw bytes in a prototype.
+     *
+     *  The data does not need to be aligned. Assert/undefined behavior if the attribute does not exist or EntityFactory::getRawValueSize returns 0 for it.
+     *  @param prototype Prototype to store the value in.
+     *  @param attribute Name of the attribute.
+     *  @param data Pointer to EntityFactory::getRawValueSize bytes representing the value.
      ***/
 }
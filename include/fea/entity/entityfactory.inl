@@ -4,18 +4,22 @@ void EntityFactory::addDataType(const std::string& dataTypeName, Function parser
     FEA_ASSERT(mRegistrators.find(dataTypeName) == mRegistrators.end(),"Trying to add data type '" + dataTypeName + "' but it already exists!");
     using Type = typename std::result_of<Function(const Parameters&)>::type;
     //Make attribute registrator
-    mRegistrators[dataTypeName] = [this, parser](const std::string& attributeName)->Parser
+    mRegistrators[dataTypeName] = [this, parser, dataTypeName](const std::string& attributeName)->Parser
     {
-        mManager.registerAttribute<Type>(attributeName);
-        //Make parser
-        return [this, parser, attributeName](const std::string& params)->Setter
+        AttributeId<Type> attributeId = mManager.registerAttribute<Type>(attributeName);
+        addRawParser<Type>(attributeName, dataTypeName, attributeId, std::integral_constant<bool, std::is_trivially_copyable<Type>::value>());
+        //Make parser which compiles the value into a prototype
+        return [this, parser, attributeId](CompiledPrototype& prototype, const std::string& params)
         {
-            auto value = parser(splitByDelimeter(params, ','));
-            //make setter.
-            return [attributeName, value](EntityPtr& entity)
+            if(params.size() > 0)
+            {
+                prototype.setValue<Type>(attributeId, parser(splitByDelimeter(params, ',')));
+            }
+            else
             {
-                entity->setAttribute<Type>(attributeName, value);
-            };
+                prototype.addAttribute(attributeId.mIndex);
+                prototype.clearValue(attributeId.mIndex);
+            }
         };
     };
 }
@@ -27,14 +31,29 @@ void EntityFactory::addDataType(const std::string& dataTypeName)
     //Make attribute registrator
     mRegistrators[dataTypeName] = [this](const std::string& attributeName)->Parser
     {
-        mManager.registerAttribute<Type>(attributeName);
+        AttributeId<Type> attributeId = mManager.registerAttribute<Type>(attributeName);
         //Make parser
-        return [attributeName](const std::string& params)->Setter
+        return [attributeName, attributeId](CompiledPrototype& prototype, const std::string& params)
         {
-            FEA_ASSERT(1 == 0, "Trying to register a template where a default value has been added to the attribute '" + attributeName + "' which doesn't have a parser function!");
-            return [](EntityPtr& entity)
-            {
-            };
+            FEA_ASSERT(params.size() == 0, "Trying to register a template where a default value has been added to the attribute '" + attributeName + "' which doesn't have a parser function!");
+            prototype.addAttribute(attributeId.mIndex);
         };
     };
 }
+
+template<typename Type>
+void EntityFactory::addRawParser(const std::string& attribute, const std::string& dataTypeName, AttributeId<Type> attributeId, std::true_type)
+{
+    //Make parser which takes the value as raw bytes, for loading cached templates
+    mRawParsers[attribute] = RawParser{static_cast<uint32_t>(sizeof(Type)), dataTypeName + " " + typeid(Type).name(), [attributeId](CompiledPrototype& prototype, const void* data)
+    {
+        Type value;
+        std::memcpy(&value, data, sizeof(Type));
+        prototype.setValue<Type>(attributeId, value);
+    }};
+}
+
+template<typename Type>
+void EntityFactory::addRawParser(const std::string&, const std::string&, AttributeId<Type>, std::false_type)
+{
+}
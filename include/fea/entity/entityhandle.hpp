@@ -0,0 +1,45 @@
+#pragma once
+#include <fea/config.hpp>
+#include <stdint.h>
+
+namespace fea
+{
+    struct EntityHandle
+    {
+        EntityHandle() : mIndex(static_cast<uint32_t>(-1)), mGeneration(0) {}
+        EntityHandle(uint32_t index, uint32_t generation) : mIndex(index), mGeneration(generation) {}
+        bool operator==(const EntityHandle& other) const { return mIndex == other.mIndex && mGeneration == other.mGeneration; }
+        bool operator!=(const EntityHandle& other) const { return !(*this == other); }
+        uint32_t mIndex;
+        uint32_t mGeneration;
+    };
+
+    /** @addtogroup EntitySystem
+     *@{
+     *  @class EntityHandle
+     *@}
+     ***
+     *  @class EntityHandle
+     *  @brief Lightweight reference to an entity.
+     *
+     *  An EntityHandle is an alternative to WeakEntityPtr. It consists of the entity ID, which is an index into the storage of the EntityManager, and a generation counter which is increased every time an entity with that ID is removed. This means that a handle to a removed entity is reliably detected as invalid with EntityManager::isValid, even if the ID has been reused by a newer entity.
+     *
+     *  Handles are plain values. They do not allocate, do not involve reference counting and can freely be copied between threads and stored in attributes. Checking if a handle is valid is a constant time array lookup.
+     ***
+     *  @fn EntityHandle::EntityHandle()
+     *  @brief Construct an EntityHandle which does not refer to any entity.
+     ***
+     *  @fn EntityHandle::EntityHandle(uint32_t index, uint32_t generation)
+     *  @brief Construct an EntityHandle.
+     *
+     *  Handles are not meant to be constructed manually, but received from EntityManager::createEntityHandle or EntityManager::getHandle.
+     *  @param index ID of the entity.
+     *  @param generation Generation of the ID.
+     ***
+     *  @var EntityHandle::mIndex
+     *  @brief ID of the entity the handle refers to.
+     ***
+     *  @var EntityHandle::mGeneration
+     *  @brief Generation of the entity ID at the time the handle was created.
+     ***/
+}
@@ -1,6 +1,12 @@
 #pragma once
 #include <fea/config.hpp>
 #include <fea/entity/entitystorage.hpp>
+#include <fea/entity/attributeid.hpp>
+#include <fea/entity/entityhandle.hpp>
+#include <fea/entity/entityview.hpp>
+#include <fea/entity/entitycommandbuffer.hpp>
+#include <fea/entity/poolallocator.hpp>
+#include <functional>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -11,6 +17,7 @@
 namespace fea
 {
     class Entity;
+    class EntityComponent;
 
     using EntityPtr = std::shared_ptr<Entity>;
     using WeakEntityPtr = std::weak_ptr<Entity>;
@@ -21,27 +28,96 @@ namespace fea
     {
         public:
             WeakEntityPtr createEntity(const std::set<std::string>& attributes);
+            EntityHandle createEntityHandle(const std::set<std::string>& attributes);
+            std::vector<EntityHandle> createEntities(const std::set<std::string>& attributes, uint32_t amount);
+            std::vector<EntityHandle> createEntities(const CompiledPrototype& prototype, uint32_t amount);
+            void resolvePrototype(CompiledPrototype& prototype);
+            void reserveEntities(const std::set<std::string>& attributes, uint32_t amount);
             WeakEntityPtr findEntity(EntityId id) const;
+            WeakEntityPtr findEntity(EntityHandle handle) const;
+            EntityHandle getHandle(EntityId id) const;
+            bool isValid(EntityHandle handle) const;
             void removeEntity(const EntityId id);
+            void removeEntity(EntityHandle handle);
             template<class DataType>
             const DataType& getAttribute(const EntityId id, const std::string& attribute) const;
             template<class DataType>
+            const DataType& getAttribute(const EntityId id, AttributeId<DataType> attribute) const;
+            template<class DataType>
             DataType& getAttribute(const EntityId id, const std::string& attribute);
             template<class DataType>
+            DataType& getAttribute(const EntityId id, AttributeId<DataType> attribute);
+            template<class DataType>
             void setAttribute(const EntityId id, const std::string& attribute, const DataType& attributeData);
             template<class DataType>
+            void setAttribute(const EntityId id, AttributeId<DataType> attribute, const DataType& attributeData);
+            template<class DataType>
+            const DataType& getAttribute(EntityHandle handle, AttributeId<DataType> attribute) const;
+            template<class DataType>
+            DataType& getAttribute(EntityHandle handle, AttributeId<DataType> attribute);
+            template<class DataType>
+            void setAttribute(EntityHandle handle, AttributeId<DataType> attribute, const DataType& attributeData);
+            template<class DataType>
+            void fillAttribute(const std::vector<EntityHandle>& handles, AttributeId<DataType> attribute, const DataType& attributeData);
+            template<class DataType>
+            void setAttributes(const std::vector<EntityHandle>& handles, AttributeId<DataType> attribute, const std::vector<DataType>& attributeData);
+            template<class DataType>
             void addToAttribute(const EntityId id, const std::string& attribute, const DataType& attributeData);
+            template<class DataType>
+            void addToAttribute(const EntityId id, AttributeId<DataType> attribute, const DataType& attributeData);
             bool hasAttribute(const EntityId id, const std::string& attribute) const;
             template<class DataType>
-            void registerAttribute(const std::string& attributeName);
+            bool hasAttribute(const EntityId id, AttributeId<DataType> attribute) const;
+            template<class DataType>
+            bool hasAttribute(EntityHandle handle, AttributeId<DataType> attribute) const;
+            template<class DataType>
+            bool hasValue(const EntityId id, AttributeId<DataType> attribute) const;
+            void addAttribute(const EntityId id, const std::string& attribute);
+            void removeAttribute(const EntityId id, const std::string& attribute);
+            template<class DataType>
+            AttributeId<DataType> registerAttribute(const std::string& attributeName);
+            template<class DataType>
+            AttributeId<DataType> getAttributeId(const std::string& attributeName) const;
             bool attributeIsValid(const std::string& attributeName) const;
             EntitySet getAll() const;
+            template<class DataType, class Function>
+            void forEach(const std::string& attribute, Function function);
+            template<class DataType, class Function>
+            void forEach(AttributeId<DataType> attribute, Function function);
+            template<class DataType, class Function>
+            void forEachChanged(AttributeId<DataType> attribute, uint32_t since, Function function) const;
+            template<class DataType>
+            void markChanged(EntityHandle handle, AttributeId<DataType> attribute);
+            template<class DataType, class Compare = std::less<DataType>>
+            void sortBy(AttributeId<DataType> attribute, Compare compare = Compare());
+            template<class DataType, class Function, class Compare = std::less<DataType>>
+            void forEachSorted(AttributeId<DataType> attribute, Function function, Compare compare = Compare());
+            uint32_t getChangeVersion() const;
+            uint32_t advanceChangeVersion();
+            template<class... DataTypes>
+            EntityView<DataTypes...> view(AttributeId<DataTypes>... attributes);
+            void addComponent(EntityComponent& component);
+            void removeComponent(EntityComponent& component);
+            void playback(EntityCommandBuffer& commandBuffer);
+            template<class DataType>
+            void registerSerializer(std::function<void(const DataType&, BinaryWriter&)> serialize, std::function<DataType(BinaryReader&)> deserialize);
+            EntitySnapshot createSnapshot() const;
+            EntitySnapshot createSnapshot(const EntitySnapshot& base) const;
+            bool restoreSnapshot(const EntitySnapshot& snapshot);
+            bool restoreSnapshot(const EntitySnapshot& snapshot, const EntitySnapshot& base);
             void removeAll();
             void clear();
             std::unordered_set<std::string> getAttributes(EntityId id) const;
+            EntityMemoryStats getMemoryStats() const;
+            ~EntityManager();
         private:
-            std::unordered_map<EntityId, EntityPtr> mEntities;
+            void updateMemberships(EntityId id);
+            void updateMemberships(const std::vector<EntityHandle>& handles);
+            void rebuildMemberships();
+            PoolAllocator<Entity> mEntityAllocator;
+            mutable std::vector<EntityPtr> mEntities;
             EntityStorage mStorage;
+            std::vector<EntityComponent*> mComponents;
     };
 #include <fea/entity/entitymanager.inl>
     /** @addtogroup EntitySystem
@@ -78,7 +154,11 @@ namespace fea
      *
      *  Prior to creating any Entity instances, attributes must be registered. Attributes are values belonging to entities. Some examples of attributes includes "health", "weight", "position" and "velocity". The type for the attribute is remembered by the entity manager.  Registration is done using EntityManager::registerAttribute.
      *
+     *  As an alternative to WeakEntityPtr, entities can also be referred to using EntityHandle instances. These are plain values which are cheaper to create, copy and validate. Entities created with EntityManager::createEntityHandle do not allocate an Entity instance unless a WeakEntityPtr to them is requested.
+     *
      *  After attributes have been registered, entities can be created. Entities have zero or more of registered attributes and they can be set for individual entities.
+     *
+     *  Internally, entities which have the exact same set of attributes are grouped into an archetype where the value of each attribute is stored in a contiguous array. Adding or removing attributes moves the entity to another archetype. Removing entities leaves the memory of the arrays in place for later entities, and Entity instances are allocated from a pool owned by the EntityManager, so creating and removing entities at a steady rate does not reach the system allocator.
      ***
      *  @fn WeakEntityPtr EntityManager::createEntity(const std::set<std::string>& attributes)
      *  @brief Create an Entity with the given attributes.
@@ -87,11 +167,68 @@ namespace fea
      *  @param attributes The names of the attributes the entity should have.
      *  @return A pointer to the created Entity.
      ***
+     *  @fn EntityHandle EntityManager::createEntityHandle(const std::set<std::string>& attributes)
+     *  @brief Create an Entity with the given attributes and return a handle to it.
+     *
+     *  Works like EntityManager::createEntity but does not allocate an Entity instance for the created entity. Use this when creating many entities which are accessed through handles and attribute IDs.
+     *  @param attributes The names of the attributes the entity should have.
+     *  @return A handle to the created entity.
+     ***
+     *  @fn std::vector<EntityHandle> EntityManager::createEntities(const std::set<std::string>& attributes, uint32_t amount)
+     *  @brief Create several entities with the same attributes at once.
+     *
+     *  Storage for all entities is allocated in one go, and the created entities are stored next to each other. This makes setting their attributes afterwards using EntityManager::fillAttribute and EntityManager::setAttributes very fast. No Entity instances are allocated.
+     *  @param attributes The names of the attributes the entities should have.
+     *  @param amount Amount of entities to create.
+     *  @return Handles to the created entities.
+     ***
+     *  @fn std::vector<EntityHandle> EntityManager::createEntities(const CompiledPrototype& prototype, uint32_t amount)
+     *  @brief Create several entities from a compiled prototype at once.
+     *
+     *  The entities get the attributes of the prototype and every default value of the prototype is copied to all of them in bulk. This is what EntityFactory uses to instantiate templates.
+     *
+     *  Assert/undefined behavior if the prototype has not been resolved with EntityManager::resolvePrototype.
+     *  @param prototype Prototype to create the entities from.
+     *  @param amount Amount of entities to create.
+     *  @return Handles to the created entities.
+     ***
+     *  @fn void EntityManager::resolvePrototype(CompiledPrototype& prototype)
+     *  @brief Look up the storage layout for the attributes of a prototype and store it in the prototype.
+     *
+     *  This has to be done once after the attributes of the prototype have been set up, before entities can be created from it.
+     *  @param prototype Prototype to resolve.
+     ***
+     *  @fn void EntityManager::reserveEntities(const std::set<std::string>& attributes, uint32_t amount)
+     *  @brief Allocate storage for entities with the given attributes ahead of time.
+     *
+     *  Attribute values are stored in arrays per attribute which grow as entities are created and are reused when entities are removed. After reserving, creating up to the given amount of additional entities with exactly these attributes does not allocate any memory for their values.
+     *  @param attributes The names of the attributes the entities will have.
+     *  @param amount Amount of entities to make room for, on top of the ones which already exist.
+     ***
      *  @fn WeakEntityPtr EntityManager::findEntity(EntityId id) const
      *  @brief Search for an entity with a given ID.
      *  @param id ID of the entity to find.
      *  @return Pointer to the entity. Will be null if no such entity exists.
      ***
+     *  @fn WeakEntityPtr EntityManager::findEntity(EntityHandle handle) const
+     *  @brief Get a pointer to the entity a handle refers to.
+     *  @param handle Handle to the entity.
+     *  @return Pointer to the entity. Will be null if the handle is not valid.
+     ***
+     *  @fn EntityHandle EntityManager::getHandle(EntityId id) const
+     *  @brief Get a handle to an existing entity.
+     *
+     *  Assert/undefined behavior when the entity does not exist.
+     *  @param id ID of the entity.
+     *  @return Handle to the entity.
+     ***
+     *  @fn bool EntityManager::isValid(EntityHandle handle) const
+     *  @brief Check if the entity a handle refers to still exists.
+     *
+     *  This is a constant time lookup. All handles become invalid when the EntityManager is cleared.
+     *  @param handle Handle to check.
+     *  @return True if the entity exists.
+     ***
      *  @fn void EntityManager::removeEntity(const EntityId id)
      *  @brief Remove an Entity. 
      *
@@ -100,6 +237,12 @@ namespace fea
      *
      *  @param id ID of the Entity to remove.
      ***
+     *  @fn void EntityManager::removeEntity(EntityHandle handle)
+     *  @brief Remove the Entity a handle refers to.
+     *
+     *  All handles to the entity become invalid. Assert/undefined behavior when the handle is not valid.
+     *  @param handle Handle to the Entity to remove.
+     ***
      *  @fn const DataType& EntityManager::getAttribute(const EntityId id, const std::string& attribute) const
      *  @brief Retrieve the value of an attribute of a selected Entity. 
      *  
@@ -108,6 +251,16 @@ namespace fea
      *  @param attribute Name of the attribute to get.
      *  @param id ID of the Entity to get the attribute from.
      ***
+     *  @fn const DataType& EntityManager::getAttribute(const EntityId id, AttributeId<DataType> attribute) const
+     *  @brief Retrieve the value of an attribute of a selected Entity using an AttributeId.
+     *  
+     *  This is the fast version of EntityManager::getAttribute(const EntityId id, const std::string& attribute) const which does not need to hash the attribute name.
+     *
+     *  Assert/undefined behavior when the attribute ID is invalid or the entity does not exist or does not have the attribute.
+     *  @tparam DataType of the attribute to get.
+     *  @param attribute ID of the attribute to get.
+     *  @param id ID of the Entity to get the attribute from.
+     ***
      *  @fn DataType& EntityManager::getAttribute(const EntityId id, const std::string& attribute)
      *  @brief Retrieve the value of an attribute of a selected Entity. 
      *  
@@ -116,6 +269,61 @@ namespace fea
      *  @param attribute Name of the attribute to get.
      *  @param id ID of the Entity to get the attribute from.
      ***
+     *  @fn DataType& EntityManager::getAttribute(const EntityId id, AttributeId<DataType> attribute)
+     *  @brief Retrieve the value of an attribute of a selected Entity using an AttributeId.
+     *  
+     *  Assert/undefined behavior when the attribute ID is invalid or the entity does not exist or does not have the attribute.
+     *  @tparam DataType of the attribute to get.
+     *  @param attribute ID of the attribute to get.
+     *  @param id ID of the Entity to get the attribute from.
+     ***
+     *  @fn const DataType& EntityManager::getAttribute(EntityHandle handle, AttributeId<DataType> attribute) const
+     *  @brief Retrieve the value of an attribute of the Entity a handle refers to.
+     *  
+     *  Assert/undefined behavior when the handle or the attribute ID is invalid or the entity does not have the attribute.
+     *  @tparam DataType of the attribute to get.
+     *  @param handle Handle to the Entity to get the attribute from.
+     *  @param attribute ID of the attribute to get.
+     ***
+     *  @fn DataType& EntityManager::getAttribute(EntityHandle handle, AttributeId<DataType> attribute)
+     *  @brief Retrieve the value of an attribute of the Entity a handle refers to.
+     *  
+     *  Assert/undefined behavior when the handle or the attribute ID is invalid or the entity does not have the attribute.
+     *  @tparam DataType of the attribute to get.
+     *  @param handle Handle to the Entity to get the attribute from.
+     *  @param attribute ID of the attribute to get.
+     ***
+     *  @fn void EntityManager::setAttribute(EntityHandle handle, AttributeId<DataType> attribute, const DataType& attributeData)
+     *  @brief Set the value of an attribute of the Entity a handle refers to.
+     *  
+     *  Assert/undefined behavior when the handle or the attribute ID is invalid or the entity does not have the attribute.
+     *  @tparam DataType of the attribute to set.
+     *  @param handle Handle to the Entity to set the attribute of.
+     *  @param attribute ID of the attribute to set.
+     *  @param attributeData Value to set the attribute to.
+     ***
+     *  @fn void EntityManager::fillAttribute(const std::vector<EntityHandle>& handles, AttributeId<DataType> attribute, const DataType& attributeData)
+     *  @brief Set an attribute of several entities to the same value.
+     *
+     *  When the entities are stored next to each other, as the ones created by EntityManager::createEntities are, the values are written in bulk and trivially copyable types are copied using memcpy.
+     *
+     *  Assert/undefined behavior when any of the handles or the attribute ID is invalid or any of the entities does not have the attribute.
+     *  @tparam DataType of the attribute to set.
+     *  @param handles Handles to the entities to set the attribute of.
+     *  @param attribute ID of the attribute to set.
+     *  @param attributeData Value to set the attribute to.
+     ***
+     *  @fn void EntityManager::setAttributes(const std::vector<EntityHandle>& handles, AttributeId<DataType> attribute, const std::vector<DataType>& attributeData)
+     *  @brief Set an attribute of several entities to one value each.
+     *
+     *  Works like EntityManager::fillAttribute but takes one value per entity, in the same order as the handles.
+     *
+     *  Assert/undefined behavior when the amount of values differs from the amount of handles, any of the handles or the attribute ID is invalid or any of the entities does not have the attribute.
+     *  @tparam DataType of the attribute to set.
+     *  @param handles Handles to the entities to set the attribute of.
+     *  @param attribute ID of the attribute to set.
+     *  @param attributeData Values to set the attribute to.
+     ***
      *  @fn void EntityManager::setAttribute(const EntityId id, const std::string& attribute, const DataType& attributeData)
      *  @brief Set the value of an attribute of a selected Entity. 
      *  
@@ -125,6 +333,15 @@ namespace fea
      *  @param attribute Name of the attribute to set.
      *  @param attributeData Value to set the attribute to.
      ***
+     *  @fn void EntityManager::setAttribute(const EntityId id, AttributeId<DataType> attribute, const DataType& attributeData)
+     *  @brief Set the value of an attribute of a selected Entity using an AttributeId.
+     *  
+     *  Assert/undefined behavior when the attribute ID is invalid or the entity does not exist or does not have the attribute.
+     *  @tparam DataType of the attribute to set.
+     *  @param id ID of the Entity to set the attribute of.
+     *  @param attribute ID of the attribute to set.
+     *  @param attributeData Value to set the attribute to.
+     ***
      *  @fn void EntityManager::addToAttribute(const EntityId id, const std::string& attribute, const DataType& attributeData)
      *  @brief Add the given value to an attribute of a selected Entity. 
      *
@@ -137,6 +354,17 @@ namespace fea
      *  @param attribute Name of the attribute to add to.
      *  @param attributeData Value to add to the attribute.
      ***
+     *  @fn void EntityManager::addToAttribute(const EntityId id, AttributeId<DataType> attribute, const DataType& attributeData)
+     *  @brief Add the given value to an attribute of a selected Entity using an AttributeId.
+     *
+     *  Needs the operator+ function to be implemented for the target type.
+     *  
+     *  Assert/undefined behavior when the attribute ID is invalid or the entity does not exist or does not have the attribute.
+     *  @tparam DataType of the attribute to add to.
+     *  @param id ID of the Entity to add the attribute to.
+     *  @param attribute ID of the attribute to add to.
+     *  @param attributeData Value to add to the attribute.
+     ***
      *  @fn bool EntityManager::hasAttribute(const EntityId id, const std::string& attribute) const
      *  @brief Check if an attribute exists for a specific Entity.
      *
@@ -145,7 +373,49 @@ namespace fea
      *  @param attribute Name of the attribute to check for.
      *  @return True if the attribute exists, otherwise false.
      ***
-     *  @fn void EntityManager::registerAttribute(const std::string& attribute)
+     *  @fn bool EntityManager::hasAttribute(const EntityId id, AttributeId<DataType> attribute) const
+     *  @brief Check if an attribute exists for a specific Entity using an AttributeId.
+     *
+     *  Assert/undefined behavior when the entity does not exist.
+     *  @param id Entity to check an attribute for.
+     *  @param attribute ID of the attribute to check for.
+     *  @return True if the attribute exists, otherwise false.
+     ***
+     *  @fn bool EntityManager::hasAttribute(EntityHandle handle, AttributeId<DataType> attribute) const
+     *  @brief Check if the Entity a handle refers to has an attribute.
+     *
+     *  Assert/undefined behavior when the handle is not valid.
+     *  @param handle Handle to the Entity to check an attribute for.
+     *  @param attribute ID of the attribute to check for.
+     *  @return True if the attribute exists, otherwise false.
+     ***
+     *  @fn bool EntityManager::hasValue(const EntityId id, AttributeId<DataType> attribute) const
+     *  @brief Check if an attribute of an Entity has been given a value.
+     *
+     *  Attributes added without a default value have no value until they are set, and getting them is an error. Assert/undefined behavior when the entity does not exist.
+     *  @param id ID of the Entity to check.
+     *  @param attribute ID of the attribute to check.
+     *  @return True if the entity has the attribute and it has a value.
+     ***
+     *  @fn void EntityManager::addAttribute(const EntityId id, const std::string& attribute)
+     *  @brief Give an existing Entity an additional attribute.
+     *
+     *  The new attribute starts out uninitialized and has to be set before it can be read. The values of the other attributes of the Entity are kept. Nothing happens if the Entity already has the attribute.
+     *
+     *  Assert/undefined behavior when the attribute is not registered or the entity does not exist.
+     *  @param id ID of the Entity to add the attribute to.
+     *  @param attribute Name of the attribute to add.
+     ***
+     *  @fn void EntityManager::removeAttribute(const EntityId id, const std::string& attribute)
+     *  @brief Take an attribute away from an existing Entity.
+     *
+     *  The value of the removed attribute is destroyed. Nothing happens if the Entity does not have the attribute.
+     *
+     *  Assert/undefined behavior when the attribute is not registered or the entity does not exist.
+     *  @param id ID of the Entity to remove the attribute from.
+     *  @param attribute Name of the attribute to remove.
+     ***
+     *  @fn AttributeId<DataType> EntityManager::registerAttribute(const std::string& attribute)
      *  @brief Register an attribute.
      *  
      *  For an Entity to be able to have a certain attribute, the attribute needs to be registered, otherwise it can't be stored by the EntityManager. This only needs to be done once for every attribute. 
@@ -154,9 +424,22 @@ namespace fea
      *  @code
      *  entityManager.registerAttribute<int32_t>("Health points");
      *  @endcode
+     *  The returned AttributeId can be stored and used instead of the name to access the attribute more efficiently.
+     *
      *  Assert/undefined behavior when the attribute is already registered.
      *  @tparam DataType Type of the attribute.
      *  @param attribute Name of the attribute to register.
+     *  @return ID of the registered attribute.
+     ***
+     *  @fn AttributeId<DataType> EntityManager::getAttributeId(const std::string& attributeName) const
+     *  @brief Get the AttributeId of a previously registered attribute.
+     *
+     *  Useful for attributes registered through the EntityFactory.
+     *
+     *  Assert/undefined behavior when the attribute is not registered or the wrong template argument is provided.
+     *  @tparam DataType Type of the attribute.
+     *  @param attributeName Name of the attribute.
+     *  @return ID of the attribute.
      ***
      *  @fn bool EntityManager::attributeIsValid(const std::string& attributeName) const
      *  @brief Check if an attribute has been registered.
@@ -167,11 +450,193 @@ namespace fea
      *  @brief Retrieve an EntitySet filled with all entities currently managed by the EntityManager.
      *  @return All entities in a set.
      ***
+     *  @fn void EntityManager::forEach(const std::string& attribute, Function function)
+     *  @brief Call a function for every Entity which has the given attribute set.
+     *
+     *  Entities sharing the same set of attributes are stored together with every attribute in a tightly packed array, so this is a linear scan over memory and is much faster than going through EntityManager::getAll. The function is called as function(EntityId id, DataType& value) and may modify the value. Entities which have the attribute but have not had it set are skipped.
+     *
+     *  Entities must not be created or removed and attributes must not be added or removed from within the function.
+     *
+     *  Assert/undefined behavior when the attribute does not exist or the wrong template argument is provided.
+     *  @tparam DataType Type of the attribute.
+     *  @tparam Function Function to call. Can often be inferred automatically.
+     *  @param attribute Name of the attribute to iterate.
+     *  @param function Function to call for every value.
+     ***
+     *  @fn void EntityManager::forEach(AttributeId<DataType> attribute, Function function)
+     *  @brief Call a function for every Entity which has the given attribute set, using an AttributeId.
+     *
+     *  See EntityManager::forEach(const std::string& attribute, Function function).
+     *  @tparam DataType Type of the attribute.
+     *  @tparam Function Function to call. Can often be inferred automatically.
+     *  @param attribute ID of the attribute to iterate.
+     *  @param function Function to call for every value.
+     ***
+     *  @fn void EntityManager::forEachChanged(AttributeId<DataType> attribute, uint32_t since, Function function) const
+     *  @brief Call a function for every Entity whose value of the given attribute changed after a given change version.
+     *
+     *  Every attribute value remembers the change version that was current when it was last written through EntityManager::setAttribute, EntityManager::fillAttribute, EntityManager::setAttributes, EntityManager::addToAttribute, a non-const EntityManager::getAttribute, a command buffer playback or by being created from a prototype with default values. Restoring a snapshot marks every restored value as changed. Archetypes in which the attribute has not changed are skipped as a whole, so the cost grows with the amount of archetypes that changed rather than with the amount of entities.
+     *
+     *  Writes made through EntityManager::forEach or an EntityView are not tracked, since those give out references to every value whether it is modified or not. Use EntityManager::markChanged for those. Removed entities and removed attributes are not reported.
+     *
+     *  A consumer keeps the version it has seen up to and advances the counter before every pass:
+     *  @code
+     *  uint32_t until = entityManager.advanceChangeVersion();
+     *  entityManager.forEachChanged(positionId, mSeenVersion, [&] (fea::EntityId id, const glm::vec2& position)
+     *  {
+     *      updateSprite(id, position);
+     *  });
+     *  mSeenVersion = until;
+     *  @endcode
+     *  The function is called as function(EntityId id, const DataType& value). Entities whose attribute has not been set are skipped.
+     *
+     *  Assert/undefined behavior when the attribute ID is invalid.
+     *  @tparam DataType Type of the attribute.
+     *  @tparam Function Function to call. Can often be inferred automatically.
+     *  @param attribute ID of the attribute to iterate.
+     *  @param since Only values changed after this version are visited. Give 0 to visit all values.
+     *  @param function Function to call for every changed value.
+     ***
+     *  @fn void EntityManager::markChanged(EntityHandle handle, AttributeId<DataType> attribute)
+     *  @brief Mark an attribute of an entity as changed with the current change version.
+     *
+     *  Needed after modifying a value through an EntityView or EntityManager::forEach for the change to be seen by EntityManager::forEachChanged.
+     *
+     *  Assert/undefined behavior if the handle is not valid or the entity does not have the attribute.
+     *  @tparam DataType Type of the attribute.
+     *  @param handle Handle of the entity.
+     *  @param attribute ID of the attribute.
+     ***
+     *  @fn void EntityManager::sortBy(AttributeId<DataType> attribute, Compare compare)
+     *  @brief Reorder the stored entities so that they are sorted by the value of an attribute.
+     *
+     *  Entities are stored grouped by which attributes they have, and every such group having the attribute is sorted on its own. After sorting, EntityManager::forEach, EntityView and everything else iterating the storage visits the entities of each group in key order. Entities having the attribute without a value come first.
+     *
+     *  The sort is meant to be called every frame. A group which is already sorted is only scanned, and a group in which only a few keys have changed since the last sort is fixed up by moving those entities into place, so the cost follows the amount of changed keys. Groups with many changed keys are sorted from scratch. The sort is stable, and sorting does not count as changing any value.
+     *
+     *  This must not run at the same time as anything else accessing the EntityManager.
+     *  @tparam DataType Type of the attribute.
+     *  @tparam Compare Strict weak ordering of the values, std::less by default.
+     *  @param attribute ID of the attribute to sort by.
+     *  @param compare Comparison function.
+     ***
+     *  @fn void EntityManager::forEachSorted(AttributeId<DataType> attribute, Function function, Compare compare)
+     *  @brief Iterate all values of an attribute in key order, across all entities.
+     *
+     *  The groups sorted by EntityManager::sortBy are merged on the fly, so this gives one ordering over every entity with the attribute without copying or sorting them. The entities must have been sorted by the same attribute and comparison function since they last changed, otherwise the order is unspecified. Entities with equal keys are visited in storage order. Entities having the attribute without a value are skipped.
+     *  @tparam DataType Type of the attribute.
+     *  @tparam Function Callable taking the ID of the entity and a reference to the value.
+     *  @tparam Compare Strict weak ordering of the values, std::less by default.
+     *  @param attribute ID of the attribute.
+     *  @param function Function to call for each value.
+     *  @param compare Comparison function, which must be the same as the one given to EntityManager::sortBy.
+     ***
+     *  @fn uint32_t EntityManager::getChangeVersion() const
+     *  @brief Get the current change version, which is given to every value written from now on.
+     *  @return Current change version. Starts at 1.
+     ***
+     *  @fn uint32_t EntityManager::advanceChangeVersion()
+     *  @brief Advance the change version so that following writes can be told apart from earlier ones.
+     *
+     *  The counter is 32 bit, which is enough for more than two years of advancing once per frame at 60 frames per second.
+     *  @return The change version that was current before advancing. Every write made so far has a version less than or equal to it.
+     ***
+     *  @fn EntityView<DataTypes...> EntityManager::view(AttributeId<DataTypes>... attributes)
+     *  @brief Get an EntityView giving access to all entities which have all of the given attributes.
+     *
+     *  The result set of the view is cached and kept up to date as entities are created, removed or gain or lose attributes, so calling this function repeatedly with the same attributes is cheap.
+     *  @code
+     *  entityManager.view(positionId, velocityId).forEach([] (fea::EntityId id, glm::vec2& position, glm::vec2& velocity)
+     *  {
+     *      position += velocity;
+     *  });
+     *  @endcode
+     *  @tparam DataTypes Types of the attributes. Can be inferred automatically.
+     *  @param attributes IDs of the attributes to view.
+     *  @return View of the matching entities.
+     ***
+     *  @fn void EntityManager::addComponent(EntityComponent& component)
+     *  @brief Let the EntityManager keep the member list of a component up to date.
+     *
+     *  All existing entities having the attributes required by the component, as declared with EntityComponent::require, become members right away. From then on, creating and removing entities, adding and removing attributes, playing back command buffers and restoring snapshots all update the members of the component. Checking an entity against a component only compares the sorted attribute lists, and creating many entities at once checks the whole batch in one go.
+     *
+     *  The component is removed again when it is destroyed, and all components are removed by EntityManager::clear.
+     *
+     *  Assert/undefined behavior if the component does not require any attribute, or has already been added to an EntityManager.
+     *  @param component Component to add.
+     ***
+     *  @fn void EntityManager::removeComponent(EntityComponent& component)
+     *  @brief Stop updating the members of a component, and empty its member list.
+     *  @param component Component to remove. Nothing happens if it has not been added.
+     ***
+     *  @fn void EntityManager::playback(EntityCommandBuffer& commandBuffer)
+     *  @brief Apply all commands recorded in an EntityCommandBuffer and empty it.
+     *
+     *  See EntityCommandBuffer for the order the commands are applied in. Handles to the entities created by the buffer can be retrieved with EntityCommandBuffer::getCreatedEntity afterwards. Like EntityManager::createEntity and EntityManager::removeEntity, this updates the members of the components added with EntityManager::addComponent, notifying them about created entities before the writes are applied and about removed ones afterwards.
+     *  @param commandBuffer Buffer to play back.
+     ***
+     *  @fn void EntityManager::registerSerializer(std::function<void(const DataType&, BinaryWriter&)> serialize, std::function<DataType(BinaryReader&)> deserialize)
+     *  @brief Register functions for writing attribute values of a type to an EntitySnapshot and reading them back.
+     *
+     *  Attributes of trivially copyable types are copied into snapshots as they are and need no serializer. For all other types a serializer must be registered before taking a snapshot which contains values of them. A serializer for std::string is registered by default. Registering a serializer for a type again replaces the previous one.
+     *  @code
+     *  entityManager.registerSerializer<std::vector<int32_t>>([] (const std::vector<int32_t>& values, fea::BinaryWriter& writer)
+     *  {
+     *      writer.write(static_cast<uint32_t>(values.size()));
+     *      writer.writeBytes(values.data(), values.size() * sizeof(int32_t));
+     *  },
+     *  [] (fea::BinaryReader& reader)
+     *  {
+     *      std::vector<int32_t> values(reader.read<uint32_t>());
+     *      const uint8_t* data = reader.readBytes(values.size() * sizeof(int32_t));
+     *      if(data)
+     *          std::memcpy(values.data(), data, values.size() * sizeof(int32_t));
+     *      return values;
+     *  });
+     *  @endcode
+     *  @tparam DataType Type to register the serializer for.
+     *  @param serialize Function writing a value.
+     *  @param deserialize Function reading a value. The reader is checked for validity afterwards, so it does not need to be checked inside the function.
+     ***
+     *  @fn EntitySnapshot EntityManager::createSnapshot() const
+     *  @brief Store all entities and their attributes in an EntitySnapshot.
+     *
+     *  Every attribute column is written in one go, using memcpy for trivially copyable types.
+     *
+     *  Assert/undefined behavior if there are values of a type which is not trivially copyable and has no serializer registered.
+     *  @return The snapshot.
+     ***
+     *  @fn EntitySnapshot EntityManager::createSnapshot(const EntitySnapshot& base) const
+     *  @brief Create a delta snapshot storing only the attribute data which differs from a base snapshot.
+     *
+     *  The entities and the attributes they have are always stored, while the values of an attribute are only stored where they changed. The result can only be restored together with the same base, using EntityManager::restoreSnapshot(const EntitySnapshot& snapshot, const EntitySnapshot& base).
+     *
+     *  Assert/undefined behavior if the base is not a full snapshot, or under the same conditions as EntityManager::createSnapshot().
+     *  @param base Full snapshot to compare with.
+     *  @return The delta snapshot.
+     ***
+     *  @fn bool EntityManager::restoreSnapshot(const EntitySnapshot& snapshot)
+     *  @brief Replace all entities with the ones stored in a full snapshot.
+     *
+     *  Entities get back the same IDs and generations they had when the snapshot was created, so handles taken at that time are valid again. IDs which are free in the snapshot keep a generation newer than any they had before, so handles taken after the snapshot was created stay invalid, and IDs created after the snapshot remain as free IDs. Pointers to entities which do not exist in the snapshot, or which have a different generation in it, are invalidated. Registered attributes are matched by name and type, so the snapshot can be restored in another EntityManager as long as it has all attributes of the snapshot registered. The members of all components added with EntityManager::addComponent are rebuilt afterwards: every previous member is reported with EntityComponent::memberRemoved, then every restored entity matching a component is reported with EntityComponent::memberAdded.
+     *
+     *  The structure and the attribute values of the snapshot are read and validated before anything is changed, and the function fails without modifying the entities if the snapshot is invalid or corrupt, or an attribute is missing.
+     *  @param snapshot Snapshot to restore.
+     *  @return True if the snapshot was restored.
+     ***
+     *  @fn bool EntityManager::restoreSnapshot(const EntitySnapshot& snapshot, const EntitySnapshot& base)
+     *  @brief Replace all entities with the ones stored in a delta snapshot.
+     *
+     *  See EntityManager::restoreSnapshot(const EntitySnapshot& snapshot). Full snapshots can also be given, in which case the base is ignored.
+     *  @param snapshot Delta snapshot to restore.
+     *  @param base The snapshot the delta snapshot was created from.
+     *  @return True if the snapshot was restored.
+     ***
      *  @fn void EntityManager::removeAll()
      *  @brief Remove all Entity instances managed by the EntityManager, leaving all pointers to them invalid.
      ***
      *  @fn void EntityManager::clear()
-     *  @brief Reset the whole state of the EntityManager to the original state. Effectively removing all Entity instances, leaving all pointers to them invalid, as well as clearing out any registered attributes. Not to be confused with EntityManager::removeAll which only removes all entities.
+     *  @brief Reset the whole state of the EntityManager to the original state. Effectively removing all Entity instances, leaving all pointers and handles to them invalid, as well as clearing out any registered attributes and added components. Not to be confused with EntityManager::removeAll which only removes all entities.
      ***    
      *  @fn std::unordered_set<std::string> EntityManager::getAttributes(EntityId id) const
      *  @brief Get a set containing all the attributes of an entity.
@@ -179,5 +644,17 @@ namespace fea
      *  Assert/undefined behavior if the entity does not exist.
      *  @param id Id of the entity to get attributes for.
      *  @return Set with attributes.
+     ***
+     *  @fn EntityMemoryStats EntityManager::getMemoryStats() const
+     *  @brief Measure the memory held by the EntityManager.
+     *
+     *  Reports the memory of every attribute, the bookkeeping of the entities and the Entity instances allocated for WeakEntityPtr access. This walks all archetypes but not the individual entities, so it is cheap enough to call every frame in debug builds. The result can be written to a stream for a human readable dump:
+     *  @code
+     *  std::cout << entityManager.getMemoryStats();
+     *  @endcode
+     *  @return Memory stats.
+     ***
+     *  @fn EntityManager::~EntityManager()
+     *  @brief Destructor. Removes all components added with EntityManager::addComponent.
      ***/
 }
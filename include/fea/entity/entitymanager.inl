@@ -1,35 +1,179 @@
 template<class DataType>
 const DataType& EntityManager::getAttribute(const EntityId id, const std::string& attribute) const
 {
-    FEA_ASSERT(mEntities.find(id) != mEntities.end(), "Trying to get the attribute '" + attribute + "' on entity entity ID '" + std::to_string(id) + "' but such an entity doesn't exist!");
+    FEA_ASSERT(mStorage.hasEntity(id), "Trying to get the attribute '" + attribute + "' on entity entity ID '" + std::to_string(id) + "' but such an entity doesn't exist!");
 
     return mStorage.getData<DataType>(id, attribute);
 }
 
+template<class DataType>
+const DataType& EntityManager::getAttribute(const EntityId id, AttributeId<DataType> attribute) const
+{
+    FEA_ASSERT(mStorage.hasEntity(id), "Trying to get an attribute on entity ID '" + std::to_string(id) + "' but such an entity doesn't exist!");
+
+    return mStorage.getData(id, attribute);
+}
+
 template<class DataType>
 DataType& EntityManager::getAttribute(const EntityId id, const std::string& attribute)
 {
-    FEA_ASSERT(mEntities.find(id) != mEntities.end(), "Trying to get the attribute '" + attribute + "' on entity entity ID '" + std::to_string(id) + "' but such an entity doesn't exist!");
+    FEA_ASSERT(mStorage.hasEntity(id), "Trying to get the attribute '" + attribute + "' on entity entity ID '" + std::to_string(id) + "' but such an entity doesn't exist!");
 
     return mStorage.getData<DataType>(id, attribute);
 }
 
+template<class DataType>
+DataType& EntityManager::getAttribute(const EntityId id, AttributeId<DataType> attribute)
+{
+    FEA_ASSERT(mStorage.hasEntity(id), "Trying to get an attribute on entity ID '" + std::to_string(id) + "' but such an entity doesn't exist!");
+
+    return mStorage.getData(id, attribute);
+}
+
     template<class DataType>
 void EntityManager::setAttribute(const EntityId id, const std::string& attribute, const DataType& attributeData)
 {
-    FEA_ASSERT(mEntities.find(id) != mEntities.end(), "Trying to get the attribute '" + attribute + "' on entity entity ID '" + std::to_string(id) + "' but such an entity doesn't exist!");
+    FEA_ASSERT(mStorage.hasEntity(id), "Trying to get the attribute '" + attribute + "' on entity entity ID '" + std::to_string(id) + "' but such an entity doesn't exist!");
     mStorage.setData(id, attribute, attributeData);
 }
 
+    template<class DataType>
+void EntityManager::setAttribute(const EntityId id, AttributeId<DataType> attribute, const DataType& attributeData)
+{
+    FEA_ASSERT(mStorage.hasEntity(id), "Trying to set an attribute on entity ID '" + std::to_string(id) + "' but such an entity doesn't exist!");
+    mStorage.setData(id, attribute, attributeData);
+}
+
+template<class DataType>
+const DataType& EntityManager::getAttribute(EntityHandle handle, AttributeId<DataType> attribute) const
+{
+    FEA_ASSERT(mStorage.isValid(handle), "Trying to get an attribute on entity ID '" + std::to_string(handle.mIndex) + "' through a handle which is no longer valid!");
+    return mStorage.getData(handle.mIndex, attribute);
+}
+
+template<class DataType>
+DataType& EntityManager::getAttribute(EntityHandle handle, AttributeId<DataType> attribute)
+{
+    FEA_ASSERT(mStorage.isValid(handle), "Trying to get an attribute on entity ID '" + std::to_string(handle.mIndex) + "' through a handle which is no longer valid!");
+    return mStorage.getData(handle.mIndex, attribute);
+}
+
+template<class DataType>
+void EntityManager::setAttribute(EntityHandle handle, AttributeId<DataType> attribute, const DataType& attributeData)
+{
+    FEA_ASSERT(mStorage.isValid(handle), "Trying to set an attribute on entity ID '" + std::to_string(handle.mIndex) + "' through a handle which is no longer valid!");
+    mStorage.setData(handle.mIndex, attribute, attributeData);
+}
+
+template<class DataType>
+void EntityManager::fillAttribute(const std::vector<EntityHandle>& handles, AttributeId<DataType> attribute, const DataType& attributeData)
+{
+    mStorage.fillData(handles, attribute, attributeData);
+}
+
+template<class DataType>
+void EntityManager::setAttributes(const std::vector<EntityHandle>& handles, AttributeId<DataType> attribute, const std::vector<DataType>& attributeData)
+{
+    FEA_ASSERT(handles.size() == attributeData.size(), "Trying to set an attribute on " + std::to_string(handles.size()) + " entities using " + std::to_string(attributeData.size()) + " values!");
+    mStorage.copyData(handles, attribute, attributeData.data());
+}
+
     template<class DataType>
 void EntityManager::addToAttribute(const EntityId id, const std::string& attribute, const DataType& attributeData)
 {
-    FEA_ASSERT(mEntities.find(id) != mEntities.end(), "Trying to add to the attribute '" + attribute + "' on entity entity ID '" + std::to_string(id) + "' but such an entity doesn't exist!");
+    FEA_ASSERT(mStorage.hasEntity(id), "Trying to add to the attribute '" + attribute + "' on entity entity ID '" + std::to_string(id) + "' but such an entity doesn't exist!");
     mStorage.setData(id, attribute, mStorage.getData<DataType>(id, attribute) + attributeData);
 }
 
     template<class DataType>
-void EntityManager::registerAttribute(const std::string& attribute)
+void EntityManager::addToAttribute(const EntityId id, AttributeId<DataType> attribute, const DataType& attributeData)
+{
+    FEA_ASSERT(mStorage.hasEntity(id), "Trying to add to an attribute on entity ID '" + std::to_string(id) + "' but such an entity doesn't exist!");
+    DataType& value = mStorage.getData(id, attribute);
+    value = value + attributeData;
+}
+
+template<class DataType>
+bool EntityManager::hasAttribute(const EntityId id, AttributeId<DataType> attribute) const
+{
+    FEA_ASSERT(mStorage.hasEntity(id), "Trying to check if entity ID '" + std::to_string(id) + "' has an attribute but that entity doesn't exist!");
+    return mStorage.hasData(id, attribute);
+}
+
+template<class DataType>
+bool EntityManager::hasAttribute(EntityHandle handle, AttributeId<DataType> attribute) const
+{
+    FEA_ASSERT(mStorage.isValid(handle), "Trying to check an attribute on entity ID '" + std::to_string(handle.mIndex) + "' through a handle which is no longer valid!");
+    return mStorage.hasData(handle.mIndex, attribute);
+}
+
+template<class DataType>
+bool EntityManager::hasValue(const EntityId id, AttributeId<DataType> attribute) const
+{
+    FEA_ASSERT(mStorage.hasEntity(id), "Trying to check if entity ID '" + std::to_string(id) + "' has a value but that entity doesn't exist!");
+    return mStorage.isInitialized(id, attribute);
+}
+
+    template<class DataType>
+AttributeId<DataType> EntityManager::registerAttribute(const std::string& attribute)
+{
+    return mStorage.registerAttribute<DataType>(attribute);
+}
+
+template<class DataType>
+AttributeId<DataType> EntityManager::getAttributeId(const std::string& attribute) const
+{
+    return mStorage.getAttributeId<DataType>(attribute);
+}
+
+template<class DataType, class Function>
+void EntityManager::forEach(const std::string& attribute, Function function)
+{
+    mStorage.forEach<DataType>(attribute, function);
+}
+
+template<class DataType, class Function>
+void EntityManager::forEach(AttributeId<DataType> attribute, Function function)
+{
+    mStorage.forEach(attribute, function);
+}
+
+template<class DataType, class Function>
+void EntityManager::forEachChanged(AttributeId<DataType> attribute, uint32_t since, Function function) const
+{
+    mStorage.forEachChanged(attribute, since, function);
+}
+
+template<class DataType>
+void EntityManager::markChanged(EntityHandle handle, AttributeId<DataType> attribute)
+{
+    FEA_ASSERT(mStorage.isValid(handle), "Trying to mark an attribute as changed on entity ID '" + std::to_string(handle.mIndex) + "' through a handle which is no longer valid!");
+    mStorage.markChanged(handle.mIndex, attribute);
+}
+
+template<class DataType, class Compare>
+void EntityManager::sortBy(AttributeId<DataType> attribute, Compare compare)
+{
+    mStorage.sortBy(attribute, compare);
+}
+
+template<class DataType, class Function, class Compare>
+void EntityManager::forEachSorted(AttributeId<DataType> attribute, Function function, Compare compare)
+{
+    mStorage.forEachSorted(attribute, function, compare);
+}
+
+template<class... DataTypes>
+EntityView<DataTypes...> EntityManager::view(AttributeId<DataTypes>... attributes)
+{
+    return EntityView<DataTypes...>(mStorage, attributes...);
+}
+
+template<class DataType>
+void EntityManager::registerSerializer(std::function<void(const DataType&, BinaryWriter&)> serialize, std::function<DataType(BinaryReader&)> deserialize)
 {
-    mStorage.registerAttribute<DataType>(attribute);
+    AttributeSerializer<DataType> serializer;
+    serializer.mSerialize = std::move(serialize);
+    serializer.mDeserialize = std::move(deserialize);
+    mStorage.registerSerializer(std::move(serializer));
 }
@@ -0,0 +1,130 @@
+#pragma once
+#include <fea/config.hpp>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace fea
+{
+    struct FEA_API AttributeMemoryStats
+    {
+        AttributeMemoryStats();
+        std::string mName;
+        std::string mType;
+        uint32_t mValueCount;
+        uint32_t mSlotCount;
+        uint32_t mArchetypeCount;
+        size_t mUsedBytes;
+        size_t mReservedBytes;
+        uint32_t mAllocationCount;
+    };
+
+    struct FEA_API EntityMemoryStats
+    {
+        EntityMemoryStats();
+        uint32_t mEntityCount;
+        uint32_t mIdLimit;
+        uint32_t mFreeIdCount;
+        uint32_t mArchetypeCount;
+        uint32_t mQueryCount;
+        uint32_t mEntityInstanceCount;
+        size_t mUsedBytes;
+        size_t mReservedBytes;
+        uint32_t mAllocationCount;
+        float mAttributeIndexLoadFactor;
+        float mSerializerLoadFactor;
+        std::vector<AttributeMemoryStats> mAttributes;
+    };
+
+    FEA_API std::ostream& operator<<(std::ostream& stream, const EntityMemoryStats& stats);
+    /** @addtogroup EntitySystem
+     *@{
+     *  @class AttributeMemoryStats
+     *  @class EntityMemoryStats
+     *@}
+     ***
+     *  @class AttributeMemoryStats
+     *  @brief Memory used by the values of one attribute, summed over all archetypes having the attribute.
+     *
+     *  Only memory owned by the entity system is counted. Memory allocated by the values themselves, such as the characters of a std::string, is not included.
+     ***
+     *  @fn AttributeMemoryStats::AttributeMemoryStats()
+     *  @brief Construct empty stats.
+     ***
+     *  @var AttributeMemoryStats::mName
+     *  @brief Name of the attribute.
+     ***
+     *  @var AttributeMemoryStats::mType
+     *  @brief Implementation defined name of the data type of the attribute, as given by std::type_info::name.
+     ***
+     *  @var AttributeMemoryStats::mValueCount
+     *  @brief Amount of entities which have the attribute set.
+     ***
+     *  @var AttributeMemoryStats::mSlotCount
+     *  @brief Amount of entities which have the attribute, set or not.
+     ***
+     *  @var AttributeMemoryStats::mArchetypeCount
+     *  @brief Amount of archetypes, and thereby separate arrays, storing the attribute.
+     ***
+     *  @var AttributeMemoryStats::mUsedBytes
+     *  @brief Bytes taken by the stored values and the bookkeeping per value.
+     ***
+     *  @var AttributeMemoryStats::mReservedBytes
+     *  @brief Bytes allocated for values and bookkeeping, including room for entities which do not exist yet.
+     ***
+     *  @var AttributeMemoryStats::mAllocationCount
+     *  @brief Amount of heap allocations currently held for the attribute.
+     ***
+     *  @class EntityMemoryStats
+     *  @brief Overview of the memory used by an EntityManager, as returned by EntityManager::getMemoryStats.
+     *
+     *  Can be written to a stream using operator<<, which gives a human readable table meant for memory budgeting.
+     ***
+     *  @fn EntityMemoryStats::EntityMemoryStats()
+     *  @brief Construct empty stats.
+     ***
+     *  @var EntityMemoryStats::mEntityCount
+     *  @brief Amount of existing entities.
+     ***
+     *  @var EntityMemoryStats::mIdLimit
+     *  @brief One more than the highest entity ID handed out so far.
+     ***
+     *  @var EntityMemoryStats::mFreeIdCount
+     *  @brief Amount of IDs of removed entities waiting to be reused.
+     ***
+     *  @var EntityMemoryStats::mArchetypeCount
+     *  @brief Amount of distinct attribute combinations entities have been stored with.
+     ***
+     *  @var EntityMemoryStats::mQueryCount
+     *  @brief Amount of cached view queries.
+     ***
+     *  @var EntityMemoryStats::mEntityInstanceCount
+     *  @brief Amount of Entity instances currently allocated for WeakEntityPtr access.
+     ***
+     *  @var EntityMemoryStats::mUsedBytes
+     *  @brief Bytes in use by all attributes, entity locations, free IDs, archetype entity lists and Entity instances.
+     ***
+     *  @var EntityMemoryStats::mReservedBytes
+     *  @brief Bytes allocated for all of the above, including unused capacity.
+     ***
+     *  @var EntityMemoryStats::mAllocationCount
+     *  @brief Amount of heap allocations held for all of the above.
+     ***
+     *  @var EntityMemoryStats::mAttributeIndexLoadFactor
+     *  @brief Load factor of the hash table mapping attribute names to attribute indices.
+     ***
+     *  @var EntityMemoryStats::mSerializerLoadFactor
+     *  @brief Load factor of the hash table holding snapshot serializers.
+     ***
+     *  @var EntityMemoryStats::mAttributes
+     *  @brief Stats for every registered attribute, in the order they were registered.
+     ***
+     *  @fn std::ostream& operator<<(std::ostream& stream, const EntityMemoryStats& stats)
+     *  @brief Write the stats as a human readable table.
+     *  @param stream Stream to write to.
+     *  @param stats Stats to write.
+     *  @return The stream.
+     ***/
+}
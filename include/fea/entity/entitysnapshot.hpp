@@ -0,0 +1,52 @@
+#pragma once
+#include <fea/config.hpp>
+#include <vector>
+#include <stdint.h>
+
+namespace fea
+{
+    class FEA_API EntitySnapshot
+    {
+        public:
+            EntitySnapshot();
+            EntitySnapshot(std::vector<uint8_t> data);
+            const std::vector<uint8_t>& getData() const;
+            bool isEmpty() const;
+            bool isDelta() const;
+        private:
+            std::vector<uint8_t> mData;
+    };
+    /** @addtogroup EntitySystem
+     *@{
+     *  @class EntitySnapshot
+     *@}
+     ***
+     *  @class EntitySnapshot
+     *  @brief Binary copy of the entire state of an EntityManager.
+     *
+     *  A snapshot holds all entities, their attributes and values, and the bookkeeping needed to hand out the same entity IDs and handle generations after restoring. All of it is stored in one contiguous buffer which can be written to a file or sent over the network as it is, and read back by constructing a snapshot from the bytes.
+     *
+     *  Snapshots are created with EntityManager::createSnapshot and restored with EntityManager::restoreSnapshot. A delta snapshot only stores the attribute data which changed compared to a base snapshot, and can only be restored together with that base.
+     *
+     *  The data is stored in the native byte order, and values of trivially copyable attributes are stored as they are in memory. Snapshots are therefore only portable between builds of the same program on the same kind of platform.
+     ***
+     *  @fn EntitySnapshot::EntitySnapshot()
+     *  @brief Construct an empty snapshot.
+     ***
+     *  @fn EntitySnapshot::EntitySnapshot(std::vector<uint8_t> data)
+     *  @brief Construct a snapshot from bytes previously retrieved using EntitySnapshot::getData.
+     *  @param data Bytes of the snapshot.
+     ***
+     *  @fn const std::vector<uint8_t>& EntitySnapshot::getData() const
+     *  @brief Get the bytes of the snapshot.
+     *  @return Snapshot data.
+     ***
+     *  @fn bool EntitySnapshot::isEmpty() const
+     *  @brief Check if the snapshot holds any data.
+     *  @return True if empty.
+     ***
+     *  @fn bool EntitySnapshot::isDelta() const
+     *  @brief Check if this is a delta snapshot which needs a base snapshot to be restored.
+     *  @return True if delta.
+     ***/
+}
@@ -3,52 +3,136 @@
 #include <stack>
 #include <unordered_map>
 #include <unordered_set>
+#include <map>
 #include <memory>
+#include <numeric>
 #include <set>
+#include <string>
+#include <vector>
 #include <typeindex>
 #include <fea/assert.hpp>
+#include <fea/entity/archetype.hpp>
+#include <fea/entity/attributeid.hpp>
+#include <fea/entity/entityhandle.hpp>
+#include <fea/entity/compiledprototype.hpp>
+#include <fea/entity/attributeserializer.hpp>
+#include <fea/entity/entitysnapshot.hpp>
+#include <fea/entity/entitymemorystats.hpp>
 
 namespace fea
 {
     class FEA_API EntityStorage
     {
-        class StorageEntity
+        struct AttributeInfo
         {
-            public:
-                StorageEntity(const std::set<std::string>& attributeList);
-                template<class DataType>
-                void setData(const std::string& attribute, const DataType& inData);
-                template<class DataType>
-                const DataType& getData(const std::string& attribute) const;
-                template<class DataType>
-                DataType& getData(const std::string& attribute);
-                bool hasData(const std::string& attribute) const;
-                std::unordered_set<std::string> getAttributes() const;
-            private:
-                std::unordered_map<std::string, std::shared_ptr<void>> attributeData;
+            AttributeInfo(const std::string& name, std::type_index type, std::unique_ptr<AttributeColumnBase> emptyColumn);
+            std::string mName;
+            std::type_index mType;
+            std::unique_ptr<AttributeColumnBase> mEmptyColumn;
+        };
+
+        struct EntityLocation
+        {
+            uint32_t mArchetype;
+            uint32_t mRow;
+            uint32_t mGeneration;
+        };
+
+        struct Query
+        {
+            std::vector<uint32_t> mAttributes;
+            std::vector<uint32_t> mArchetypes;
         };
 
         public:
         EntityStorage();
         uint32_t addEntity(const std::set<std::string>& attributeList);
+        std::vector<EntityHandle> addEntities(const std::set<std::string>& attributeList, uint32_t amount);
+        std::vector<EntityHandle> addEntities(const CompiledPrototype& prototype, uint32_t amount);
+        uint32_t findOrCreateArchetype(const std::vector<uint32_t>& attributes);
+        void reserveEntities(const std::set<std::string>& attributeList, uint32_t amount);
         void removeEntity(uint32_t id);
+        bool hasEntity(uint32_t id) const;
+        EntityHandle getHandle(uint32_t id) const;
+        bool isValid(EntityHandle handle) const;
+        uint32_t getIdLimit() const;
+        uint64_t getStorageOrder(uint32_t id) const;
+        uint32_t getArchetypeIndex(uint32_t id) const;
+        void addAttribute(uint32_t id, const std::string& attribute);
+        void removeAttribute(uint32_t id, const std::string& attribute);
+        template<class DataType>
+        AttributeId<DataType> registerAttribute(const std::string& attribute);
         template<class DataType>
-        void registerAttribute(const std::string& attribute);
+        AttributeId<DataType> getAttributeId(const std::string& attribute) const;
         template<class DataType>
         void setData(const uint32_t id, const std::string& attribute, const DataType& inData);
         template<class DataType>
+        void setData(const uint32_t id, AttributeId<DataType> attribute, const DataType& inData);
+        template<class DataType>
+        void fillData(const std::vector<EntityHandle>& handles, AttributeId<DataType> attribute, const DataType& inData);
+        template<class DataType>
+        void copyData(const std::vector<EntityHandle>& handles, AttributeId<DataType> attribute, const DataType* inData);
+        template<class DataType>
         const DataType& getData(const uint32_t id, const std::string& attribute) const;
         template<class DataType>
+        const DataType& getData(const uint32_t id, AttributeId<DataType> attribute) const;
+        template<class DataType>
         DataType& getData(const uint32_t id, const std::string& attribute);
+        template<class DataType>
+        DataType& getData(const uint32_t id, AttributeId<DataType> attribute);
         bool hasData(const uint32_t id, const std::string& attribute) const;
+        template<class DataType>
+        bool hasData(const uint32_t id, AttributeId<DataType> attribute) const;
+        template<class DataType>
+        bool isInitialized(const uint32_t id, AttributeId<DataType> attribute) const;
         bool attributeIsValid(const std::string& attribute) const;
+        template<class DataType, class Function>
+        void forEach(const std::string& attribute, Function function);
+        template<class DataType, class Function>
+        void forEach(AttributeId<DataType> attribute, Function function);
+        template<class DataType, class Function>
+        void forEachChanged(AttributeId<DataType> attribute, uint32_t since, Function function) const;
+        template<class DataType>
+        void markChanged(const uint32_t id, AttributeId<DataType> attribute);
+        template<class DataType, class Compare>
+        void sortBy(AttributeId<DataType> attribute, Compare compare);
+        template<class DataType, class Function, class Compare>
+        void forEachSorted(AttributeId<DataType> attribute, Function function, Compare compare);
+        uint32_t getChangeVersion() const;
+        uint32_t advanceChangeVersion();
+        uint32_t findOrCreateQuery(std::vector<uint32_t> attributes);
+        const std::vector<uint32_t>& getQueryArchetypes(uint32_t query) const;
+        Archetype& getArchetype(uint32_t archetype);
+        const Archetype& getArchetype(uint32_t archetype) const;
+        template<class DataType>
+        void registerSerializer(AttributeSerializer<DataType> serializer);
+        EntitySnapshot createSnapshot(const EntitySnapshot* base) const;
+        bool restoreSnapshot(const EntitySnapshot& snapshot, const EntitySnapshot* base);
         void clear();
         std::unordered_set<std::string> getAttributes(uint32_t id) const;
+        EntityMemoryStats getMemoryStats() const;
+        private:
+        const AttributeSerializerBase* getSerializer(uint32_t attribute) const;
+        void removeAllEntities();
+        uint32_t getAttributeIndex(const std::string& attribute) const;
+        uint32_t acquireId();
+        bool findContiguousRows(const std::vector<EntityHandle>& handles, uint32_t& archetype, uint32_t& firstRow) const;
+        uint32_t findOrCreateArchetype(const std::set<std::string>& attributeList);
+        std::vector<EntityHandle> addEntities(uint32_t archetype, uint32_t amount);
+        template<class DataType>
+        bool attributeIdIsValid(AttributeId<DataType> attribute) const;
+        void moveEntity(uint32_t id, uint32_t targetArchetype);
 
-        std::unordered_map<std::string, std::type_index> mAttributes;
-        std::unordered_map<uint32_t, StorageEntity> mEntities;
+        std::unordered_map<std::string, uint32_t> mAttributeIndices;
+        std::vector<AttributeInfo> mAttributes;
+        std::vector<Archetype> mArchetypes;
+        std::map<std::vector<uint32_t>, uint32_t> mArchetypeIndices;
+        std::vector<Query> mQueries;
+        std::map<std::vector<uint32_t>, uint32_t> mQueryIndices;
+        std::vector<EntityLocation> mLocations;
         std::stack<uint32_t> mFreeIds;
-        uint32_t mNextId;
+        std::unordered_map<std::type_index, std::shared_ptr<AttributeSerializerBase>> mSerializers;
+        uint32_t mChangeVersion;
     };
 #include <fea/entity/entitystorage.inl>
 }
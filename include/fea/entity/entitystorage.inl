@@ -1,62 +1,327 @@
     template<class DataType>
-    void EntityStorage::StorageEntity::setData(const std::string& attribute, const DataType& inData)
+    AttributeId<DataType> EntityStorage::registerAttribute(const std::string& attribute)
     {
-        FEA_ASSERT(attributeData.find(attribute) != attributeData.end(), "Trying to set the attribute '" + attribute + "' on an entity which does not have said attribute!");
-        auto& valuePointer = attributeData.at(attribute);
-
-        if(!valuePointer)
-            valuePointer = std::make_shared<DataType>(inData);
-        else
-            *std::static_pointer_cast<DataType>(valuePointer) = inData;
+        FEA_ASSERT(mAttributeIndices.find(attribute) == mAttributeIndices.end(), "Trying to register attribute '" + attribute + "' as a '"  + std::type_index(typeid(DataType)).name() + std::string(" but there is already an attribute registered with that identifier!"));
+        uint32_t index = static_cast<uint32_t>(mAttributes.size());
+        mAttributeIndices.emplace(attribute, index);
+        mAttributes.emplace_back(attribute, typeid(DataType), std::unique_ptr<AttributeColumnBase>(new AttributeColumn<DataType>()));
+        return AttributeId<DataType>(index);
     }
 
     template<class DataType>
-    const DataType& EntityStorage::StorageEntity::getData(const std::string& attribute) const
+    AttributeId<DataType> EntityStorage::getAttributeId(const std::string& attribute) const
     {
-        FEA_ASSERT(attributeData.find(attribute) != attributeData.end(), "Trying to get the attribute '" + attribute + "' on an entity which does not have said attribute!");
-        auto& valuePointer = attributeData.at(attribute);
+        FEA_ASSERT(mAttributeIndices.find(attribute) != mAttributeIndices.end(), "Trying to get the ID of attribute '" + attribute + "' but such an attribute has not been registered!");
+        FEA_ASSERT(std::type_index(typeid(DataType)) == mAttributes[getAttributeIndex(attribute)].mType, "Trying to get the ID of attibute '" + attribute + "' as a '" + std::type_index(typeid(DataType)).name() + std::string(" but it is of type '") + std::string(mAttributes[getAttributeIndex(attribute)].mType.name()) + "'");
+        return AttributeId<DataType>(getAttributeIndex(attribute));
+    }
 
-        FEA_ASSERT(valuePointer, "Calling getData on attribute '" + attribute + "' which is not initialized!");
-        return *std::static_pointer_cast<DataType>(valuePointer);
+    template<class DataType>
+    void EntityStorage::setData(const uint32_t id, const std::string& attribute, const DataType& inData)
+    {
+        FEA_ASSERT(mAttributeIndices.find(attribute) != mAttributeIndices.end(), "Trying to set the attribute '" + attribute + "' on an entity but such an attribute has not been registered!");
+        FEA_ASSERT(std::type_index(typeid(DataType)) == mAttributes[getAttributeIndex(attribute)].mType, "Trying to set attibute '" + attribute + "' as a '" + std::type_index(typeid(DataType)).name() + std::string(" but it is of type '") + std::string(mAttributes[getAttributeIndex(attribute)].mType.name()) + "'");
+        setData(id, AttributeId<DataType>(getAttributeIndex(attribute)), inData);
     }
 
     template<class DataType>
-    DataType& EntityStorage::StorageEntity::getData(const std::string& attribute)
+    void EntityStorage::setData(const uint32_t id, AttributeId<DataType> attribute, const DataType& inData)
     {
-        FEA_ASSERT(attributeData.find(attribute) != attributeData.end(), "Trying to get the attribute '" + attribute + "' on an entity which does not have said attribute!");
-        auto& valuePointer = attributeData.at(attribute);
+        FEA_ASSERT(attributeIdIsValid(attribute), "Trying to set an attribute as a '" + std::string(std::type_index(typeid(DataType)).name()) + "' through an attribute ID which is invalid or of another type!");
+        FEA_ASSERT(hasEntity(id), "Trying to set the attribute '" + mAttributes[attribute.mIndex].mName + "' on entity ID '" + std::to_string(id) + "' which does not exist!");
+        const EntityLocation& location = mLocations[id];
+        Archetype& archetype = mArchetypes[location.mArchetype];
 
-        FEA_ASSERT(valuePointer, "Calling getData on attribute '" + attribute + "' which is not initialized!");
-        return *std::static_pointer_cast<DataType>(valuePointer);
+        FEA_ASSERT(archetype.hasAttribute(attribute.mIndex), "Trying to set the attribute '" + mAttributes[attribute.mIndex].mName + "' on an entity which does not have said attribute!");
+        archetype.getColumn<DataType>(attribute.mIndex).set(location.mRow, inData);
+        archetype.markChanged(attribute.mIndex, location.mRow, 1, mChangeVersion);
     }
 
     template<class DataType>
-    void EntityStorage::registerAttribute(const std::string& attribute)
+    void EntityStorage::fillData(const std::vector<EntityHandle>& handles, AttributeId<DataType> attribute, const DataType& inData)
     {
-        FEA_ASSERT(mAttributes.find(attribute) == mAttributes.end(), "Trying to register attribute '" + attribute + "' as a '"  + std::type_index(typeid(DataType)).name() + std::string(" but there is already an attribute registered with that identifier!"));
-        mAttributes.emplace(attribute, typeid(DataType));
+        FEA_ASSERT(attributeIdIsValid(attribute), "Trying to fill an attribute as a '" + std::string(std::type_index(typeid(DataType)).name()) + "' through an attribute ID which is invalid or of another type!");
+        uint32_t archetype;
+        uint32_t firstRow;
+
+        if(findContiguousRows(handles, archetype, firstRow) && mArchetypes[archetype].hasAttribute(attribute.mIndex))
+        {
+            mArchetypes[archetype].getColumn<DataType>(attribute.mIndex).fill(firstRow, static_cast<uint32_t>(handles.size()), inData);
+            mArchetypes[archetype].markChanged(attribute.mIndex, firstRow, static_cast<uint32_t>(handles.size()), mChangeVersion);
+        }
+        else
+        {
+            for(EntityHandle handle : handles)
+                setData(handle.mIndex, attribute, inData);
+        }
     }
 
     template<class DataType>
-    void EntityStorage::setData(const uint32_t id, const std::string& attribute, const DataType& inData)
+    void EntityStorage::copyData(const std::vector<EntityHandle>& handles, AttributeId<DataType> attribute, const DataType* inData)
     {
-        FEA_ASSERT(mAttributes.find(attribute) != mAttributes.end(), "Trying to set the attribute '" + attribute + "' on an entity but such an attribute has not been registered!");
-        FEA_ASSERT(std::type_index(typeid(DataType)) == mAttributes.at(attribute), "Trying to set attibute '" + attribute + "' as a '" + std::type_index(typeid(DataType)).name() + std::string(" but it is of type '") + std::string(mAttributes.at(attribute).name()) + "'");
-        mEntities.at(id).setData(attribute, inData);
+        FEA_ASSERT(attributeIdIsValid(attribute), "Trying to copy an attribute as a '" + std::string(std::type_index(typeid(DataType)).name()) + "' through an attribute ID which is invalid or of another type!");
+        uint32_t archetype;
+        uint32_t firstRow;
+
+        if(findContiguousRows(handles, archetype, firstRow) && mArchetypes[archetype].hasAttribute(attribute.mIndex))
+        {
+            mArchetypes[archetype].getColumn<DataType>(attribute.mIndex).copy(firstRow, static_cast<uint32_t>(handles.size()), inData);
+            mArchetypes[archetype].markChanged(attribute.mIndex, firstRow, static_cast<uint32_t>(handles.size()), mChangeVersion);
+        }
+        else
+        {
+            for(uint32_t i = 0; i < handles.size(); i++)
+                setData(handles[i].mIndex, attribute, inData[i]);
+        }
     }
 
     template<class DataType>
     const DataType& EntityStorage::getData(const uint32_t id, const std::string& attribute) const
     {
-        FEA_ASSERT(mAttributes.find(attribute) != mAttributes.end(), "Trying to get the attribute '" + attribute + "' on an entity but such an attribute has not been registered!");
-        FEA_ASSERT(std::type_index(typeid(DataType)) == mAttributes.at(attribute), "Trying to get attibute '" + attribute + "' as a '" + std::type_index(typeid(DataType)).name() + std::string(" but it is of type '") + std::string(mAttributes.at(attribute).name()) + "'");
-        return mEntities.at(id).getData<DataType>(attribute);
+        FEA_ASSERT(mAttributeIndices.find(attribute) != mAttributeIndices.end(), "Trying to get the attribute '" + attribute + "' on an entity but such an attribute has not been registered!");
+        FEA_ASSERT(std::type_index(typeid(DataType)) == mAttributes[getAttributeIndex(attribute)].mType, "Trying to get attibute '" + attribute + "' as a '" + std::type_index(typeid(DataType)).name() + std::string(" but it is of type '") + std::string(mAttributes[getAttributeIndex(attribute)].mType.name()) + "'");
+        return getData(id, AttributeId<DataType>(getAttributeIndex(attribute)));
+    }
+
+    template<class DataType>
+    const DataType& EntityStorage::getData(const uint32_t id, AttributeId<DataType> attribute) const
+    {
+        FEA_ASSERT(attributeIdIsValid(attribute), "Trying to get an attribute as a '" + std::string(std::type_index(typeid(DataType)).name()) + "' through an attribute ID which is invalid or of another type!");
+        FEA_ASSERT(hasEntity(id), "Trying to get the attribute '" + mAttributes[attribute.mIndex].mName + "' on entity ID '" + std::to_string(id) + "' which does not exist!");
+        const EntityLocation& location = mLocations[id];
+        const Archetype& archetype = mArchetypes[location.mArchetype];
+
+        FEA_ASSERT(archetype.hasAttribute(attribute.mIndex), "Trying to get the attribute '" + mAttributes[attribute.mIndex].mName + "' on an entity which does not have said attribute!");
+        const AttributeColumn<DataType>& column = archetype.getColumn<DataType>(attribute.mIndex);
+
+        FEA_ASSERT(column.isInitialized(location.mRow), "Calling getData on attribute '" + mAttributes[attribute.mIndex].mName + "' which is not initialized!");
+        return column.get(location.mRow);
     }
 
     template<class DataType>
     DataType& EntityStorage::getData(const uint32_t id, const std::string& attribute)
     {
-        FEA_ASSERT(mAttributes.find(attribute) != mAttributes.end(), "Trying to get the attribute '" + attribute + "' on an entity but such an attribute has not been registered!");
-        FEA_ASSERT(std::type_index(typeid(DataType)) == mAttributes.at(attribute), "Trying to get attibute '" + attribute + "' as a '" + std::type_index(typeid(DataType)).name() + std::string(" but it is of type '") + std::string(mAttributes.at(attribute).name()) + "'");
-        return mEntities.at(id).getData<DataType>(attribute);
+        FEA_ASSERT(mAttributeIndices.find(attribute) != mAttributeIndices.end(), "Trying to get the attribute '" + attribute + "' on an entity but such an attribute has not been registered!");
+        FEA_ASSERT(std::type_index(typeid(DataType)) == mAttributes[getAttributeIndex(attribute)].mType, "Trying to get attibute '" + attribute + "' as a '" + std::type_index(typeid(DataType)).name() + std::string(" but it is of type '") + std::string(mAttributes[getAttributeIndex(attribute)].mType.name()) + "'");
+        return getData(id, AttributeId<DataType>(getAttributeIndex(attribute)));
+    }
+
+    template<class DataType>
+    DataType& EntityStorage::getData(const uint32_t id, AttributeId<DataType> attribute)
+    {
+        FEA_ASSERT(attributeIdIsValid(attribute), "Trying to get an attribute as a '" + std::string(std::type_index(typeid(DataType)).name()) + "' through an attribute ID which is invalid or of another type!");
+        FEA_ASSERT(hasEntity(id), "Trying to get the attribute '" + mAttributes[attribute.mIndex].mName + "' on entity ID '" + std::to_string(id) + "' which does not exist!");
+        const EntityLocation& location = mLocations[id];
+        Archetype& archetype = mArchetypes[location.mArchetype];
+
+        FEA_ASSERT(archetype.hasAttribute(attribute.mIndex), "Trying to get the attribute '" + mAttributes[attribute.mIndex].mName + "' on an entity which does not have said attribute!");
+        AttributeColumn<DataType>& column = archetype.getColumn<DataType>(attribute.mIndex);
+
+        FEA_ASSERT(column.isInitialized(location.mRow), "Calling getData on attribute '" + mAttributes[attribute.mIndex].mName + "' which is not initialized!");
+        //the value can be modified through the returned reference
+        archetype.markChanged(attribute.mIndex, location.mRow, 1, mChangeVersion);
+        return column.get(location.mRow);
+    }
+
+    template<class DataType>
+    bool EntityStorage::hasData(const uint32_t id, AttributeId<DataType> attribute) const
+    {
+        FEA_ASSERT(hasEntity(id), "Trying to check an attribute on entity ID '" + std::to_string(id) + "' which does not exist!");
+        return mArchetypes[mLocations[id].mArchetype].hasAttribute(attribute.mIndex);
+    }
+
+    template<class DataType>
+    bool EntityStorage::isInitialized(const uint32_t id, AttributeId<DataType> attribute) const
+    {
+        FEA_ASSERT(attributeIdIsValid(attribute), "Trying to check an attribute as a '" + std::string(std::type_index(typeid(DataType)).name()) + "' through an attribute ID which is invalid or of another type!");
+        FEA_ASSERT(hasEntity(id), "Trying to check an attribute on entity ID '" + std::to_string(id) + "' which does not exist!");
+        const EntityLocation& location = mLocations[id];
+        const Archetype& archetype = mArchetypes[location.mArchetype];
+
+        return archetype.hasAttribute(attribute.mIndex) && archetype.getColumn<DataType>(attribute.mIndex).isInitialized(location.mRow);
+    }
+
+    template<class DataType, class Function>
+    void EntityStorage::forEach(const std::string& attribute, Function function)
+    {
+        FEA_ASSERT(mAttributeIndices.find(attribute) != mAttributeIndices.end(), "Trying to iterate the attribute '" + attribute + "' but such an attribute has not been registered!");
+        FEA_ASSERT(std::type_index(typeid(DataType)) == mAttributes[getAttributeIndex(attribute)].mType, "Trying to iterate attibute '" + attribute + "' as a '" + std::type_index(typeid(DataType)).name() + std::string(" but it is of type '") + std::string(mAttributes[getAttributeIndex(attribute)].mType.name()) + "'");
+        forEach(AttributeId<DataType>(getAttributeIndex(attribute)), function);
+    }
+
+    template<class DataType, class Function>
+    void EntityStorage::forEach(AttributeId<DataType> attribute, Function function)
+    {
+        FEA_ASSERT(attributeIdIsValid(attribute), "Trying to iterate an attribute as a '" + std::string(std::type_index(typeid(DataType)).name()) + "' through an attribute ID which is invalid or of another type!");
+
+        for(auto& archetype : mArchetypes)
+        {
+            if(!archetype.hasAttribute(attribute.mIndex))
+                continue;
+
+            AttributeColumn<DataType>& column = archetype.getColumn<DataType>(attribute.mIndex);
+            const std::vector<uint32_t>& entities = archetype.getEntities();
+            DataType* values = column.data();
+
+            for(uint32_t row = 0; row < archetype.size(); row++)
+            {
+                if(column.isInitialized(row))
+                    function(entities[row], values[row]);
+            }
+        }
+    }
+
+    template<class DataType, class Function>
+    void EntityStorage::forEachChanged(AttributeId<DataType> attribute, uint32_t since, Function function) const
+    {
+        FEA_ASSERT(attributeIdIsValid(attribute), "Trying to iterate changes of an attribute as a '" + std::string(std::type_index(typeid(DataType)).name()) + "' through an attribute ID which is invalid or of another type!");
+
+        for(const auto& archetype : mArchetypes)
+        {
+            //archetypes with no changes to the attribute are skipped without touching their rows
+            if(!archetype.hasAttribute(attribute.mIndex) || archetype.getLatestChange(attribute.mIndex) <= since)
+                continue;
+
+            const AttributeColumn<DataType>& column = archetype.getColumn<DataType>(attribute.mIndex);
+            const std::vector<uint32_t>& entities = archetype.getEntities();
+            const DataType* values = column.data();
+
+            for(uint32_t row = 0; row < archetype.size(); row++)
+            {
+                if(archetype.getChangeVersion(attribute.mIndex, row) > since && column.isInitialized(row))
+                    function(entities[row], values[row]);
+            }
+        }
+    }
+
+    template<class DataType>
+    void EntityStorage::markChanged(const uint32_t id, AttributeId<DataType> attribute)
+    {
+        FEA_ASSERT(attributeIdIsValid(attribute), "Trying to mark an attribute as changed through an attribute ID which is invalid or of another type!");
+        FEA_ASSERT(hasEntity(id), "Trying to mark the attribute '" + mAttributes[attribute.mIndex].mName + "' as changed on entity ID '" + std::to_string(id) + "' which does not exist!");
+        const EntityLocation& location = mLocations[id];
+        Archetype& archetype = mArchetypes[location.mArchetype];
+
+        FEA_ASSERT(archetype.hasAttribute(attribute.mIndex), "Trying to mark the attribute '" + mAttributes[attribute.mIndex].mName + "' as changed on an entity which does not have said attribute!");
+        archetype.markChanged(attribute.mIndex, location.mRow, 1, mChangeVersion);
+    }
+
+    template<class DataType, class Compare>
+    void EntityStorage::sortBy(AttributeId<DataType> attribute, Compare compare)
+    {
+        FEA_ASSERT(attributeIdIsValid(attribute), "Trying to sort by an attribute as a '" + std::string(std::type_index(typeid(DataType)).name()) + "' through an attribute ID which is invalid or of another type!");
+
+        for(auto& archetype : mArchetypes)
+        {
+            if(!archetype.hasAttribute(attribute.mIndex) || archetype.size() < 2)
+                continue;
+
+            const AttributeColumn<DataType>& column = archetype.getColumn<DataType>(attribute.mIndex);
+
+            //rows without a value are ordered before all rows with one
+            auto rowLess = [&] (uint32_t a, uint32_t b)
+            {
+                return column.isInitialized(b) && (!column.isInitialized(a) || compare(column.get(a), column.get(b)));
+            };
+
+            uint32_t outOfOrder = 0;
+
+            for(uint32_t row = 1; row < archetype.size(); row++)
+            {
+                if(rowLess(row, row - 1))
+                    outOfOrder++;
+            }
+
+            if(outOfOrder == 0)
+                continue;
+
+            //when only a few keys changed since the last sort, moving those rows into place is cheaper than reordering every row
+            if(outOfOrder <= archetype.size() / 16)
+            {
+                for(uint32_t row = 1; row < archetype.size(); row++)
+                {
+                    for(uint32_t current = row; current > 0 && rowLess(current, current - 1); current--)
+                        archetype.swapRows(current, current - 1);
+                }
+            }
+            else
+            {
+                std::vector<uint32_t> order(archetype.size());
+                std::iota(order.begin(), order.end(), 0);
+                std::stable_sort(order.begin(), order.end(), rowLess);
+                archetype.permuteRows(order);
+            }
+
+            const std::vector<uint32_t>& entities = archetype.getEntities();
+
+            for(uint32_t row = 0; row < archetype.size(); row++)
+                mLocations[entities[row]].mRow = row;
+        }
+    }
+
+    template<class DataType, class Function, class Compare>
+    void EntityStorage::forEachSorted(AttributeId<DataType> attribute, Function function, Compare compare)
+    {
+        FEA_ASSERT(attributeIdIsValid(attribute), "Trying to iterate an attribute as a '" + std::string(std::type_index(typeid(DataType)).name()) + "' through an attribute ID which is invalid or of another type!");
+
+        struct Cursor
+        {
+            uint32_t mArchetype;
+            uint32_t mRow;
+            AttributeColumn<DataType>* mColumn;
+        };
+
+        std::vector<Cursor> cursors;
+
+        for(uint32_t i = 0; i < mArchetypes.size(); i++)
+        {
+            if(!mArchetypes[i].hasAttribute(attribute.mIndex))
+                continue;
+
+            //rows without a value are sorted first and are skipped
+            AttributeColumn<DataType>& column = mArchetypes[i].getColumn<DataType>(attribute.mIndex);
+            uint32_t row = 0;
+
+            while(row < mArchetypes[i].size() && !column.isInitialized(row))
+                row++;
+
+            if(row < mArchetypes[i].size())
+                cursors.push_back(Cursor{i, row, &column});
+        }
+
+        //the sorted archetypes are merged using a heap holding the next row of each, with ties going to the earliest archetype
+        auto later = [&] (const Cursor& a, const Cursor& b)
+        {
+            const DataType& first = a.mColumn->get(a.mRow);
+            const DataType& second = b.mColumn->get(b.mRow);
+            return compare(second, first) || (!compare(first, second) && a.mArchetype > b.mArchetype);
+        };
+
+        std::make_heap(cursors.begin(), cursors.end(), later);
+
+        while(!cursors.empty())
+        {
+            std::pop_heap(cursors.begin(), cursors.end(), later);
+            Cursor& cursor = cursors.back();
+            Archetype& archetype = mArchetypes[cursor.mArchetype];
+            function(archetype.getEntities()[cursor.mRow], cursor.mColumn->get(cursor.mRow));
+
+            if(++cursor.mRow < archetype.size())
+                std::push_heap(cursors.begin(), cursors.end(), later);
+            else
+                cursors.pop_back();
+        }
+    }
+
+    template<class DataType>
+    void EntityStorage::registerSerializer(AttributeSerializer<DataType> serializer)
+    {
+        FEA_ASSERT(serializer.mSerialize && serializer.mDeserialize, std::string("Trying to register a serializer for '") + std::type_index(typeid(DataType)).name() + "' which is missing a function!");
+        mSerializers[typeid(DataType)] = std::make_shared<AttributeSerializer<DataType>>(std::move(serializer));
+    }
+
+    template<class DataType>
+    bool EntityStorage::attributeIdIsValid(AttributeId<DataType> attribute) const
+    {
+        return attribute.mIndex < mAttributes.size() && std::type_index(typeid(DataType)) == mAttributes[attribute.mIndex].mType;
     }
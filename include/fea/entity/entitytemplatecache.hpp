@@ -0,0 +1,107 @@
+#pragma once
+#include <fea/config.hpp>
+#include <fea/entity/entityfactory.hpp>
+#include <fea/entity/entitytemplate.hpp>
+#include <fea/entity/binarystream.hpp>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace fea
+{
+    class FEA_API EntityTemplateCache
+    {
+        public:
+            EntityTemplateCache();
+            EntityTemplateCache(const EntityTemplateCache& other) = delete;
+            EntityTemplateCache& operator=(const EntityTemplateCache& other) = delete;
+            bool open(const std::string& path, uint64_t sourceHash);
+            bool isOpen() const;
+            void close();
+            bool loadEntityAttributes(std::unordered_map<std::string, std::string>& attributes) const;
+            bool addTemplates(EntityFactory& factory) const;
+            static bool writeEntityAttributes(const std::string& path, uint64_t sourceHash, const std::unordered_map<std::string, std::string>& attributes);
+            static bool writeTemplates(const std::string& path, uint64_t sourceHash, const std::vector<std::pair<std::string, EntityTemplate>>& templates, const EntityFactory& factory);
+            static uint64_t hash(const char* data, size_t size);
+            ~EntityTemplateCache();
+        private:
+            const uint8_t* mData;
+            size_t mSize;
+            bool mMapped;
+            std::vector<uint8_t> mBuffer;
+    };
+    /** @addtogroup EntitySystem
+     *@{
+     *  @class EntityTemplateCache
+     *@}
+     ***
+     *  @class EntityTemplateCache
+     *  @brief Binary file holding pre-parsed entity templates or attribute definitions.
+     *
+     *  Parsing template files and the default values in them can take a long time when there are many templates. A cache file stores the templates already flattened, meaning that inheritance has been resolved, and stores every default value of a trivially copyable data type as raw bytes so that no parser has to run for it when the templates are loaded. Values of other data types are stored as their original strings and parsed on load.
+     *
+     *  Every cache file stores a hash of the file it was generated from. When opening a cache, the hash of the current source file must be given, and a cache generated from different content is rejected. Cache files are mapped into memory where the platform supports it.
+     *
+     *  Normally this class does not need to be used directly since JsonEntityLoader takes care of creating and using cache files.
+     *
+     *  Raw values are stored together with the data type they were written for, see EntityFactory::getRawValueType, and a cache is rejected if the data type of any attribute has changed since.
+     ***
+     *  @fn EntityTemplateCache::EntityTemplateCache()
+     *  @brief Construct a closed cache.
+     ***
+     *  @fn bool EntityTemplateCache::open(const std::string& path, uint64_t sourceHash)
+     *  @brief Open a cache file.
+     *  @param path Path of the cache file.
+     *  @param sourceHash Hash of the source file the cache is expected to be generated from, see EntityTemplateCache::hash.
+     *  @return True if the file exists, is a valid cache file and was generated from a file with the given hash.
+     ***
+     *  @fn bool EntityTemplateCache::isOpen() const
+     *  @brief Check if a cache file has been opened.
+     *  @return True if open.
+     ***
+     *  @fn void EntityTemplateCache::close()
+     *  @brief Close the cache file.
+     ***
+     *  @fn bool EntityTemplateCache::loadEntityAttributes(std::unordered_map<std::string, std::string>& attributes) const
+     *  @brief Load the attribute definitions stored in the cache.
+     *
+     *  The content of the map can be given to the EntityFactory::registerAttribute function.
+     *  @param attributes Map to store the attribute names and data type names in.
+     *  @return False if the cache is not open or its content is corrupt.
+     ***
+     *  @fn bool EntityTemplateCache::addTemplates(EntityFactory& factory) const
+     *  @brief Add all templates stored in the cache to an EntityFactory.
+     *
+     *  The templates are only added if the whole cache is valid for the factory, meaning that every attribute exists and every raw value was written for the data type its attribute is registered as. Otherwise the factory is left untouched.
+     *
+     *  Assert/undefined behavior if any of the templates already exist in the factory.
+     *  @param factory Factory to add the templates to.
+     *  @return False if the templates could not be added.
+     ***
+     *  @fn bool EntityTemplateCache::writeEntityAttributes(const std::string& path, uint64_t sourceHash, const std::unordered_map<std::string, std::string>& attributes)
+     *  @brief Write attribute definitions to a cache file.
+     *  @param path Path of the cache file.
+     *  @param sourceHash Hash of the file the attribute definitions were loaded from.
+     *  @param attributes Map of attribute names and data type names.
+     *  @return False if the file could not be written.
+     ***
+     *  @fn bool EntityTemplateCache::writeTemplates(const std::string& path, uint64_t sourceHash, const std::vector<std::pair<std::string, EntityTemplate>>& templates, const EntityFactory& factory)
+     *  @brief Write templates to a cache file.
+     *
+     *  The factory is used to turn default values into raw bytes. Templates can only inherit templates which come before them in the list.
+     *  @param path Path of the cache file.
+     *  @param sourceHash Hash of the file the templates were loaded from.
+     *  @param templates Templates to write.
+     *  @param factory Factory with all attributes of the templates registered.
+     *  @return False if the file could not be written, or a template inherits a template not in the list.
+     ***
+     *  @fn uint64_t EntityTemplateCache::hash(const char* data, size_t size)
+     *  @brief Hash the content of a source file.
+     *  @param data Content to hash.
+     *  @param size Size of the content.
+     *  @return 64 bit FNV-1a hash of the content.
+     ***
+     *  @fn EntityTemplateCache::~EntityTemplateCache()
+     *  @brief Destructor.
+     ***/
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include <fea/config.hpp>
+#include <fea/entity/entitystorage.hpp>
+#include <fea/entity/attributeid.hpp>
+#include <algorithm>
+#include <initializer_list>
+#include <tuple>
+#include <stddef.h>
+
+namespace fea
+{
+    template<size_t... Indices>
+    struct IndexSequence
+    {
+    };
+
+    template<size_t Count, size_t... Indices>
+    struct MakeIndexSequence : MakeIndexSequence<Count - 1, Count - 1, Indices...>
+    {
+    };
+
+    template<size_t... Indices>
+    struct MakeIndexSequence<0, Indices...>
+    {
+        using Type = IndexSequence<Indices...>;
+    };
+
+    template<class... DataTypes>
+    class EntityView
+    {
+        public:
+            EntityView(EntityStorage& storage, AttributeId<DataTypes>... attributes);
+            template<class Function>
+            void forEach(Function function) const;
+            template<class Function>
+            void forEach(Function function, size_t begin, size_t end) const;
+            size_t size() const;
+        private:
+            template<class Function, size_t... Indices>
+            void forEachInArchetype(Archetype& archetype, Function& function, uint32_t begin, uint32_t end, IndexSequence<Indices...>) const;
+            static bool allOf(std::initializer_list<bool> values);
+
+            EntityStorage& mStorage;
+            uint32_t mQuery;
+            std::tuple<AttributeId<DataTypes>...> mAttributes;
+    };
+#include <fea/entity/entityview.inl>
+    /** @addtogroup EntitySystem
+     *@{
+     *  @class EntityView
+     *@}
+     ***
+     *  @class EntityView
+     *  @brief Gives direct access to the attributes of all entities which have a given set of attributes.
+     *
+     *  An EntityView is created using EntityManager::view and is a cheap object to create, copy and keep around. The set of archetypes that match the view is cached by the EntityManager and kept up to date as entities gain or lose attributes, so iterating a view never has to check entities which do not match and does not allocate anything. The attribute values are visited in the order they are stored in memory.
+     *
+     *  Example of moving every entity which has both a position and a velocity:
+     *  @code
+     *  fea::EntityView<glm::vec2, glm::vec2> movables = entityManager.view(positionId, velocityId);
+     *
+     *  movables.forEach([] (fea::EntityId id, glm::vec2& position, glm::vec2& velocity)
+     *  {
+     *      position += velocity;
+     *  });
+     *  @endcode
+     *
+     *  The view is invalidated if the EntityManager it came from is cleared.
+     *  @tparam DataTypes Types of the attributes the view accesses.
+     ***
+     *  @fn EntityView::EntityView(EntityStorage& storage, AttributeId<DataTypes>... attributes)
+     *  @brief Construct an EntityView.
+     *
+     *  Views are not meant to be constructed manually, but by using EntityManager::view.
+     *  @param storage Storage to view.
+     *  @param attributes IDs of the attributes to view.
+     ***
+     *  @fn void EntityView::forEach(Function function) const
+     *  @brief Call a function for every entity matching the view.
+     *
+     *  The function is called as function(EntityId id, DataTypes&... values) with references to the stored values, in the same order as the attributes given when creating the view. Entities for which any of the viewed attributes has not been set are skipped.
+     *
+     *  Entities must not be created or removed and attributes must not be added or removed from within the function.
+     *  @tparam Function Function to call. Can often be inferred automatically.
+     *  @param function Function to call for every entity.
+     ***
+     *  @fn void EntityView::forEach(Function function, size_t begin, size_t end) const
+     *  @brief Call a function for a range of the entities matching the view.
+     *
+     *  Works like EntityView::forEach(Function function) const but only visits the entities from position begin up to but not including position end, in the order they would be visited when iterating the whole view. Ranges which do not overlap can be iterated from different threads at the same time, which is what SystemScheduler::parallelForEach uses to split large views into chunks.
+     *  @tparam Function Function to call. Can often be inferred automatically.
+     *  @param function Function to call for every entity in the range.
+     *  @param begin Position of the first entity to visit.
+     *  @param end Position after the last entity to visit.
+     ***
+     *  @fn size_t EntityView::size() const
+     *  @brief Get the amount of entities that currently have all the viewed attributes.
+     *  @return Amount of entities.
+     ***/
+}
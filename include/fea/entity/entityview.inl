@@ -0,0 +1,92 @@
+    template<class... DataTypes>
+    EntityView<DataTypes...>::EntityView(EntityStorage& storage, AttributeId<DataTypes>... attributes) :
+        mStorage(storage),
+        mQuery(storage.findOrCreateQuery({attributes.mIndex...})),
+        mAttributes(attributes...)
+    {
+    }
+
+    template<class... DataTypes>
+    template<class Function>
+    void EntityView<DataTypes...>::forEach(Function function) const
+    {
+        for(uint32_t archetype : mStorage.getQueryArchetypes(mQuery))
+        {
+            Archetype& current = mStorage.getArchetype(archetype);
+            forEachInArchetype(current, function, 0, current.size(), typename MakeIndexSequence<sizeof...(DataTypes)>::Type());
+        }
+    }
+
+    template<class... DataTypes>
+    template<class Function>
+    void EntityView<DataTypes...>::forEach(Function function, size_t begin, size_t end) const
+    {
+        size_t archetypeStart = 0;
+
+        for(uint32_t archetype : mStorage.getQueryArchetypes(mQuery))
+        {
+            if(archetypeStart >= end)
+                return;
+
+            Archetype& current = mStorage.getArchetype(archetype);
+            size_t archetypeEnd = archetypeStart + current.size();
+
+            if(archetypeEnd > begin)
+            {
+                uint32_t firstRow = static_cast<uint32_t>(begin > archetypeStart ? begin - archetypeStart : 0);
+                uint32_t lastRow = static_cast<uint32_t>(std::min(end, archetypeEnd) - archetypeStart);
+                forEachInArchetype(current, function, firstRow, lastRow, typename MakeIndexSequence<sizeof...(DataTypes)>::Type());
+            }
+
+            archetypeStart = archetypeEnd;
+        }
+    }
+
+    template<class... DataTypes>
+    size_t EntityView<DataTypes...>::size() const
+    {
+        size_t amount = 0;
+
+        for(uint32_t archetype : mStorage.getQueryArchetypes(mQuery))
+            amount += mStorage.getArchetype(archetype).size();
+
+        return amount;
+    }
+
+    template<class... DataTypes>
+    template<class Function, size_t... Indices>
+    void EntityView<DataTypes...>::forEachInArchetype(Archetype& archetype, Function& function, uint32_t begin, uint32_t end, IndexSequence<Indices...>) const
+    {
+        if(begin >= end)
+            return;
+
+        const uint32_t* entities = archetype.getEntities().data();
+        std::tuple<AttributeColumn<DataTypes>*...> columns(&archetype.getColumn<DataTypes>(std::get<Indices>(mAttributes).mIndex)...);
+        std::tuple<DataTypes*...> values(std::get<Indices>(columns)->data()...);
+
+        if(allOf({std::get<Indices>(columns)->isFullyInitialized()...}))
+        {
+            for(uint32_t row = begin; row < end; row++)
+                function(entities[row], std::get<Indices>(values)[row]...);
+        }
+        else
+        {
+            for(uint32_t row = begin; row < end; row++)
+            {
+                if(allOf({std::get<Indices>(columns)->isInitialized(row)...}))
+                    function(entities[row], std::get<Indices>(values)[row]...);
+            }
+        }
+    }
+
+    template<class... DataTypes>
+    bool EntityView<DataTypes...>::allOf(std::initializer_list<bool> values)
+    {
+        for(bool value : values)
+        {
+            if(!value)
+                return false;
+        }
+
+        return true;
+    }
@@ -0,0 +1,79 @@
+#pragma once
+#include <fea/config.hpp>
+#include <fea/entity/entitymanager.hpp>
+#include <fea/entity/attributeid.hpp>
+#include <fea/entity/entityhandle.hpp>
+#include <memory>
+#include <vector>
+#include <stdint.h>
+
+namespace fea
+{
+    class FEA_API InstanceOverrides
+    {
+        class OverrideBase
+        {
+            public:
+                virtual void apply(EntityManager& entityManager, const std::vector<EntityHandle>& entities) const = 0;
+                virtual uint32_t size() const = 0;
+                virtual ~OverrideBase() {}
+        };
+
+        template<class DataType>
+        class Override : public OverrideBase
+        {
+            public:
+                Override(AttributeId<DataType> attribute, std::vector<DataType> values);
+                void apply(EntityManager& entityManager, const std::vector<EntityHandle>& entities) const override;
+                uint32_t size() const override;
+            private:
+                AttributeId<DataType> mAttribute;
+                std::vector<DataType> mValues;
+        };
+
+        public:
+            template<class DataType>
+            void set(AttributeId<DataType> attribute, std::vector<DataType> values);
+            void apply(EntityManager& entityManager, const std::vector<EntityHandle>& entities) const;
+            void clear();
+        private:
+            std::vector<std::shared_ptr<OverrideBase>> mOverrides;
+    };
+#include <fea/entity/instanceoverrides.inl>
+
+    /** @addtogroup EntitySystem
+     *@{
+     *  @class InstanceOverrides
+     *@}
+     ***
+     *  @class InstanceOverrides
+     *  @brief Holds attribute values which differ for every instance created by a batch instantiation.
+     *
+     *  Used with EntityFactory::instantiate(const std::string& name, uint32_t amount, const InstanceOverrides& overrides) to give every instance its own value for some attributes, for instance a position, while the rest of the attributes are taken from the template. Every override holds exactly one value per instance, and the values are copied into storage in bulk after the template values have been applied.
+     *
+     *  Example:
+     *  @code
+     *  fea::InstanceOverrides overrides;
+     *  overrides.set(positionId, spawnPositions);   //std::vector<glm::vec2> with 500 positions
+     *  std::vector<fea::EntityHandle> bullets = factory.instantiate("bullet", 500, overrides);
+     *  @endcode
+     ***
+     *  @fn void InstanceOverrides::set(AttributeId<DataType> attribute, std::vector<DataType> values)
+     *  @brief Set the per instance values of an attribute.
+     *
+     *  If the attribute already has values, they are replaced.
+     *  @tparam DataType Type of the attribute.
+     *  @param attribute ID of the attribute.
+     *  @param values One value per instance.
+     ***
+     *  @fn void InstanceOverrides::apply(EntityManager& entityManager, const std::vector<EntityHandle>& entities) const
+     *  @brief Write the values to a set of entities.
+     *
+     *  Assert/undefined behavior if the amount of values of any attribute differs from the amount of entities.
+     *  @param entityManager EntityManager the entities belong to.
+     *  @param entities Entities to write the values to, in the same order as the values.
+     ***
+     *  @fn void InstanceOverrides::clear()
+     *  @brief Remove all overrides.
+     ***/
+}
@@ -0,0 +1,29 @@
+    template<class DataType>
+    InstanceOverrides::Override<DataType>::Override(AttributeId<DataType> attribute, std::vector<DataType> values) :
+        mAttribute(attribute),
+        mValues(std::move(values))
+    {
+    }
+
+    template<class DataType>
+    void InstanceOverrides::Override<DataType>::apply(EntityManager& entityManager, const std::vector<EntityHandle>& entities) const
+    {
+        entityManager.setAttributes(entities, mAttribute, mValues);
+    }
+
+    template<class DataType>
+    uint32_t InstanceOverrides::Override<DataType>::size() const
+    {
+        return static_cast<uint32_t>(mValues.size());
+    }
+
+    template<class DataType>
+    void InstanceOverrides::set(AttributeId<DataType> attribute, std::vector<DataType> values)
+    {
+        FEA_ASSERT(attribute.isValid(), "Trying to override an attribute using an invalid attribute ID!");
+
+        if(attribute.mIndex >= mOverrides.size())
+            mOverrides.resize(attribute.mIndex + 1);
+
+        mOverrides[attribute.mIndex] = std::make_shared<Override<DataType>>(attribute, std::move(values));
+    }
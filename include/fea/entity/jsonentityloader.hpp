@@ -4,6 +4,7 @@
 #include <string>
 #include <fea/entity/filenotfoundexception.hpp>
 #include <fea/entity/entityfactory.hpp>
+#include <fea/entity/entitytemplatecache.hpp>
 
 namespace Json
 {
@@ -17,7 +18,12 @@ namespace fea
         public:
             std::vector<std::pair<std::string, EntityTemplate>> loadEntityTemplates(const std::string& path);
             std::unordered_map<std::string, std::string> loadEntityAttributes(const std::string& path);
+            void loadEntityTemplates(const std::string& path, const std::string& cachePath, EntityFactory& factory);
+            std::unordered_map<std::string, std::string> loadEntityAttributes(const std::string& path, const std::string& cachePath);
         private:
+            std::string readFile(const std::string& path) const;
+            std::vector<std::pair<std::string, EntityTemplate>> parseEntityTemplates(const std::string& content);
+            std::unordered_map<std::string, std::string> parseEntityAttributes(const std::string& content);
             std::unordered_map<std::string, std::string> jsonObjToStringMap(const Json::Value&);
     };
     /** @addtogroup EntitySystem
@@ -78,6 +84,8 @@ namespace fea
      *  The file is divided into entity template definitions. The three entities defined in this files are "physics_entity", "enemy" and "player". Every entity template internally defines a sequence of attributes that they should have and/or which other entity templates they inherit. The attributes might come with default values. For instance, the first attribute of the entity template "player" is "health" with a default value of "100".
      *
      *  If a template inherits another template, it means that the inheriting template will obtain all attributes and default values from the inherited templates. Inheriting templates can override default values by restating the attributes like the template "player" does in the above example with the "position" attribute.
+     *
+     *  Both kinds of files can also be loaded through a binary cache file, see EntityTemplateCache. The cache is validated against the content of the json file and regenerated whenever the json file changes, so the json files stay the ones to edit.
      ***
      *  @fn std::vector<std::pair<std::string, EntityTemplate> > JsonEntityLoader::loadEntityTemplates(const std::string& path)
      *  @brief Load a json file defining entity templates.
@@ -94,5 +102,25 @@ namespace fea
      *  Throws FileNotFoundException when the file does not exist.
      *  @param path File to open.
      *  @return A map with the entity attributes.
+     ***
+     *  @fn void JsonEntityLoader::loadEntityTemplates(const std::string& path, const std::string& cachePath, EntityFactory& factory)
+     *  @brief Load a json file defining entity templates through a binary cache, and add the templates to an EntityFactory.
+     *
+     *  If the cache file exists and was generated from the current content of the json file, the templates are taken from the cache with their default values already parsed. Otherwise the json file is parsed, the templates are added to the factory, and the cache file is written for the next time. Failing to write the cache file is not an error.
+     *
+     *  All attributes used by the templates must be registered in the factory before calling this function.
+     *  Throws FileNotFoundException when the json file does not exist.
+     *  @param path Json file to open.
+     *  @param cachePath Cache file to use.
+     *  @param factory Factory to add the templates to.
+     ***
+     *  @fn std::unordered_map<std::string, std::string> JsonEntityLoader::loadEntityAttributes(const std::string& path, const std::string& cachePath)
+     *  @brief Load a json file defining entity attributes through a binary cache.
+     *
+     *  Works like JsonEntityLoader::loadEntityTemplates(const std::string& path, const std::string& cachePath, EntityFactory& factory) but returns the attributes.
+     *  Throws FileNotFoundException when the json file does not exist.
+     *  @param path Json file to open.
+     *  @param cachePath Cache file to use.
+     *  @return A map with the entity attributes.
      **/
 }
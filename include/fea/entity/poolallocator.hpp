@@ -0,0 +1,149 @@
+#pragma once
+#include <fea/config.hpp>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+#include <stdint.h>
+
+namespace fea
+{
+    class FEA_API FixedSizePool
+    {
+        struct FreeBlock
+        {
+            FreeBlock* mNext;
+        };
+
+        public:
+            FixedSizePool(size_t blockSize, uint32_t blocksPerSlab);
+            FixedSizePool(const FixedSizePool& other) = delete;
+            FixedSizePool& operator=(const FixedSizePool& other) = delete;
+            void* allocate();
+            void deallocate(void* block);
+            size_t getBlockSize() const;
+            size_t getSlabCount() const;
+            size_t getAllocatedBytes() const;
+            ~FixedSizePool();
+        private:
+            void addSlab();
+
+            size_t mBlockSize;
+            uint32_t mBlocksPerSlab;
+            FreeBlock* mFreeList;
+            std::vector<void*> mSlabs;
+    };
+
+    //shared by all rebound copies of a PoolAllocator, so it cannot depend on the allocated type
+    struct PoolAllocatorState
+    {
+        std::unique_ptr<FixedSizePool> mPool;
+        uint32_t mBlocksPerSlab;
+    };
+
+    template<class Type>
+    class PoolAllocator
+    {
+        template<class OtherType>
+        friend class PoolAllocator;
+
+        public:
+            using value_type = Type;
+
+            PoolAllocator(uint32_t blocksPerSlab = 64);
+            template<class OtherType>
+            PoolAllocator(const PoolAllocator<OtherType>& other);
+            Type* allocate(size_t amount);
+            void deallocate(Type* pointer, size_t amount);
+            template<class OtherType>
+            bool operator==(const PoolAllocator<OtherType>& other) const;
+            template<class OtherType>
+            bool operator!=(const PoolAllocator<OtherType>& other) const;
+            const FixedSizePool* getPool() const;
+        private:
+            bool usesPool(size_t amount) const;
+
+            std::shared_ptr<PoolAllocatorState> mState;
+    };
+#include <fea/entity/poolallocator.inl>
+    /** @addtogroup EntitySystem
+     *@{
+     *  @class FixedSizePool
+     *  @class PoolAllocator
+     *@}
+     ***
+     *  @class FixedSizePool
+     *  @brief Hands out memory blocks of a single size from larger slabs.
+     *
+     *  Blocks are carved out of slabs holding a fixed amount of blocks each, and freed blocks are kept in a free list to be handed out again. Slabs are only released when the pool is destroyed, so once a pool has grown to the amount of blocks in use, allocating and deallocating never reaches the system allocator.
+     ***
+     *  @fn FixedSizePool::FixedSizePool(size_t blockSize, uint32_t blocksPerSlab)
+     *  @brief Construct a pool without allocating anything.
+     *  @param blockSize Size of every block. Rounded up so that every block is suitably aligned for any fundamental type.
+     *  @param blocksPerSlab Amount of blocks allocated at once when the pool runs out.
+     ***
+     *  @fn void* FixedSizePool::allocate()
+     *  @brief Get a block, adding a slab if no free block is left.
+     *  @return Pointer to the block.
+     ***
+     *  @fn void FixedSizePool::deallocate(void* block)
+     *  @brief Give a block back to the pool.
+     *
+     *  Undefined behavior if the block was not allocated from this pool.
+     *  @param block Block to give back.
+     ***
+     *  @fn size_t FixedSizePool::getBlockSize() const
+     *  @brief Get the size of the blocks, after rounding.
+     *  @return Size in bytes.
+     ***
+     *  @fn size_t FixedSizePool::getSlabCount() const
+     *  @brief Get the amount of slabs allocated so far.
+     *  @return Amount of slabs.
+     ***
+     *  @fn size_t FixedSizePool::getAllocatedBytes() const
+     *  @brief Get the total size of all slabs.
+     *  @return Size in bytes.
+     ***
+     *  @fn FixedSizePool::~FixedSizePool()
+     *  @brief Destructor. Releases all slabs.
+     ***
+     *  @class PoolAllocator
+     *  @brief Standard library compatible allocator handing out single objects from a shared FixedSizePool.
+     *
+     *  Meant for use with std::allocate_shared, so that the object and the reference count of a shared pointer end up in one pooled block. The pool is created on the first allocation, sized after the type the allocator has been rebound to at that point, and is shared by all copies of the allocator. Every block keeps the pool alive, so pointers can safely outlive the object owning the allocator.
+     *
+     *  Allocations of more than one object, or of types larger than the pool blocks, are forwarded to the global operator new. The allocator is not thread safe.
+     *  @tparam Type Type of the objects to allocate.
+     ***
+     *  @fn PoolAllocator::PoolAllocator(uint32_t blocksPerSlab)
+     *  @brief Construct an allocator with a new pool.
+     *  @param blocksPerSlab Amount of blocks allocated at once when the pool runs out.
+     ***
+     *  @fn PoolAllocator::PoolAllocator(const PoolAllocator<OtherType>& other)
+     *  @brief Construct an allocator sharing the pool of another allocator.
+     *  @tparam OtherType Type of the other allocator.
+     *  @param other Allocator to share the pool with.
+     ***
+     *  @fn Type* PoolAllocator::allocate(size_t amount)
+     *  @brief Allocate uninitialized memory for objects.
+     *  @param amount Amount of objects.
+     *  @return Pointer to the memory.
+     ***
+     *  @fn void PoolAllocator::deallocate(Type* pointer, size_t amount)
+     *  @brief Release memory allocated with PoolAllocator::allocate.
+     *  @param pointer Memory to release.
+     *  @param amount Amount of objects, as given to PoolAllocator::allocate.
+     ***
+     *  @fn bool PoolAllocator::operator==(const PoolAllocator<OtherType>& other) const
+     *  @brief Check if two allocators share the same pool.
+     *  @return True if memory from one can be released through the other.
+     ***
+     *  @fn bool PoolAllocator::operator!=(const PoolAllocator<OtherType>& other) const
+     *  @brief Check if two allocators use different pools.
+     *  @return True if different.
+     ***
+     *  @fn const FixedSizePool* PoolAllocator::getPool() const
+     *  @brief Get the pool shared by this allocator and its copies.
+     *  @return The pool, or nullptr if nothing has been allocated yet.
+     ***/
+}
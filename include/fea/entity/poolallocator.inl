@@ -0,0 +1,61 @@
+    template<class Type>
+    PoolAllocator<Type>::PoolAllocator(uint32_t blocksPerSlab) :
+        mState(std::make_shared<PoolAllocatorState>())
+    {
+        mState->mBlocksPerSlab = blocksPerSlab;
+    }
+
+    template<class Type>
+    template<class OtherType>
+    PoolAllocator<Type>::PoolAllocator(const PoolAllocator<OtherType>& other) :
+        mState(other.mState)
+    {
+    }
+
+    template<class Type>
+    Type* PoolAllocator<Type>::allocate(size_t amount)
+    {
+        //the first single object allocation decides the block size, which for std::allocate_shared is the combined object and control block
+        if(amount == 1 && !mState->mPool && alignof(Type) <= alignof(std::max_align_t))
+            mState->mPool.reset(new FixedSizePool(sizeof(Type), mState->mBlocksPerSlab));
+
+        if(usesPool(amount))
+            return static_cast<Type*>(mState->mPool->allocate());
+
+        return static_cast<Type*>(::operator new(sizeof(Type) * amount));
+    }
+
+    template<class Type>
+    void PoolAllocator<Type>::deallocate(Type* pointer, size_t amount)
+    {
+        if(usesPool(amount))
+            mState->mPool->deallocate(pointer);
+        else
+            ::operator delete(pointer);
+    }
+
+    template<class Type>
+    template<class OtherType>
+    bool PoolAllocator<Type>::operator==(const PoolAllocator<OtherType>& other) const
+    {
+        return mState == other.mState;
+    }
+
+    template<class Type>
+    template<class OtherType>
+    bool PoolAllocator<Type>::operator!=(const PoolAllocator<OtherType>& other) const
+    {
+        return mState != other.mState;
+    }
+
+    template<class Type>
+    const FixedSizePool* PoolAllocator<Type>::getPool() const
+    {
+        return mState->mPool.get();
+    }
+
+    template<class Type>
+    bool PoolAllocator<Type>::usesPool(size_t amount) const
+    {
+        return amount == 1 && mState->mPool && sizeof(Type) <= mState->mPool->getBlockSize() && alignof(Type) <= alignof(std::max_align_t);
+    }
@@ -0,0 +1,148 @@
+#pragma once
+#include <fea/config.hpp>
+#include <fea/entity/entitymanager.hpp>
+#include <fea/entity/attributeid.hpp>
+#include <fea/entity/entityhandle.hpp>
+#include <fea/assert.hpp>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <stdint.h>
+
+namespace fea
+{
+    template<class DataType>
+    class PublishedAttribute
+    {
+        struct Frame
+        {
+            Frame();
+            std::vector<EntityHandle> mHandles;
+            std::vector<DataType> mValues;
+            std::vector<uint32_t> mIndices;
+            std::atomic<uint32_t> mReaders;
+        };
+
+        public:
+            class View
+            {
+                public:
+                    View();
+                    View(const View& other) = delete;
+                    View(View&& other);
+                    View& operator=(const View& other) = delete;
+                    View& operator=(View&& other);
+                    bool isValid() const;
+                    bool has(EntityHandle handle) const;
+                    const DataType& get(EntityHandle handle) const;
+                    template<class Function>
+                    void forEach(Function function) const;
+                    size_t size() const;
+                    ~View();
+                private:
+                    explicit View(Frame* frame);
+                    void release();
+                    Frame* mFrame;
+
+                    friend class PublishedAttribute;
+            };
+
+            PublishedAttribute(EntityManager& entityManager, AttributeId<DataType> attribute);
+            PublishedAttribute(const PublishedAttribute& other) = delete;
+            PublishedAttribute& operator=(const PublishedAttribute& other) = delete;
+            void publish();
+            View acquire() const;
+            ~PublishedAttribute();
+        private:
+            Frame* findFreeFrame();
+
+            EntityManager& mEntityManager;
+            AttributeId<DataType> mAttribute;
+            std::vector<std::unique_ptr<Frame>> mFrames;
+            std::atomic<Frame*> mCurrent;
+    };
+#include <fea/entity/publishedattribute.inl>
+
+    /** @addtogroup EntitySystem
+     *@{
+     *  @class PublishedAttribute
+     *  @class PublishedAttribute::View
+     *@}
+     ***
+     *  @class PublishedAttribute
+     *  @brief Read-only copy of one attribute of all entities, published by the main thread for other threads to read without locking.
+     *
+     *  The EntityManager is not safe to read from while it is being modified. Threads which need attribute values while the main thread keeps updating, such as pathfinding or AI jobs, can instead read from a PublishedAttribute. The main thread calls PublishedAttribute::publish once per frame, which copies the current values into a frame that no thread is reading. Other threads call PublishedAttribute::acquire to get a View of the latest published frame, which stays valid and unchanged for as long as the View is kept, regardless of later publishes.
+     *
+     *  Neither side ever waits for the other. Publishing writes into a frame without readers, and allocates a new one when all older frames are still held, so keeping a View for long only costs memory. In the steady state publishing does not allocate. Acquiring a View only touches atomic counters.
+     *
+     *  One instance exists per attribute. All Views must be released before the PublishedAttribute is destroyed.
+     *  @tparam DataType Type of the attribute. Must be copy constructible.
+     ***
+     *  @class PublishedAttribute::View
+     *  @brief Handle to one published frame of a PublishedAttribute.
+     *
+     *  The frame is kept alive and unchanged until the View is destroyed. Views can be moved but not copied, and must only be used by one thread at a time.
+     ***
+     *  @fn PublishedAttribute::View::View()
+     *  @brief Construct a View which does not refer to any frame.
+     ***
+     *  @fn PublishedAttribute::View::View(View&& other)
+     *  @brief Move a View.
+     *  @param other View to move.
+     ***
+     *  @fn View& PublishedAttribute::View::operator=(View&& other)
+     *  @brief Release the current frame and take over the frame of another View.
+     *  @param other View to move.
+     *  @return Reference to this View.
+     ***
+     *  @fn bool PublishedAttribute::View::isValid() const
+     *  @brief Check if the View refers to a frame.
+     *
+     *  Views acquired before anything has been published are not valid, and hold no entities.
+     *  @return True if valid.
+     ***
+     *  @fn bool PublishedAttribute::View::has(EntityHandle handle) const
+     *  @brief Check if the frame holds a value for an entity.
+     *  @param handle Handle of the entity. Handles to entities which were removed before the frame was published are not found.
+     *  @return True if the entity had the attribute with a value when the frame was published.
+     ***
+     *  @fn const DataType& PublishedAttribute::View::get(EntityHandle handle) const
+     *  @brief Get the published value of an entity.
+     *
+     *  Assert/undefined behavior if the frame does not hold a value for the entity, see PublishedAttribute::View::has.
+     *  @param handle Handle of the entity.
+     *  @return The value.
+     ***
+     *  @fn void PublishedAttribute::View::forEach(Function function) const
+     *  @brief Iterate all values of the frame, in storage order.
+     *  @tparam Function Callable taking the ID of the entity and a const reference to the value.
+     *  @param function Function to call for each value.
+     ***
+     *  @fn size_t PublishedAttribute::View::size() const
+     *  @brief Get the amount of values in the frame.
+     *  @return Amount of values.
+     ***
+     *  @fn PublishedAttribute::View::~View()
+     *  @brief Destructor. Releases the frame.
+     ***
+     *  @fn PublishedAttribute::PublishedAttribute(EntityManager& entityManager, AttributeId<DataType> attribute)
+     *  @brief Construct a PublishedAttribute. Nothing is published until PublishedAttribute::publish is called.
+     *  @param entityManager EntityManager to read the values from.
+     *  @param attribute ID of the attribute to publish.
+     ***
+     *  @fn void PublishedAttribute::publish()
+     *  @brief Copy the current values of the attribute and make them the latest frame.
+     *
+     *  Must be called from the thread modifying the EntityManager, while nothing else accesses it. Views acquired earlier keep seeing their own frame.
+     ***
+     *  @fn View PublishedAttribute::acquire() const
+     *  @brief Get a View of the latest published frame. Safe to call from any thread at any time.
+     *  @return View of the latest frame, or an invalid View if nothing has been published.
+     ***
+     *  @fn PublishedAttribute::~PublishedAttribute()
+     *  @brief Destructor.
+     *
+     *  Assert/undefined behavior if any View is still held.
+     ***/
+}
@@ -0,0 +1,168 @@
+    template<class DataType>
+    PublishedAttribute<DataType>::Frame::Frame() :
+        mReaders(0)
+    {
+    }
+
+    template<class DataType>
+    PublishedAttribute<DataType>::View::View() :
+        mFrame(nullptr)
+    {
+    }
+
+    template<class DataType>
+    PublishedAttribute<DataType>::View::View(View&& other) :
+        mFrame(other.mFrame)
+    {
+        other.mFrame = nullptr;
+    }
+
+    template<class DataType>
+    typename PublishedAttribute<DataType>::View& PublishedAttribute<DataType>::View::operator=(View&& other)
+    {
+        if(this != &other)
+        {
+            release();
+            mFrame = other.mFrame;
+            other.mFrame = nullptr;
+        }
+
+        return *this;
+    }
+
+    template<class DataType>
+    bool PublishedAttribute<DataType>::View::isValid() const
+    {
+        return mFrame != nullptr;
+    }
+
+    template<class DataType>
+    bool PublishedAttribute<DataType>::View::has(EntityHandle handle) const
+    {
+        if(!mFrame || handle.mIndex >= mFrame->mIndices.size())
+            return false;
+
+        uint32_t index = mFrame->mIndices[handle.mIndex];
+        return index != static_cast<uint32_t>(-1) && mFrame->mHandles[index].mGeneration == handle.mGeneration;
+    }
+
+    template<class DataType>
+    const DataType& PublishedAttribute<DataType>::View::get(EntityHandle handle) const
+    {
+        FEA_ASSERT(has(handle), "Trying to get the published value of entity ID '" + std::to_string(handle.mIndex) + "' which was not published!");
+        return mFrame->mValues[mFrame->mIndices[handle.mIndex]];
+    }
+
+    template<class DataType>
+    template<class Function>
+    void PublishedAttribute<DataType>::View::forEach(Function function) const
+    {
+        if(!mFrame)
+            return;
+
+        for(size_t i = 0; i < mFrame->mValues.size(); i++)
+            function(mFrame->mHandles[i].mIndex, mFrame->mValues[i]);
+    }
+
+    template<class DataType>
+    size_t PublishedAttribute<DataType>::View::size() const
+    {
+        return mFrame ? mFrame->mValues.size() : 0;
+    }
+
+    template<class DataType>
+    PublishedAttribute<DataType>::View::~View()
+    {
+        release();
+    }
+
+    template<class DataType>
+    PublishedAttribute<DataType>::View::View(Frame* frame) :
+        mFrame(frame)
+    {
+    }
+
+    template<class DataType>
+    void PublishedAttribute<DataType>::View::release()
+    {
+        if(mFrame)
+            mFrame->mReaders.fetch_sub(1);
+
+        mFrame = nullptr;
+    }
+
+    template<class DataType>
+    PublishedAttribute<DataType>::PublishedAttribute(EntityManager& entityManager, AttributeId<DataType> attribute) :
+        mEntityManager(entityManager),
+        mAttribute(attribute),
+        mCurrent(nullptr)
+    {
+        FEA_ASSERT(attribute.isValid(), "Trying to publish an invalid attribute ID!");
+    }
+
+    template<class DataType>
+    void PublishedAttribute<DataType>::publish()
+    {
+        Frame* frame = findFreeFrame();
+
+        //only the entries of the previous content are reset, so reusing a frame costs as much as the values it held
+        for(const EntityHandle& handle : frame->mHandles)
+            frame->mIndices[handle.mIndex] = static_cast<uint32_t>(-1);
+
+        frame->mHandles.clear();
+        frame->mValues.clear();
+
+        mEntityManager.forEach(mAttribute, [&] (EntityId id, const DataType& value)
+        {
+            if(id >= frame->mIndices.size())
+                frame->mIndices.resize(id + 1, static_cast<uint32_t>(-1));
+
+            frame->mIndices[id] = static_cast<uint32_t>(frame->mValues.size());
+            frame->mHandles.push_back(mEntityManager.getHandle(id));
+            frame->mValues.push_back(value);
+        });
+
+        mCurrent.store(frame);
+    }
+
+    template<class DataType>
+    typename PublishedAttribute<DataType>::View PublishedAttribute<DataType>::acquire() const
+    {
+        while(true)
+        {
+            Frame* frame = mCurrent.load();
+
+            if(!frame)
+                return View();
+
+            //the frame may have been replaced and handed back to the publisher since it was loaded, so it is only kept if it is still the latest one
+            frame->mReaders.fetch_add(1);
+
+            if(mCurrent.load() == frame)
+                return View(frame);
+
+            frame->mReaders.fetch_sub(1);
+        }
+    }
+
+    template<class DataType>
+    PublishedAttribute<DataType>::~PublishedAttribute()
+    {
+        for(const auto& frame : mFrames)
+            FEA_ASSERT(frame->mReaders.load() == 0, "Destroying a PublishedAttribute while a View of it is still held!");
+    }
+
+    template<class DataType>
+    typename PublishedAttribute<DataType>::Frame* PublishedAttribute<DataType>::findFreeFrame()
+    {
+        Frame* current = mCurrent.load();
+
+        for(const auto& frame : mFrames)
+        {
+            if(frame.get() != current && frame->mReaders.load() == 0)
+                return frame.get();
+        }
+
+        mFrames.emplace_back(new Frame());
+        return mFrames.back().get();
+    }
@@ -0,0 +1,103 @@
+#pragma once
+#include <fea/config.hpp>
+#include <fea/entity/entitycomponent.hpp>
+#include <fea/entity/entitymanager.hpp>
+#include <fea/util/loosentree.hpp>
+#include <algorithm>
+#include <vector>
+#include <stdint.h>
+
+namespace fea
+{
+    template<uint32_t Dimensions, uint32_t Depth, class PositionType, class SizeType = PositionType, bool StaticAllocation = false>
+    class SpatialComponent : public EntityComponent
+    {
+        public:
+            using Tree = LooseNTree<Dimensions, Depth, StaticAllocation>;
+
+            SpatialComponent(EntityManager& entityManager, AttributeId<PositionType> position, AttributeId<SizeType> size, const PositionType& worldStart, const PositionType& worldSize);
+            void updateIndex();
+            std::vector<EntityHandle> query(const PositionType& point) const;
+            std::vector<EntityHandle> query(const PositionType& start, const PositionType& end) const;
+            const Tree& getTree() const;
+        protected:
+            void memberAdded(EntityId id) override;
+            void memberRemoved(EntityId id) override;
+        private:
+            struct Entry
+            {
+                typename Tree::Vector mSize;
+                bool mInTree;
+                bool mDirty;
+            };
+
+            void markDirty(EntityId id);
+            template<class VectorType>
+            static typename Tree::Vector toTreeVector(const VectorType& vector);
+            typename Tree::Vector toTreePosition(const PositionType& position) const;
+            std::vector<EntityHandle> toHandles(const std::vector<typename Tree::TreeEntry>& entries) const;
+
+            EntityManager& mEntityManager;
+            AttributeId<PositionType> mPosition;
+            AttributeId<SizeType> mSize;
+            PositionType mWorldStart;
+            typename Tree::Vector mWorldSize;
+            Tree mTree;
+            std::vector<Entry> mEntries;
+            std::vector<EntityId> mDirty;
+            uint32_t mSeenVersion;
+    };
+#include <fea/entity/spatialcomponent.inl>
+
+    /** @addtogroup EntitySystem
+     *@{
+     *  @class SpatialComponent
+     *@}
+     ***
+     *  @class SpatialComponent
+     *  @brief EntityComponent keeping a LooseNTree in sync with the position and size attributes of its members.
+     *
+     *  Every entity which has both the position and the size attribute becomes a member of the component once it is added to the EntityManager using EntityManager::addComponent, and is put in the tree when SpatialComponent::updateIndex is called. Entities are removed from the tree as soon as they are removed or lose one of the attributes.
+     *
+     *  Updating the index does not go through all members. It only visits the entities that joined the component and the ones whose position or size has changed since the last update, as reported by EntityManager::forEachChanged. Writes made through EntityManager::forEach or an EntityView must be reported with EntityManager::markChanged to be picked up.
+     *
+     *  Positions are offset by the start of the world and clamped to its bounds before being put in the tree, so entities outside of the world are tracked at the closest border. Entities with a size of zero or less in any dimension are not tracked, and neither are entities whose position or size has not been given a value yet.
+     *
+     *  The position and size data types must give access to their coordinates using operator[], such as glm::vec2 or glm::vec3.
+     *  @tparam Dimensions Amount of dimensions of the world.
+     *  @tparam Depth Node depth of the tree, see LooseNTree.
+     *  @tparam PositionType Data type of the position attribute.
+     *  @tparam SizeType Data type of the size attribute.
+     *  @tparam StaticAllocation If the tree should allocate all nodes at once, see LooseNTree.
+     ***
+     *  @fn SpatialComponent::SpatialComponent(EntityManager& entityManager, AttributeId<PositionType> position, AttributeId<SizeType> size, const PositionType& worldStart, const PositionType& worldSize)
+     *  @brief Construct a SpatialComponent.
+     *
+     *  The component still has to be added to the EntityManager with EntityManager::addComponent. Assert/undefined behavior if the world size is zero or less in any dimension.
+     *  @param entityManager EntityManager holding the entities.
+     *  @param position ID of the position attribute.
+     *  @param size ID of the size attribute.
+     *  @param worldStart Lowest corner of the space the tree covers.
+     *  @param worldSize Size of the space the tree covers.
+     ***
+     *  @fn void SpatialComponent::updateIndex()
+     *  @brief Bring the tree up to date with the entities that joined the component or changed position or size since the last call.
+     *
+     *  This advances the change version of the EntityManager. It must not run at the same time as anything else writing to the EntityManager.
+     ***
+     *  @fn std::vector<EntityHandle> SpatialComponent::query(const PositionType& point) const
+     *  @brief Get all tracked entities which possibly overlap a point.
+     *  @param point Point to check at.
+     *  @return Handles of the entities that might overlap the point.
+     ***
+     *  @fn std::vector<EntityHandle> SpatialComponent::query(const PositionType& start, const PositionType& end) const
+     *  @brief Get all tracked entities which possibly overlap a box.
+     *  @param start Lowest corner of the box.
+     *  @param end Highest corner of the box.
+     *  @return Handles of the entities that might overlap the box.
+     ***
+     *  @fn const Tree& SpatialComponent::getTree() const
+     *  @brief Get the underlying tree, in which entities are stored by ID.
+     *  @return The tree.
+     ***/
+}
@@ -0,0 +1,164 @@
+    template<uint32_t Dimensions, uint32_t Depth, class PositionType, class SizeType, bool StaticAllocation>
+    SpatialComponent<Dimensions, Depth, PositionType, SizeType, StaticAllocation>::SpatialComponent(EntityManager& entityManager, AttributeId<PositionType> position, AttributeId<SizeType> size, const PositionType& worldStart, const PositionType& worldSize) :
+        mEntityManager(entityManager),
+        mPosition(position),
+        mSize(size),
+        mWorldStart(worldStart),
+        mWorldSize(toTreeVector(worldSize)),
+        mTree(mWorldSize),
+        mSeenVersion(0)
+    {
+        require(position);
+        require(size);
+        reads(position);
+        reads(size);
+    }
+
+    template<uint32_t Dimensions, uint32_t Depth, class PositionType, class SizeType, bool StaticAllocation>
+    void SpatialComponent<Dimensions, Depth, PositionType, SizeType, StaticAllocation>::updateIndex()
+    {
+        uint32_t until = mEntityManager.advanceChangeVersion();
+        const EntityManager& entityManager = mEntityManager;
+
+        entityManager.forEachChanged(mPosition, mSeenVersion, [&] (EntityId id, const PositionType&)
+        {
+            if(isMember(id))
+                markDirty(id);
+        });
+
+        entityManager.forEachChanged(mSize, mSeenVersion, [&] (EntityId id, const SizeType&)
+        {
+            if(isMember(id))
+                markDirty(id);
+        });
+
+        for(EntityId id : mDirty)
+        {
+            Entry& entry = mEntries[id];
+            entry.mDirty = false;
+
+            //members which left after being marked were already taken out of the tree
+            if(!isMember(id))
+                continue;
+
+            //attributes added without default values cannot be placed until they are set
+            if(!entityManager.hasValue(id, mPosition) || !entityManager.hasValue(id, mSize))
+                continue;
+
+            typename Tree::Vector position = toTreePosition(entityManager.getAttribute(id, mPosition));
+            typename Tree::Vector size = toTreeVector(entityManager.getAttribute(id, mSize));
+            bool sizeChanged = false;
+
+            for(uint32_t i = 0; i < Dimensions; i++)
+                sizeChanged = sizeChanged || size[i] != entry.mSize[i];
+
+            if(entry.mInTree && !sizeChanged)
+            {
+                mTree.move(id, position);
+                continue;
+            }
+
+            if(entry.mInTree)
+            {
+                mTree.remove(id);
+                entry.mInTree = false;
+            }
+
+            entry.mSize = size;
+
+            if(size.isPositive())
+            {
+                mTree.add(id, position, size);
+                entry.mInTree = true;
+            }
+        }
+
+        mDirty.clear();
+        mSeenVersion = until;
+    }
+
+    template<uint32_t Dimensions, uint32_t Depth, class PositionType, class SizeType, bool StaticAllocation>
+    std::vector<EntityHandle> SpatialComponent<Dimensions, Depth, PositionType, SizeType, StaticAllocation>::query(const PositionType& point) const
+    {
+        return toHandles(mTree.get(toTreePosition(point)));
+    }
+
+    template<uint32_t Dimensions, uint32_t Depth, class PositionType, class SizeType, bool StaticAllocation>
+    std::vector<EntityHandle> SpatialComponent<Dimensions, Depth, PositionType, SizeType, StaticAllocation>::query(const PositionType& start, const PositionType& end) const
+    {
+        return toHandles(mTree.get(toTreePosition(start), toTreePosition(end)));
+    }
+
+    template<uint32_t Dimensions, uint32_t Depth, class PositionType, class SizeType, bool StaticAllocation>
+    const typename SpatialComponent<Dimensions, Depth, PositionType, SizeType, StaticAllocation>::Tree& SpatialComponent<Dimensions, Depth, PositionType, SizeType, StaticAllocation>::getTree() const
+    {
+        return mTree;
+    }
+
+    template<uint32_t Dimensions, uint32_t Depth, class PositionType, class SizeType, bool StaticAllocation>
+    void SpatialComponent<Dimensions, Depth, PositionType, SizeType, StaticAllocation>::memberAdded(EntityId id)
+    {
+        markDirty(id);
+    }
+
+    template<uint32_t Dimensions, uint32_t Depth, class PositionType, class SizeType, bool StaticAllocation>
+    void SpatialComponent<Dimensions, Depth, PositionType, SizeType, StaticAllocation>::memberRemoved(EntityId id)
+    {
+        Entry& entry = mEntries[id];
+
+        if(entry.mInTree)
+        {
+            mTree.remove(id);
+            entry.mInTree = false;
+        }
+
+        entry.mSize = typename Tree::Vector();
+    }
+
+    template<uint32_t Dimensions, uint32_t Depth, class PositionType, class SizeType, bool StaticAllocation>
+    void SpatialComponent<Dimensions, Depth, PositionType, SizeType, StaticAllocation>::markDirty(EntityId id)
+    {
+        if(id >= mEntries.size())
+            mEntries.resize(id + 1, Entry{typename Tree::Vector(), false, false});
+
+        if(!mEntries[id].mDirty)
+        {
+            mEntries[id].mDirty = true;
+            mDirty.push_back(id);
+        }
+    }
+
+    template<uint32_t Dimensions, uint32_t Depth, class PositionType, class SizeType, bool StaticAllocation>
+    template<class VectorType>
+    typename SpatialComponent<Dimensions, Depth, PositionType, SizeType, StaticAllocation>::Tree::Vector SpatialComponent<Dimensions, Depth, PositionType, SizeType, StaticAllocation>::toTreeVector(const VectorType& vector)
+    {
+        typename Tree::Vector result;
+
+        for(uint32_t i = 0; i < Dimensions; i++)
+            result[i] = static_cast<float>(vector[i]);
+
+        return result;
+    }
+
+    template<uint32_t Dimensions, uint32_t Depth, class PositionType, class SizeType, bool StaticAllocation>
+    typename SpatialComponent<Dimensions, Depth, PositionType, SizeType, StaticAllocation>::Tree::Vector SpatialComponent<Dimensions, Depth, PositionType, SizeType, StaticAllocation>::toTreePosition(const PositionType& position) const
+    {
+        typename Tree::Vector result;
+
+        for(uint32_t i = 0; i < Dimensions; i++)
+            result[i] = std::min(std::max(static_cast<float>(position[i] - mWorldStart[i]), 0.0f), mWorldSize[i]);
+
+        return result;
+    }
+
+    template<uint32_t Dimensions, uint32_t Depth, class PositionType, class SizeType, bool StaticAllocation>
+    std::vector<EntityHandle> SpatialComponent<Dimensions, Depth, PositionType, SizeType, StaticAllocation>::toHandles(const std::vector<typename Tree::TreeEntry>& entries) const
+    {
+        std::vector<EntityHandle> handles;
+        handles.reserve(entries.size());
+
+        for(typename Tree::TreeEntry entry : entries)
+            handles.push_back(mEntityManager.getHandle(static_cast<EntityId>(entry)));
+
+        return handles;
+    }
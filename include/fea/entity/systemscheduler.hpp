@@ -0,0 +1,81 @@
+#pragma once
+#include <fea/config.hpp>
+#include <fea/entity/entitycomponent.hpp>
+#include <fea/entity/entityview.hpp>
+#include <fea/entity/threadpool.hpp>
+#include <functional>
+#include <vector>
+
+namespace fea
+{
+    class FEA_API SystemScheduler
+    {
+        public:
+            SystemScheduler(uint32_t threadAmount = 0);
+            void addComponent(EntityComponent& component);
+            void removeComponent(EntityComponent& component);
+            void run();
+            void parallelFor(size_t amount, size_t chunkSize, const std::function<void(size_t, size_t)>& function);
+            template<class Function, class... DataTypes>
+            void parallelForEach(const EntityView<DataTypes...>& view, Function function, size_t chunkSize = 1024);
+            ThreadPool& getThreadPool();
+        private:
+            std::vector<EntityComponent*> mComponents;
+            ThreadPool mThreadPool;
+    };
+#include <fea/entity/systemscheduler.inl>
+
+    /** @addtogroup EntitySystem
+     *@{
+     *  @class SystemScheduler
+     *@}
+     ***
+     *  @class SystemScheduler
+     *  @brief Runs entity components in parallel on a pool of worker threads.
+     *
+     *  Components are added to the scheduler in the order they should run. Every time SystemScheduler::run is called, the scheduler compares the attributes every component has declared to read and write and builds a dependency graph from that. Components that conflict with each other keep the order they were added in, while components that do not conflict run at the same time on the worker threads of a work stealing ThreadPool. The calling thread participates in the work and the function returns once all components have been updated.
+     *
+     *  A component with a lot of entities to process can split the work into chunks from within EntityComponent::update using SystemScheduler::parallelForEach. The chunks are then picked up by any idle worker, including the ones which have finished their own components.
+     *
+     *  Views used from within EntityComponent::update should be created beforehand, since creating a view modifies the EntityManager.
+     ***
+     *  @fn SystemScheduler::SystemScheduler(uint32_t threadAmount = 0)
+     *  @brief Construct a SystemScheduler.
+     *  @param threadAmount Amount of worker threads to start. If 0, one less than the amount of hardware threads is used.
+     ***
+     *  @fn void SystemScheduler::addComponent(EntityComponent& component)
+     *  @brief Add a component to be run by the scheduler.
+     *
+     *  The component is not owned by the scheduler and has to stay alive until it is removed or the scheduler is destroyed.
+     *  @param component Component to add.
+     ***
+     *  @fn void SystemScheduler::removeComponent(EntityComponent& component)
+     *  @brief Stop running a component.
+     *  @param component Component to remove.
+     ***
+     *  @fn void SystemScheduler::run()
+     *  @brief Update all components once and wait for all of them to finish.
+     ***
+     *  @fn void SystemScheduler::parallelFor(size_t amount, size_t chunkSize, const std::function<void(size_t, size_t)>& function)
+     *  @brief Split a range of work into chunks and process them in parallel.
+     *
+     *  The function is called as function(begin, end) once for every chunk, where the chunks together cover the range from 0 up to amount. Returns when all chunks have been processed.
+     *  @param amount Size of the range.
+     *  @param chunkSize Maximum amount of items in each chunk.
+     *  @param function Function processing a chunk.
+     ***
+     *  @fn void SystemScheduler::parallelForEach(const EntityView<DataTypes...>& view, Function function, size_t chunkSize = 1024)
+     *  @brief Iterate an EntityView in parallel chunks.
+     *
+     *  Works like EntityView::forEach but splits the entities into chunks which are processed by the worker threads. The function may be called from several threads at the same time for different entities, and should only modify the attribute values it is given.
+     *  @tparam Function Function to call. Can often be inferred automatically.
+     *  @tparam DataTypes Types of the attributes of the view.
+     *  @param view View to iterate.
+     *  @param function Function to call for every entity.
+     *  @param chunkSize Amount of entities in each chunk.
+     ***
+     *  @fn ThreadPool& SystemScheduler::getThreadPool()
+     *  @brief Get the thread pool used by the scheduler.
+     *  @return The thread pool.
+     ***/
+}
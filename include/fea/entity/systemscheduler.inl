@@ -0,0 +1,8 @@
+    template<class Function, class... DataTypes>
+    void SystemScheduler::parallelForEach(const EntityView<DataTypes...>& view, Function function, size_t chunkSize)
+    {
+        parallelFor(view.size(), chunkSize, [&view, &function] (size_t begin, size_t end)
+        {
+            view.forEach(function, begin, end);
+        });
+    }
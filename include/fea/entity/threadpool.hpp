@@ -0,0 +1,87 @@
+#pragma once
+#include <fea/config.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <stdint.h>
+
+namespace fea
+{
+    class FEA_API ThreadPool
+    {
+        public:
+            using Task = std::function<void()>;
+            ThreadPool(uint32_t threadAmount = 0);
+            ThreadPool(const ThreadPool& other) = delete;
+            ThreadPool& operator=(const ThreadPool& other) = delete;
+            void submit(Task task);
+            bool runPendingTask();
+            void wait(const std::atomic<uint32_t>& remaining);
+            uint32_t getThreadAmount() const;
+            ~ThreadPool();
+        private:
+            struct TaskQueue
+            {
+                std::mutex mMutex;
+                std::deque<Task> mTasks;
+            };
+            void workerLoop(uint32_t queueIndex);
+            uint32_t getQueueIndex() const;
+            bool popOwnTask(uint32_t queueIndex, Task& task);
+            bool stealTask(uint32_t queueIndex, Task& task);
+
+            std::vector<std::unique_ptr<TaskQueue>> mQueues;
+            std::vector<std::thread> mThreads;
+            std::vector<std::thread::id> mThreadIds;
+            std::atomic<uint32_t> mPendingTasks;
+            std::atomic<uint32_t> mNextQueue;
+            std::mutex mWakeMutex;
+            std::condition_variable mWakeCondition;
+            bool mStopping;
+    };
+
+    /** @addtogroup EntitySystem
+     *@{
+     *  @class ThreadPool
+     *@}
+     ***
+     *  @class ThreadPool
+     *  @brief Work stealing pool of worker threads used by the SystemScheduler.
+     *
+     *  Every worker owns a task queue. Tasks submitted from a worker end up in its own queue and are executed newest first, which keeps related work on the same core. When a worker runs out of tasks it steals the oldest task from another queue before going to sleep. Tasks submitted from outside of the pool are spread over the queues.
+     *
+     *  Threads waiting for tasks to finish using ThreadPool::wait help executing pending tasks instead of blocking, so it is safe to submit and wait for tasks from within a task.
+     ***
+     *  @fn ThreadPool::ThreadPool(uint32_t threadAmount = 0)
+     *  @brief Construct a ThreadPool and start its worker threads.
+     *
+     *  The thread that waits for tasks also executes them, so a pool with no worker threads is valid and runs all tasks on the waiting thread.
+     *  @param threadAmount Amount of worker threads to start. If 0, one less than the amount of hardware threads is used.
+     ***
+     *  @fn void ThreadPool::submit(Task task)
+     *  @brief Queue a task for execution.
+     *  @param task Task to execute.
+     ***
+     *  @fn bool ThreadPool::runPendingTask()
+     *  @brief Execute one pending task on the calling thread, if there is one.
+     *  @return True if a task was executed.
+     ***
+     *  @fn void ThreadPool::wait(const std::atomic<uint32_t>& remaining)
+     *  @brief Execute pending tasks on the calling thread until a counter reaches zero.
+     *
+     *  The counter is meant to be decremented by the tasks being waited for.
+     *  @param remaining Counter to wait for.
+     ***
+     *  @fn uint32_t ThreadPool::getThreadAmount() const
+     *  @brief Get the amount of worker threads, not counting threads which call ThreadPool::wait.
+     *  @return Amount of worker threads.
+     ***
+     *  @fn ThreadPool::~ThreadPool()
+     *  @brief Destructor. Finishes all pending tasks and joins the worker threads.
+     ***/
+}
@@ -2,6 +2,7 @@
 #include <fea/entity/entity.hpp>
 #include <fea/entity/entityfactory.hpp>
 #include <fea/entity/entitycomponent.hpp>
+#include <fea/entity/systemscheduler.hpp>
 // jsonentityloader.hpp is built conditionally,
 // so including this would result in an error when
 // Feather Kit has been built with BUILD_JSON=FALSE
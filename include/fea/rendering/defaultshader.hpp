@@ -8,5 +8,9 @@ namespace fea
     {
         static std::string vertexSource;
         static std::string fragmentSource;
+#ifndef EMSCRIPTEN
+        static std::string instancedVertexSource;
+        static std::string instancedFragmentSource;
+#endif
     };
 }
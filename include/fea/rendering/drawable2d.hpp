@@ -4,9 +4,12 @@
 #include <unordered_map>
 #include <glm/glm.hpp>
 #include <fea/rendering/renderentity.hpp>
+#include <fea/rendering/drawlist.hpp>
+#include <fea/rendering/vertexbuffer.hpp>
 #include <fea/rendering/color.hpp>
 #include <stdint.h>
 #include <string>
+#include <limits>
 
 namespace fea
 {
@@ -32,8 +35,11 @@ namespace fea
             Color getColor() const;
             void setOpacity(float opacity);
             float getOpacity() const;
+            void setStreaming(bool enabled);
+            bool isStreaming() const;
 
             virtual std::vector<RenderEntity> getRenderInfo() const;
+            virtual void queueRenderInfo(DrawList& drawList) const;
 
             void setExtraUniform(const Uniform& uniform);
             bool hasExtraUniform(const std::string& name) const;
@@ -41,6 +47,10 @@ namespace fea
             void removeExtraUniform(const std::string& name);
             void clearExtraUniforms();
         protected:
+            void queueBaseRenderInfo(DrawList& drawList) const;
+            void markVerticesDirty(size_t start = 0, size_t end = std::numeric_limits<size_t>::max());
+            void markTexCoordsDirty(size_t start = 0, size_t end = std::numeric_limits<size_t>::max());
+            void markVertexColorsDirty(size_t start = 0, size_t end = std::numeric_limits<size_t>::max());
             std::vector<float> mVertices;
             std::vector<float> mTexCoords;
             std::vector<float> mVertexColors;
@@ -51,7 +61,11 @@ namespace fea
             glm::vec2 mScaling;
             glm::vec2 mParallax;
             Color mColor;
+            bool mStreaming;
             std::unordered_map<std::string, Uniform> mExtraUniforms;
+            mutable VertexBuffer mVertexBuffer;
+            mutable VertexBuffer mTexCoordBuffer;
+            mutable VertexBuffer mVertexColorBuffer;
     };
     /** @addtogroup Render2D
      *@{
@@ -136,6 +150,16 @@ namespace fea
      *  @brief Get the opacity.
      *  @return Opacity.
      ***
+     *  @fn void Drawable2D::setStreaming(bool enabled)
+     *  @brief Set if the vertex data should be streamed every frame instead of kept in GL buffers of the drawable. Disabled by default.
+     *
+     *  Streaming suits drawables whose vertices change nearly every time they are drawn, such as text which is rewritten or particles. Their vertex data is then copied into the StreamBuffer of the Renderer2D each time they are queued, instead of reuploading the buffers of the drawable.
+     *  @param enabled True to stream.
+     ***
+     *  @fn bool Drawable2D::isStreaming() const
+     *  @brief Check if the vertex data is streamed.
+     *  @return True if streamed.
+     ***
      *  @fn Color Drawable2D::getColor() const
      *  @brief Get the color.
      *  @return The color of the drawable.
@@ -150,6 +174,37 @@ namespace fea
      *  The returned array contains RenderEntity instances which contain vertex information useful for rendering with OpenGL or similar. See RenderEntity for more information.
      *  @return Render information.
      ***
+     *  @fn virtual void Drawable2D::queueRenderInfo(DrawList& drawList) const
+     *  @brief Write the data used for rendering to a DrawList.
+     *
+     *  This is what the Renderer2D uses when queueing the drawable. Unlike Drawable2D::getRenderInfo, it does not allocate anything once the DrawList has grown to fit a frame. The default implementation adds what Drawable2D::getRenderInfo returns, so drawables which only override that function still render correctly. Drawables overriding this function should start with Drawable2D::queueBaseRenderInfo and add their own uniforms and vertex attributes to the same draw.
+     *
+     *  Drawables inheriting from one of the built in drawables which override Drawable2D::getRenderInfo must also override this function.
+     *  @param drawList List to add the draws to.
+     ***
+     *  @fn void Drawable2D::queueBaseRenderInfo(DrawList& drawList) const
+     *  @brief Add a draw holding the vertex attributes and uniforms common to all drawables, including the extra uniforms.
+     *
+     *  The vertices, texture coordinates and vertex colors are given to the draw as GL buffers, which are updated here with whatever has been marked as changed, or streamed if the drawable is set to stream. This requires a valid GL context.
+     *  @param drawList List to add the draw to.
+     ***
+     *  @fn void Drawable2D::markVerticesDirty(size_t start = 0, size_t end = std::numeric_limits<size_t>::max())
+     *  @brief Report that a range of Drawable2D::mVertices has changed, so that it is sent to the GPU the next time the drawable is queued.
+     *
+     *  Inheriting classes must call this whenever they change existing values. Values added to the end are detected without being marked. Without arguments, everything is marked.
+     *  @param start Index of the first changed float.
+     *  @param end Index after the last changed float.
+     ***
+     *  @fn void Drawable2D::markTexCoordsDirty(size_t start = 0, size_t end = std::numeric_limits<size_t>::max())
+     *  @brief Report that a range of Drawable2D::mTexCoords has changed. See Drawable2D::markVerticesDirty.
+     *  @param start Index of the first changed float.
+     *  @param end Index after the last changed float.
+     ***
+     *  @fn void Drawable2D::markVertexColorsDirty(size_t start = 0, size_t end = std::numeric_limits<size_t>::max())
+     *  @brief Report that a range of Drawable2D::mVertexColors has changed. See Drawable2D::markVerticesDirty.
+     *  @param start Index of the first changed float.
+     *  @param end Index after the last changed float.
+     ***
      *  @fn void Drawable2D::setExtraUniform(const Uniform& uniform)
      *  @brief Set an additional uniform for the drawable.
      *
@@ -211,5 +266,14 @@ namespace fea
      ***
      *  @var Drawable2D::mExtraUniforms
      *  @brief Map containing all additional uniforms added to the drawable.
+     ***
+     *  @var Drawable2D::mVertexBuffer
+     *  @brief GPU copy of the vertices.
+     ***
+     *  @var Drawable2D::mTexCoordBuffer
+     *  @brief GPU copy of the texture coordinates.
+     ***
+     *  @var Drawable2D::mVertexColorBuffer
+     *  @brief GPU copy of the vertex colors.
      ***/
 }
@@ -0,0 +1,223 @@
+#pragma once
+#include <fea/config.hpp>
+#include <fea/rendering/opengl.hpp>
+#include <fea/rendering/uniform.hpp>
+#include <fea/rendering/renderentity.hpp>
+#include <fea/rendering/streambuffer.hpp>
+#include <glm/glm.hpp>
+#include <vector>
+#include <stdint.h>
+
+namespace fea
+{
+    class FEA_API DrawList
+    {
+        public:
+            struct UniformValue
+            {
+                uint32_t mSlot;
+                UniformType mType;
+                uint32_t mOffset;
+            };
+
+            struct AttributeValue
+            {
+                uint32_t mSlot;
+                uint32_t mFloatAmount;
+                const float* mData;
+                GLuint mBuffer;
+                size_t mOffset;
+            };
+
+            struct Draw
+            {
+                GLenum mDrawMode;
+                uint32_t mElementAmount;
+                BlendMode mBlendMode;
+                uint16_t mLayer;
+                uint32_t mUniformStart;
+                uint32_t mUniformAmount;
+                uint32_t mAttributeStart;
+                uint32_t mAttributeAmount;
+            };
+
+            DrawList();
+            void addDraw(GLenum drawMode, uint32_t elementAmount);
+            void addUniform(uint32_t slot, float value);
+            void addUniform(uint32_t slot, const glm::vec2& value);
+            void addUniform(uint32_t slot, const glm::vec3& value);
+            void addUniform(uint32_t slot, const glm::vec4& value);
+            void addUniform(uint32_t slot, const glm::mat2x2& value);
+            void addUniform(uint32_t slot, const glm::mat4x4& value);
+            void addTexture(uint32_t slot, GLuint texture);
+            void addUniform(const Uniform& uniform);
+            void addVertexAttribute(uint32_t slot, uint32_t floatAmount, const float* data, GLuint buffer = 0);
+            void addStreamedVertexAttribute(uint32_t slot, uint32_t floatAmount, const float* data, size_t vertexAmount);
+            float* addTransientVertexAttribute(uint32_t slot, uint32_t floatAmount, size_t vertexAmount);
+            void setStreamBuffer(StreamBuffer* streamBuffer);
+            void addRenderEntity(const RenderEntity& renderEntity);
+            void setBlendMode(size_t firstDraw, BlendMode mode);
+            void setLayer(size_t firstDraw, uint16_t layer);
+            const std::vector<Draw>& getDraws() const;
+            const UniformValue* getUniforms(const Draw& draw) const;
+            const AttributeValue* getVertexAttributes(const Draw& draw) const;
+            const void* getUniformData(const UniformValue& uniform) const;
+            size_t getDrawAmount() const;
+            void clear();
+        private:
+            void addUniformData(uint32_t slot, UniformType type, const float* data, uint32_t floatAmount);
+
+            std::vector<Draw> mDraws;
+            std::vector<UniformValue> mUniforms;
+            std::vector<AttributeValue> mAttributes;
+            std::vector<float> mUniformData;
+            StreamBuffer* mStreamBuffer;
+    };
+    /** @addtogroup Render2D
+     *@{
+     *  @class DrawList
+     *@}
+     ***
+     *  @class DrawList
+     *  @brief Compact list of draws queued for rendering during one frame.
+     *
+     *  Every draw holds its draw mode, element amount and blend mode, along with a range of uniform values and a range of vertex attributes. Uniforms and vertex attributes refer to their names using ShaderSlots, and uniform values are stored next to each other in one array of floats. Vertex attributes only point to the vertex data of the drawable, which must stay unchanged until the list has been rendered.
+     *
+     *  Clearing the list keeps all of its memory, so once a few frames have been rendered, queueing draws does not allocate. The Renderer2D owns one DrawList which drawables write to in Drawable2D::queueRenderInfo.
+     *
+     *  Uniforms and vertex attributes are always added to the most recently added draw, and later values replace earlier values with the same slot when rendered.
+     ***
+     *  @class DrawList::UniformValue
+     *  @brief A uniform of a draw, whose value is found using DrawList::getUniformData.
+     ***
+     *  @class DrawList::AttributeValue
+     *  @brief A vertex attribute of a draw, pointing to the vertex data and the GL buffer holding a copy of it, if any.
+     *
+     *  mOffset is the byte offset of the data in the GL buffer. mData is null for transient vertex data written straight to a GL buffer, which cannot be read back.
+     ***
+     *  @class DrawList::Draw
+     *  @brief One draw call, with the ranges of its uniforms and vertex attributes.
+     ***
+     *  @fn DrawList::DrawList()
+     *  @brief Construct an empty list.
+     ***
+     *  @fn void DrawList::addDraw(GLenum drawMode, uint32_t elementAmount)
+     *  @brief Start a new draw. The blend mode and layer are set by the Renderer2D.
+     *  @param drawMode GL draw mode of the draw.
+     *  @param elementAmount Amount of vertices to draw.
+     ***
+     *  @fn void DrawList::addUniform(uint32_t slot, float value)
+     *  @brief Add a float uniform to the last draw.
+     *
+     *  Assert/undefined behavior if no draw has been added. The same goes for all other functions adding uniforms and vertex attributes.
+     *  @param slot Slot of the uniform, see ShaderSlots.
+     *  @param value Value.
+     ***
+     *  @fn void DrawList::addUniform(uint32_t slot, const glm::vec2& value)
+     *  @brief Add a vec2 uniform to the last draw.
+     *  @param slot Slot of the uniform.
+     *  @param value Value.
+     ***
+     *  @fn void DrawList::addUniform(uint32_t slot, const glm::vec3& value)
+     *  @brief Add a vec3 uniform to the last draw.
+     *  @param slot Slot of the uniform.
+     *  @param value Value.
+     ***
+     *  @fn void DrawList::addUniform(uint32_t slot, const glm::vec4& value)
+     *  @brief Add a vec4 uniform to the last draw.
+     *  @param slot Slot of the uniform.
+     *  @param value Value.
+     ***
+     *  @fn void DrawList::addUniform(uint32_t slot, const glm::mat2x2& value)
+     *  @brief Add a mat2x2 uniform to the last draw.
+     *  @param slot Slot of the uniform.
+     *  @param value Value.
+     ***
+     *  @fn void DrawList::addUniform(uint32_t slot, const glm::mat4x4& value)
+     *  @brief Add a mat4x4 uniform to the last draw.
+     *  @param slot Slot of the uniform.
+     *  @param value Value.
+     ***
+     *  @fn void DrawList::addTexture(uint32_t slot, GLuint texture)
+     *  @brief Add a texture uniform to the last draw.
+     *  @param slot Slot of the uniform.
+     *  @param texture ID of the GL texture.
+     ***
+     *  @fn void DrawList::addUniform(const Uniform& uniform)
+     *  @brief Add a named uniform to the last draw, looking up the slot of its name.
+     *  @param uniform Uniform to add.
+     ***
+     *  @fn void DrawList::addVertexAttribute(uint32_t slot, uint32_t floatAmount, const float* data, GLuint buffer = 0)
+     *  @brief Add a vertex attribute to the last draw.
+     *
+     *  When a GL buffer is given, the renderer binds it instead of sending the vertex data, which is then only read when the draw is batched.
+     *  @param slot Slot of the vertex attribute.
+     *  @param floatAmount Amount of floats per vertex.
+     *  @param data Vertex data. Must stay valid until the list is rendered.
+     *  @param buffer GL buffer holding the same data, see VertexBuffer. 0 if there is none.
+     ***
+     *  @fn void DrawList::addStreamedVertexAttribute(uint32_t slot, uint32_t floatAmount, const float* data, size_t vertexAmount)
+     *  @brief Add a vertex attribute to the last draw, copying the vertex data into the StreamBuffer.
+     *
+     *  Meant for vertex data which changes nearly every frame. Without a StreamBuffer, the data is added like with DrawList::addVertexAttribute without a buffer.
+     *  @param slot Slot of the vertex attribute.
+     *  @param floatAmount Amount of floats per vertex.
+     *  @param data Vertex data. Must stay valid until the list is rendered, since batching reads it.
+     *  @param vertexAmount Amount of vertices.
+     ***
+     *  @fn float* DrawList::addTransientVertexAttribute(uint32_t slot, uint32_t floatAmount, size_t vertexAmount)
+     *  @brief Add a vertex attribute to the last draw, whose data is written by the caller into space taken from the StreamBuffer.
+     *
+     *  This lets drawables generate vertices straight into GPU memory without keeping them. The returned memory may be mapped GL memory, which must only be written and not read. Draws using transient vertex data are never batched. Assert/undefined behavior if the list has no StreamBuffer.
+     *  @param slot Slot of the vertex attribute.
+     *  @param floatAmount Amount of floats per vertex.
+     *  @param vertexAmount Amount of vertices.
+     *  @return Pointer to write floatAmount * vertexAmount floats to. Valid until the list is rendered.
+     ***
+     *  @fn void DrawList::setStreamBuffer(StreamBuffer* streamBuffer)
+     *  @brief Set the StreamBuffer to take space for streamed vertex data from. The Renderer2D gives its DrawList its own StreamBuffer.
+     *  @param streamBuffer The StreamBuffer, or nullptr for none.
+     ***
+     *  @fn void DrawList::addRenderEntity(const RenderEntity& renderEntity)
+     *  @brief Add a draw described by a RenderEntity.
+     *
+     *  This is used for drawables which only implement Drawable2D::getRenderInfo. The blend mode of the RenderEntity is not used.
+     *  @param renderEntity Render information to add.
+     ***
+     *  @fn void DrawList::setBlendMode(size_t firstDraw, BlendMode mode)
+     *  @brief Set the blend mode of all draws starting from the given index.
+     *  @param firstDraw Index of the first draw to change.
+     *  @param mode Blend mode.
+     ***
+     *  @fn void DrawList::setLayer(size_t firstDraw, uint16_t layer)
+     *  @brief Set the layer of all draws starting from the given index.
+     *  @param firstDraw Index of the first draw to change.
+     *  @param layer Layer, see Renderer2D::setLayer.
+     ***
+     *  @fn const std::vector<Draw>& DrawList::getDraws() const
+     *  @brief Get all draws, in the order they were added.
+     *  @return List of draws.
+     ***
+     *  @fn const UniformValue* DrawList::getUniforms(const Draw& draw) const
+     *  @brief Get the uniforms of a draw.
+     *  @param draw The draw.
+     *  @return Pointer to the first of Draw::mUniformAmount uniforms.
+     ***
+     *  @fn const AttributeValue* DrawList::getVertexAttributes(const Draw& draw) const
+     *  @brief Get the vertex attributes of a draw.
+     *  @param draw The draw.
+     *  @return Pointer to the first of Draw::mAttributeAmount vertex attributes.
+     ***
+     *  @fn const void* DrawList::getUniformData(const UniformValue& uniform) const
+     *  @brief Get the value of a uniform, in the form expected by Shader::setUniform.
+     *  @param uniform The uniform.
+     *  @return Pointer to the value.
+     ***
+     *  @fn size_t DrawList::getDrawAmount() const
+     *  @brief Get the amount of draws.
+     *  @return Amount of draws.
+     ***
+     *  @fn void DrawList::clear()
+     *  @brief Remove all draws while keeping the memory for the next frame.
+     ***/
+}
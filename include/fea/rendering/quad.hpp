@@ -18,6 +18,7 @@ namespace fea
             void setHFlip(bool enabled);
             void setVFlip(bool enabled);
             virtual std::vector<RenderEntity> getRenderInfo() const override;
+            virtual void queueRenderInfo(DrawList& drawList) const override;
         protected:
             float mHFlip;
             float mVFlip;
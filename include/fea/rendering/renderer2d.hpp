@@ -5,16 +5,34 @@
 #include <fea/rendering/rendertarget.hpp>
 #include <fea/rendering/shader.hpp>
 #include <fea/rendering/renderentity.hpp>
+#include <fea/rendering/drawlist.hpp>
+#include <fea/rendering/vertexbuffer.hpp>
+#include <fea/rendering/streambuffer.hpp>
 #include <memory>
+#include <vector>
+#include <stdint.h>
 
 namespace fea
 {
     class Drawable2D;
 
+    enum BatchBreak { TEXTURE_CHANGE, BLEND_MODE_CHANGE, UNIFORM_CHANGE, UNBATCHABLE_DRAW, BATCH_BREAK_AMOUNT };
+
+    struct FEA_API RenderStats
+    {
+        RenderStats();
+        uint32_t mDrawAmount;
+        uint32_t mDrawCallAmount;
+        uint32_t mBatchAmount;
+        uint32_t mInstanceAmount;
+        uint32_t mBatchBreaks[BATCH_BREAK_AMOUNT];
+    };
+
     class FEA_API Renderer2D
     {
         public:
             Renderer2D(const Viewport& viewport);
+            ~Renderer2D();
             void setup();
             void clear(const Color& color = Color());
             void clear(const RenderTarget& target, const Color& color = Color());
@@ -26,16 +44,72 @@ namespace fea
             void setViewport(const Viewport& viewport);
             Viewport& getViewport();
             void setBlendMode(BlendMode mode);
+            void setBatching(bool enabled);
+            bool isBatching() const;
+            void setSorting(bool enabled);
+            bool isSorting() const;
+            void setInstancing(bool enabled);
+            bool isInstancing() const;
+            void setLayer(uint16_t layer);
+            uint16_t getLayer() const;
+            const RenderStats& getRenderStats() const;
         private:
+            struct InstanceRun
+            {
+                uint32_t mStart;
+                uint32_t mDrawAmount;
+                uint32_t mFirstInstance;
+                GLuint mTexture;
+                bool mInstanced;
+            };
+
+            void setCameraUniforms(const Shader& shader);
             void setBlendModeGl(BlendMode mode);
+            void renderDraw(const Shader& shader, const DrawList::Draw& draw, GLuint defaultTextureId);
+            void renderBatched(const Shader& shader, GLuint defaultTextureId);
+            bool setupInstancing();
+            void renderInstanced(const Shader& shader, GLuint defaultTextureId);
+            void sortQueue(GLuint defaultTextureId);
+            const DrawList::Draw& getQueuedDraw(size_t index) const;
             Viewport mCurrentViewport;
 
             Texture mDefaultTexture;
             Shader mDefaultShader;
+            Shader mInstancedShader;
             glm::mat4 mProjection;
 
             BlendMode mCurrentBlendMode;
-            std::vector<RenderEntity> mRenderQueue;
+            StreamBuffer mStreamBuffer;
+            DrawList mRenderQueue;
+
+            bool mBatching;
+            bool mSorting;
+            bool mInstancing;
+            bool mInstancingChecked;
+            bool mInstancingSupported;
+            uint16_t mCurrentLayer;
+            BlendMode mGlBlendMode;
+            bool mGlBlendModeSet;
+            RenderStats mStats;
+            std::vector<uint64_t> mSortKeys;
+            std::vector<uint64_t> mSortKeysBuffer;
+            std::vector<uint32_t> mDrawOrder;
+            std::vector<uint32_t> mDrawOrderBuffer;
+            std::vector<float> mBatchVertices;
+            std::vector<float> mBatchTexCoords;
+            std::vector<float> mBatchColors;
+            std::vector<InstanceRun> mInstanceRuns;
+            std::vector<float> mInstanceData;
+            GLuint mInstanceBuffer;
+            size_t mInstanceBufferSize;
+            GLuint mInstanceTexture;
+            uint32_t mMaxInstances;
+            std::vector<float> mInstanceCorners;
+            VertexBuffer mInstanceCornerBuffer;
+            uint32_t mSpriteTextureSlot;
+            uint32_t mInstancesSlot;
+            uint32_t mInstanceOffsetSlot;
+            uint32_t mCornerSlot;
 
             //cache
             Color mClearColor;
@@ -43,6 +117,8 @@ namespace fea
     /** @addtogroup Render2D
      *@{
      *  @class InvalidFontException
+     *  @enum BatchBreak
+     *  @class RenderStats
      *  @class Renderer2D
      *@}
      ***
@@ -53,17 +129,45 @@ namespace fea
      *  @brief Construct an exception to throw containing a message.
      *  @param message Message further describing the error.
      ***
+     *  @enum BatchBreak
+     *  @brief Reasons for the Renderer2D to end a batch and start a new draw call.
+     *
+     *  TEXTURE_CHANGE and BLEND_MODE_CHANGE mean that the next draw uses another texture or blend mode. UNIFORM_CHANGE means that a uniform other than the transform and color differs, for instance the opacity, the texture constraints or an extra uniform. UNBATCHABLE_DRAW means that the next draw cannot be batched at all and is drawn on its own.
+     ***
+     *  @class RenderStats
+     *  @brief Statistics of the last call to Renderer2D::render.
+     ***
+     *  @var RenderStats::mDrawAmount
+     *  @brief Amount of draws queued by drawables. Most drawables queue one draw.
+     ***
+     *  @var RenderStats::mDrawCallAmount
+     *  @brief Amount of GL draw calls issued.
+     ***
+     *  @var RenderStats::mBatchAmount
+     *  @brief Amount of batches formed. Each batch is one draw call made out of one or more draws. Always zero when neither batching nor instancing is enabled.
+     ***
+     *  @var RenderStats::mInstanceAmount
+     *  @brief Amount of draws rendered as instances of an instanced draw call.
+     ***
+     *  @var RenderStats::mBatchBreaks
+     *  @brief How many times a batch was ended for each BatchBreak reason. Batches ended by the end of the queue are not counted.
+     ***
      *  @class Renderer2D
      *  @brief Used to render 2D drawables to the screen.
      *
      *  This class provides a complete interface for rendering to the screen. Only objects which inherit from the Drawable2D base class may be rendered.
      *
      *  The Renderer2D keeps a Viewport describing the size of the render area as well as the current camera data.
+     *
+     *  It also owns a StreamBuffer which drawables with vertex data that changes every frame can stream their vertices through, see Drawable2D::setStreaming. Every call to render uses the next region of it.
      ***
      *  @fn Renderer2D::Renderer2D(Viewport viewport)
      *  @brief Construct a renderer with the given Viewport.
      *
      *  @param viewport Viewport to use.
+     ***
+     *  @fn Renderer2D::~Renderer2D()
+     *  @brief Destructor. Deletes the GL objects used for instancing.
      *** 
      *  @fn void Renderer2D::setup()
      *  @brief Perform one-time setup for the renderer.
@@ -125,5 +229,55 @@ namespace fea
      *  The blend mode decides how drawables are blended with the background when they are drawn.
      * 
      *  @param mode Blend mode.
+     ***
+     *  @fn void Renderer2D::setBatching(bool enabled)
+     *  @brief Enable or disable batching of drawables. Disabled by default.
+     *
+     *  When batching, consecutive draws in GL_TRIANGLES mode with vertices, texture coordinates and vertex colors, which share texture, blend mode and all other uniforms, are merged into a single draw call. Their position, origin, rotation, scaling, parallax and color are applied to the vertices on the CPU instead of in the shader. This suits the built in quads and tile chunks, and reduces the draw calls of scenes with many sprites using the same texture. Draws are never reordered.
+     *
+     *  Batched draws are rendered with the transform uniforms of the shader set to identity, so custom shaders must treat them like the default shader does.
+     *  @param enabled True to enable batching.
+     ***
+     *  @fn bool Renderer2D::isBatching() const
+     *  @brief Check if batching is enabled.
+     *  @return True if enabled.
+     ***
+     *  @fn void Renderer2D::setSorting(bool enabled)
+     *  @brief Enable or disable sorting of the queue. Disabled by default.
+     *
+     *  When sorting, every queued draw gets a 64 bit key made of its layer, blend mode and texture, and the queue is radix sorted by these keys before rendering. Layers are drawn in increasing order, and within a layer, draws sharing blend mode and texture are drawn together so that the GL state only changes when the key does. Draws with equal keys keep the order they were queued in.
+     *
+     *  Drawables in the same layer may be drawn in any order relative to each other, so drawables which overlap and must blend in a given order should be put in different layers using Renderer2D::setLayer. Sorting combines with batching, which then merges the draws made consecutive by the sort.
+     *  @param enabled True to enable sorting.
+     ***
+     *  @fn bool Renderer2D::isSorting() const
+     *  @brief Check if sorting is enabled.
+     *  @return True if enabled.
+     ***
+     *  @fn void Renderer2D::setInstancing(bool enabled)
+     *  @brief Enable or disable instanced rendering of quads. Disabled by default.
+     *
+     *  When instancing, consecutive quad shaped draws such as those of Quad, SubrectQuad and AnimatedQuad, which share texture, blend mode and extra uniforms, are drawn with a single instanced draw call. Their transform, color, opacity, texture rectangle and constraints are packed into an instance buffer read by an instanced variant of the default shader, so unlike batching, no vertices are built on the CPU. All other draws are drawn one by one, and batching is not used while instancing is enabled. Instancing combines with sorting.
+     *
+     *  Only takes effect when rendering with the default shader. The instanced shader is compiled the first time instancing is used, and requires GL 3.1 with GLSL 1.40. On older contexts and when built for the web, draws are rendered as if instancing was disabled.
+     *  @param enabled True to enable instancing.
+     ***
+     *  @fn bool Renderer2D::isInstancing() const
+     *  @brief Check if instancing is enabled.
+     *  @return True if enabled.
+     ***
+     *  @fn void Renderer2D::setLayer(uint16_t layer)
+     *  @brief Set which layer drawables queued after this call belong to. Layers only have an effect when sorting is enabled.
+     *
+     *  Lower layers are drawn first. The layer stays until changed, and is 0 by default.
+     *  @param layer Layer.
+     ***
+     *  @fn uint16_t Renderer2D::getLayer() const
+     *  @brief Get the layer drawables are currently queued in.
+     *  @return The layer.
+     ***
+     *  @fn const RenderStats& Renderer2D::getRenderStats() const
+     *  @brief Get statistics about the last render call, such as the amount of draw calls and why batches were broken.
+     *  @return The statistics.
      ***/
 }
@@ -2,7 +2,6 @@
 #include <fea/config.hpp>
 #include <fea/rendering/uniform.hpp>
 #include <fea/rendering/vertexattribute.hpp>
-#include <unordered_map>
 #include <vector>
 #include <string>
 #include <stdexcept>
@@ -31,16 +30,46 @@ namespace fea
             void setUniform(const std::string& name, UniformType type, const void* value) const;
             void setUniform(const std::string& name, UniformType type, int32_t count, const void* value) const;
             void setVertexAttribute(const std::string& name, const uint32_t floatAmount, const float* data) const;
+            void setVertexBuffer(const std::string& name, const uint32_t floatAmount, GLuint buffer) const;
+            void setUniform(uint32_t slot, UniformType type, const void* value) const;
+            void setVertexAttribute(uint32_t slot, const uint32_t floatAmount, const float* data) const;
+            void setVertexBuffer(uint32_t slot, const uint32_t floatAmount, GLuint buffer, size_t offset = 0) const;
+            void setTextureBuffer(uint32_t slot, uint32_t unit, GLuint texture) const;
+            bool hasUniform(uint32_t slot) const;
+            bool hasVertexAttribute(uint32_t slot) const;
             void compile();
         private:
+            struct UniformSlot
+            {
+                GLint mLocation;
+                bool mDeclared;
+                bool mCached;
+                UniformType mType;
+                float mValue[16];
+            };
+
+            struct AttributeSlot
+            {
+                GLint mLocation;
+                bool mDeclared;
+                bool mEnabled;
+                uint32_t mFloatAmount;
+                GLuint mBuffer;
+                const float* mData;
+            };
+
+            void addLocations(const std::string& source, bool vertexStage);
+            UniformSlot* getUniformSlot(uint32_t slot) const;
+            AttributeSlot* getAttributeSlot(uint32_t slot) const;
+            void setVertexPointer(uint32_t slot, const uint32_t floatAmount, GLuint buffer, const float* data) const;
             GLuint mProgramId;
-            std::unordered_map<std::string, GLint> mUniformLocations;
-            std::unordered_map<std::string, GLint> mVertexAttributeLocations;
+            mutable std::vector<UniformSlot> mUniformSlots;
+            mutable std::vector<AttributeSlot> mAttributeSlots;
             std::string mVertexSource;
             std::string mFragmentSource;
             GLuint mVertexShader;
             GLuint mFragmentShader;
-            mutable std::vector<GLint> mEnabledVertexAttributes;
+            mutable GLuint mBoundTexture;
     };
     /** @addtogroup Render2D
      *@{
@@ -57,6 +86,10 @@ namespace fea
      ***
      *  @class Shader
      *  @brief A representation of a shader which can be used by the renderer2d for rendering.
+     *
+     *  When compiled, every uniform and vertex attribute of the source is given its slot from ShaderSlots, and its GL location is stored by that slot. Setting values by slot is then a plain array access, and setting them by name costs one extra hash lookup.
+     *
+     *  The shader remembers the last value it sent for every uniform and does not make any GL call when the same value is set again. The bound texture is only remembered while the shader is active, since other code binds textures too. Values must therefore not be changed with GL calls made outside of the Shader.
      ***
      *  @fn Shader::Shader()
      *  @brief Construct an uninitialized Shader.
@@ -92,6 +125,8 @@ namespace fea
      ***
      *  @fn void Shader::setUniform(const std::string& name, UniformType type, const void* value) const
      *  @brief Set a uniform variable in the shader.
+     *
+     *  Does nothing if the source of the shader does not declare a uniform with that name, just like GL ignores a location of -1. The same goes for the other functions setting uniforms and vertex attributes.
      *  @param name Name of the uniform to set.
      *  @param type Type of the uniform.
      *  @param value Void pointer to the data.
@@ -109,9 +144,52 @@ namespace fea
      *  @param floatAmount Amount of floats in the attribute.
      *  @param data Data array.
      ***
+     *  @fn void Shader::setVertexBuffer(const std::string& name, const uint32_t floatAmount, GLuint buffer) const
+     *  @brief Set a vertex attribute in the shader, reading the data from a GL buffer already holding it.
+     *  @param name Name of the attribute to set.
+     *  @param floatAmount Amount of floats in the attribute.
+     *  @param buffer ID of the GL buffer, see VertexBuffer.
+     ***
+     *  @fn void Shader::setUniform(uint32_t slot, UniformType type, const void* value) const
+     *  @brief Set a uniform variable in the shader using its slot.
+     *  @param slot Slot of the uniform, see ShaderSlots.
+     *  @param type Type of the uniform.
+     *  @param value Void pointer to the data.
+     ***
+     *  @fn void Shader::setVertexAttribute(uint32_t slot, const uint32_t floatAmount, const float* data) const
+     *  @brief Set a vertex attribute in the shader using its slot.
+     *  @param slot Slot of the attribute, see ShaderSlots.
+     *  @param floatAmount Amount of floats in the attribute.
+     *  @param data Data array.
+     ***
+     *  @fn void Shader::setVertexBuffer(uint32_t slot, const uint32_t floatAmount, GLuint buffer, size_t offset = 0) const
+     *  @brief Set a vertex attribute in the shader using its slot, reading the data from a GL buffer.
+     *  @param slot Slot of the attribute, see ShaderSlots.
+     *  @param floatAmount Amount of floats in the attribute.
+     *  @param buffer ID of the GL buffer.
+     *  @param offset Byte offset of the data in the buffer.
+     ***
+     *  @fn void Shader::setTextureBuffer(uint32_t slot, uint32_t unit, GLuint texture) const
+     *  @brief Bind a buffer texture to a texture unit and point a samplerBuffer uniform at it.
+     *
+     *  The unit must not be 0, which is used by the TEXTURE uniforms. Not available when built for the web.
+     *  @param slot Slot of the samplerBuffer uniform.
+     *  @param unit Texture unit to bind the texture to.
+     *  @param texture ID of the GL buffer texture.
+     ***
+     *  @fn bool Shader::hasUniform(uint32_t slot) const
+     *  @brief Check if the source of the shader declares a uniform.
+     *  @param slot Slot of the uniform.
+     *  @return True if declared.
+     ***
+     *  @fn bool Shader::hasVertexAttribute(uint32_t slot) const
+     *  @brief Check if the source of the shader declares a vertex attribute.
+     *  @param slot Slot of the attribute.
+     *  @return True if declared.
+     ***
      *  @fn void Shader::compile()
      *  @brief Compile the shader from the current set source.
      *
-     *  Throws a GLSLException on failure with the error message.
+     *  Throws a GLSLException on failure with the error message. Vertex attributes can be declared with the attribute keyword or, for GLSL 1.40 and later, as in variables at the start of a line of the vertex source.
      ***/
 }
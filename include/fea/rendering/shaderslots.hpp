@@ -0,0 +1,50 @@
+#pragma once
+#include <fea/config.hpp>
+#include <string>
+#include <stdint.h>
+
+namespace fea
+{
+    class FEA_API ShaderSlots
+    {
+        public:
+            enum BuiltIn : uint32_t { POSITION, ORIGIN, ROTATION, SCALING, PARALLAX, CONSTRAINTS, COLOR, OPACITY, TEXTURE, CAM_POSITION, CAM_ZOOM, CAM_ROTATION, HALF_VIEW_SIZE, PROJECTION, VERTEX, TEX_COORDS, COLORS, BUILT_IN_AMOUNT };
+
+            static uint32_t get(const std::string& name);
+            static const std::string& getName(uint32_t slot);
+            static uint32_t getAmount();
+    };
+    /** @addtogroup Render2D
+     *@{
+     *  @class ShaderSlots
+     *@}
+     ***
+     *  @class ShaderSlots
+     *  @brief Global table giving every uniform and vertex attribute name a small integer slot.
+     *
+     *  Slots let render data refer to uniforms and vertex attributes without storing or comparing strings. A name gets the same slot for the whole run of the program, no matter which shader it is used with. The names used by the default shader are registered from the start and have fixed slots listed in ShaderSlots::BuiltIn.
+     *
+     *  The table is not thread safe and is meant to be used from the rendering thread.
+     ***
+     *  @enum ShaderSlots::BuiltIn
+     *  @brief Slots of the uniforms and vertex attributes of the default shader.
+     ***
+     *  @fn static uint32_t ShaderSlots::get(const std::string& name)
+     *  @brief Get the slot of a name, giving it a new slot if it does not have one.
+     *
+     *  Only names seen for the first time cause an allocation.
+     *  @param name Name of the uniform or vertex attribute.
+     *  @return The slot.
+     ***
+     *  @fn static const std::string& ShaderSlots::getName(uint32_t slot)
+     *  @brief Get the name of a slot.
+     *
+     *  Assert/undefined behavior if the slot does not exist.
+     *  @param slot The slot.
+     *  @return Name of the uniform or vertex attribute.
+     ***
+     *  @fn static uint32_t ShaderSlots::getAmount()
+     *  @brief Get the amount of slots given out so far. Slots are numbered from zero.
+     *  @return Amount of slots.
+     ***/
+}
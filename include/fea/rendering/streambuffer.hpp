@@ -0,0 +1,100 @@
+#pragma once
+#include <fea/config.hpp>
+#include <fea/rendering/opengl.hpp>
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace fea
+{
+    class FEA_API StreamBuffer
+    {
+        public:
+            struct Allocation
+            {
+                float* mData;
+                GLuint mBuffer;
+                size_t mOffset;
+            };
+
+            StreamBuffer(size_t regionFloatAmount = 262144, uint32_t regionAmount = 3);
+            StreamBuffer(const StreamBuffer& other) = delete;
+            StreamBuffer& operator=(const StreamBuffer& other) = delete;
+            Allocation allocate(size_t floatAmount);
+            void unmap();
+            void endRegion();
+            size_t getRegionFloatAmount() const;
+            uint32_t getRegionAmount() const;
+            ~StreamBuffer();
+        private:
+            bool map();
+            void waitForRegion(uint32_t region);
+            float* allocateClientSide(size_t floatAmount);
+
+            GLuint mId;
+            size_t mRegionFloatAmount;
+            uint32_t mRegionAmount;
+            uint32_t mRegion;
+            size_t mWriteOffset;
+            size_t mRequestedAmount;
+            float* mMapped;
+            bool mMappingChecked;
+            bool mMappingSupported;
+#ifndef EMSCRIPTEN
+            std::vector<GLsync> mFences;
+#endif
+            std::vector<std::vector<float>> mClientChunks;
+            size_t mClientChunk;
+            size_t mClientOffset;
+    };
+    /** @addtogroup Render2D
+     *@{
+     *  @class StreamBuffer
+     *@}
+     ***
+     *  @class StreamBuffer
+     *  @brief Ring of GL buffer regions for streaming vertex data which is rewritten every frame.
+     *
+     *  The buffer is one large GL buffer split into regions. Each call to Renderer2D::render writes to one region and then moves on to the next, so the region written is one the GPU finished drawing from several renders ago. The region is mapped without synchronisation the first time it is allocated from, and a fence placed after rendering tells when the GPU is done with it. In the steady state, streaming therefore neither stalls on the driver nor allocates buffers.
+     *
+     *  Allocations which do not fit in the current region are served from memory on the CPU and sent as client side vertex arrays, and the regions are doubled in size before the next region is started. All allocations are served this way when built for the web, where buffers cannot be mapped, and on GL contexts which have neither GL 3.2 nor the ARB_sync extension. Which one applies is checked on the first allocation.
+     *
+     *  The Renderer2D owns one StreamBuffer, which drawables reach through DrawList::addStreamedVertexAttribute and DrawList::addTransientVertexAttribute.
+     ***
+     *  @class StreamBuffer::Allocation
+     *  @brief Space for vertex data valid until the end of the current region.
+     *
+     *  mData points to where the data should be written. If mBuffer is not 0, the space is in that GL buffer at mOffset bytes, and mData is mapped memory which must only be written to. Otherwise mData is memory on the CPU to use as a client side vertex array.
+     ***
+     *  @fn StreamBuffer::StreamBuffer(size_t regionFloatAmount = 262144, uint32_t regionAmount = 3)
+     *  @brief Construct a StreamBuffer. The GL buffer is created on the first allocation.
+     *  @param regionFloatAmount Amount of floats in each region.
+     *  @param regionAmount Amount of regions. At least as many as the renders the GPU may lag behind.
+     ***
+     *  @fn StreamBuffer::Allocation StreamBuffer::allocate(size_t floatAmount)
+     *  @brief Get space for vertex data in the current region.
+     *
+     *  Requires a valid GL context. Waits for the GPU if it has not finished drawing from the region yet, which only happens if it lags more regions behind than there are. Assert/undefined behavior if the amount is 0.
+     *  @param floatAmount Amount of floats.
+     *  @return The allocated space.
+     ***
+     *  @fn void StreamBuffer::unmap()
+     *  @brief Unmap the current region so that it can be drawn from. Must be called before drawing.
+     ***
+     *  @fn void StreamBuffer::endRegion()
+     *  @brief Fence the current region and move on to the next one. Must be called after all draws using the region have been issued.
+     *
+     *  All allocations from the region become invalid.
+     ***
+     *  @fn size_t StreamBuffer::getRegionFloatAmount() const
+     *  @brief Get the amount of floats in each region.
+     *  @return Amount of floats.
+     ***
+     *  @fn uint32_t StreamBuffer::getRegionAmount() const
+     *  @brief Get the amount of regions.
+     *  @return Amount of regions.
+     ***
+     *  @fn StreamBuffer::~StreamBuffer()
+     *  @brief Destructor. Deletes the GL buffer and fences.
+     ***/
+}
@@ -42,6 +42,7 @@ namespace fea
         void newLine(float distance, float indentation = 0.0f);
         void newLine();
         virtual std::vector<RenderEntity> getRenderInfo() const override;
+        virtual void queueRenderInfo(DrawList& drawList) const override;
         void clear();
         glm::vec2 getSize();
     private:
@@ -22,6 +22,7 @@ namespace fea
             void clear();
             bool isEmpty() const;
             virtual std::vector<RenderEntity> getRenderInfo() const override;
+            virtual void queueRenderInfo(DrawList& drawList) const override;
             void setOriginalOrigin(const glm::vec2& origin);
             void multiplyOrigin(const glm::vec2& mult);
         private:
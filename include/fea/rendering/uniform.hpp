@@ -20,6 +20,7 @@ namespace fea
         Uniform(const std::string& name, UniformType t, glm::mat4x4 val);
         Uniform(const std::string& name, UniformType t, GLuint val);
         Uniform(const Uniform& other);
+        static uint32_t getFloatAmount(UniformType type);
 
         std::string mName;
         UniformType mType;
@@ -95,6 +96,11 @@ namespace fea
      *  @brief Construct a uniform from another uniform.
      *  @param other Uniform to copy.
      ***
+     *  @fn static uint32_t Uniform::getFloatAmount(UniformType type)
+     *  @brief Get the amount of floats needed to store a value of a uniform type. Textures count as one.
+     *  @param type Type of the uniform.
+     *  @return Amount of floats, or 0 for NO_TYPE.
+     ***
      *  @var Uniform::mName
      *  @brief name of the uniform.
      ***
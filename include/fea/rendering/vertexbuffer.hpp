@@ -0,0 +1,88 @@
+#pragma once
+#include <fea/config.hpp>
+#include <fea/rendering/opengl.hpp>
+#include <vector>
+#include <stddef.h>
+
+namespace fea
+{
+    class FEA_API VertexBuffer
+    {
+        public:
+            VertexBuffer();
+            VertexBuffer(const VertexBuffer& other);
+            VertexBuffer& operator=(const VertexBuffer& other);
+            VertexBuffer(VertexBuffer&& other);
+            VertexBuffer& operator=(VertexBuffer&& other);
+            void markDirty(size_t start, size_t end);
+            void markDirty();
+            GLuint update(const std::vector<float>& data);
+            GLuint getId() const;
+            void destroy();
+            ~VertexBuffer();
+        private:
+            GLuint mId;
+            size_t mCapacity;
+            size_t mSize;
+            size_t mDirtyStart;
+            size_t mDirtyEnd;
+    };
+    /** @addtogroup Render2D
+     *@{
+     *  @class VertexBuffer
+     *@}
+     ***
+     *  @class VertexBuffer
+     *  @brief GL buffer object keeping a copy of an array of vertex data on the GPU.
+     *
+     *  The buffer keeps track of which range of the data has changed since it was last uploaded, and only sends that range when updated. Changes to the data must be reported using VertexBuffer::markDirty, except for data added to the end of the array, which is detected from the size.
+     *
+     *  The GL buffer is created the first time the buffer is updated, so a VertexBuffer can be constructed before there is a GL context. Copying a VertexBuffer does not share the GL buffer, the copy creates its own and uploads all of the data on its first update.
+     ***
+     *  @fn VertexBuffer::VertexBuffer()
+     *  @brief Construct a VertexBuffer without a GL buffer.
+     ***
+     *  @fn VertexBuffer::VertexBuffer(const VertexBuffer& other)
+     *  @brief Construct a VertexBuffer which will upload all data on its first update.
+     *  @param other Buffer to copy. Its GL buffer is not shared.
+     ***
+     *  @fn VertexBuffer& VertexBuffer::operator=(const VertexBuffer& other)
+     *  @brief Mark all data as changed, keeping the current GL buffer.
+     *  @param other Buffer to copy. Its GL buffer is not shared.
+     *  @return Reference to this buffer.
+     ***
+     *  @fn VertexBuffer::VertexBuffer(VertexBuffer&& other)
+     *  @brief Move a VertexBuffer, taking over its GL buffer.
+     *  @param other Buffer to move.
+     ***
+     *  @fn VertexBuffer& VertexBuffer::operator=(VertexBuffer&& other)
+     *  @brief Swap GL buffers with another VertexBuffer.
+     *  @param other Buffer to move.
+     *  @return Reference to this buffer.
+     ***
+     *  @fn void VertexBuffer::markDirty(size_t start, size_t end)
+     *  @brief Report that a range of the data has changed.
+     *  @param start Index of the first changed float.
+     *  @param end Index after the last changed float.
+     ***
+     *  @fn void VertexBuffer::markDirty()
+     *  @brief Report that all of the data has changed.
+     ***
+     *  @fn GLuint VertexBuffer::update(const std::vector<float>& data)
+     *  @brief Upload the changed parts of the data, creating the GL buffer if needed.
+     *
+     *  Requires a valid GL context. Does nothing if nothing has changed since the last update.
+     *  @param data The data. Must be the same array every time, apart from the reported changes.
+     *  @return ID of the GL buffer.
+     ***
+     *  @fn GLuint VertexBuffer::getId() const
+     *  @brief Get the ID of the GL buffer.
+     *  @return ID of the buffer, or 0 if it has not been created.
+     ***
+     *  @fn void VertexBuffer::destroy()
+     *  @brief Delete the GL buffer. It will be created again on the next update.
+     ***
+     *  @fn VertexBuffer::~VertexBuffer()
+     *  @brief Destructor. Deletes the GL buffer.
+     ***/
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include <cmath>
 #include <set>
 #include <sstream>
 #include <unordered_map>
@@ -19,6 +20,7 @@ namespace fea
     template<uint32_t Dimensions, uint32_t Depth, bool StaticAllocation>
     class LooseNTree
     {
+        public:
             class Vector
             {
                 public:
@@ -37,6 +39,7 @@ namespace fea
                     float mCoords[Dimensions];
             };
 
+        private:
             struct Node
             {
                 Node();
@@ -86,6 +89,7 @@ namespace fea
     /** @addtogroup Util
      *@{
      *  @typedef LooseNTree::TreeEntry
+     *  @class LooseNTree::Vector
      *  @typedef QuadTree
      *  @typedef Octree
      *  @class LooseNTree
@@ -94,6 +98,11 @@ namespace fea
      *  @typedef LooseNTree::TreeEntry
      *  @brief An entry in the tree.
      ***
+     *  @class LooseNTree::Vector
+     *  @brief Position or size in the space of the tree, with one coordinate per dimension.
+     *
+     *  Can be constructed from an initializer list such as {x, y}, and the coordinates can be accessed using operator[].
+     ***
      *  @typedef QuadTree
      *  @brief Tree structure for keeping track of possibly overlapping objects in 2-dimensional space.
      ***
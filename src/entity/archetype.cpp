@@ -0,0 +1,220 @@
+#include <fea/entity/archetype.hpp>
+#include <algorithm>
+
+namespace fea
+{
+    Archetype::Archetype(const std::vector<uint32_t>& attributes, std::vector<std::unique_ptr<AttributeColumnBase>> columns) :
+        mAttributes(attributes),
+        mColumns(std::move(columns)),
+        mChangeVersions(mColumns.size()),
+        mLatestChanges(mColumns.size(), 0)
+    {
+        FEA_ASSERT(mAttributes.size() == mColumns.size(), "Trying to create an archetype with " + std::to_string(mAttributes.size()) + " attributes but " + std::to_string(mColumns.size()) + " columns!");
+        FEA_ASSERT(std::is_sorted(mAttributes.begin(), mAttributes.end()), "Trying to create an archetype with an unsorted attribute list!");
+
+        if(!mAttributes.empty())
+            mColumnIndices.resize(mAttributes.back() + 1, -1);
+
+        for(size_t i = 0; i < mAttributes.size(); i++)
+            mColumnIndices[mAttributes[i]] = static_cast<int32_t>(i);
+    }
+
+    const std::vector<uint32_t>& Archetype::getAttributes() const
+    {
+        return mAttributes;
+    }
+
+    bool Archetype::hasAttribute(uint32_t attribute) const
+    {
+        return attribute < mColumnIndices.size() && mColumnIndices[attribute] != -1;
+    }
+
+    AttributeColumnBase& Archetype::getColumn(uint32_t attribute)
+    {
+        FEA_ASSERT(hasAttribute(attribute), "Trying to access the column of attribute index " + std::to_string(attribute) + " in an archetype which does not have it!");
+        return *mColumns[mColumnIndices[attribute]];
+    }
+
+    const AttributeColumnBase& Archetype::getColumn(uint32_t attribute) const
+    {
+        FEA_ASSERT(hasAttribute(attribute), "Trying to access the column of attribute index " + std::to_string(attribute) + " in an archetype which does not have it!");
+        return *mColumns[mColumnIndices[attribute]];
+    }
+
+    void Archetype::replaceColumn(uint32_t attribute, std::unique_ptr<AttributeColumnBase> column)
+    {
+        FEA_ASSERT(hasAttribute(attribute), "Trying to replace the column of attribute index " + std::to_string(attribute) + " in an archetype which does not have it!");
+        FEA_ASSERT(column->size() == mEntities.size(), "Trying to replace a column of " + std::to_string(mEntities.size()) + " rows with one of " + std::to_string(column->size()) + " rows!");
+        mColumns[mColumnIndices[attribute]] = std::move(column);
+    }
+
+    uint32_t Archetype::addRow(uint32_t entityId)
+    {
+        for(auto& column : mColumns)
+            column->pushUninitialized();
+
+        for(auto& versions : mChangeVersions)
+            versions.push_back(0);
+
+        mEntities.push_back(entityId);
+        return static_cast<uint32_t>(mEntities.size() - 1);
+    }
+
+    void Archetype::reserve(uint32_t rows)
+    {
+        for(auto& column : mColumns)
+            column->reserve(rows);
+
+        for(auto& versions : mChangeVersions)
+        {
+            if(rows > versions.capacity())
+                versions.reserve(std::max(static_cast<size_t>(rows), versions.capacity() * 2));
+        }
+
+        if(rows > mEntities.capacity())
+            mEntities.reserve(std::max(static_cast<size_t>(rows), mEntities.capacity() * 2));
+    }
+
+    uint32_t Archetype::removeRow(uint32_t row)
+    {
+        for(auto& column : mColumns)
+            column->swapRemove(row);
+
+        for(auto& versions : mChangeVersions)
+        {
+            versions[row] = versions.back();
+            versions.pop_back();
+        }
+
+        mEntities[row] = mEntities.back();
+        mEntities.pop_back();
+
+        //the entity which was moved into the removed row, if any
+        return row < mEntities.size() ? mEntities[row] : static_cast<uint32_t>(-1);
+    }
+
+    uint32_t Archetype::moveRowTo(uint32_t row, Archetype& target)
+    {
+        for(size_t i = 0; i < target.mAttributes.size(); i++)
+        {
+            uint32_t attribute = target.mAttributes[i];
+
+            if(hasAttribute(attribute))
+            {
+                //moving does not change the value, so it keeps the version it had
+                uint32_t column = mColumnIndices[attribute];
+                uint32_t version = mChangeVersions[column][row];
+                mColumns[column]->moveRowTo(row, *target.mColumns[i]);
+                target.mChangeVersions[i].push_back(version);
+                target.mLatestChanges[i] = std::max(target.mLatestChanges[i], version);
+            }
+            else
+            {
+                target.mColumns[i]->pushUninitialized();
+                target.mChangeVersions[i].push_back(0);
+            }
+        }
+
+        target.mEntities.push_back(mEntities[row]);
+        return static_cast<uint32_t>(target.mEntities.size() - 1);
+    }
+
+    void Archetype::swapRows(uint32_t first, uint32_t second)
+    {
+        //reordering does not change any value, so the change versions move along with the rows
+        for(auto& column : mColumns)
+            column->swapRows(first, second);
+
+        for(auto& versions : mChangeVersions)
+            std::swap(versions[first], versions[second]);
+
+        std::swap(mEntities[first], mEntities[second]);
+    }
+
+    void Archetype::permuteRows(const std::vector<uint32_t>& order)
+    {
+        FEA_ASSERT(order.size() == mEntities.size(), "Trying to reorder an archetype of size " + std::to_string(mEntities.size()) + " using an order of " + std::to_string(order.size()) + " rows!");
+
+        for(auto& column : mColumns)
+            column->permute(order);
+
+        for(auto& versions : mChangeVersions)
+        {
+            std::vector<uint32_t> reordered(versions.size());
+            reordered.reserve(versions.capacity());
+
+            for(size_t row = 0; row < order.size(); row++)
+                reordered[row] = versions[order[row]];
+
+            versions.swap(reordered);
+        }
+
+        std::vector<uint32_t> entities(mEntities.size());
+        entities.reserve(mEntities.capacity());
+
+        for(size_t row = 0; row < order.size(); row++)
+            entities[row] = mEntities[order[row]];
+
+        mEntities.swap(entities);
+    }
+
+    void Archetype::markChanged(uint32_t attribute, uint32_t firstRow, uint32_t amount, uint32_t version)
+    {
+        uint32_t column = mColumnIndices[attribute];
+        std::vector<uint32_t>& versions = mChangeVersions[column];
+        FEA_ASSERT(firstRow + amount <= versions.size(), "Trying to mark rows " + std::to_string(firstRow) + " to " + std::to_string(firstRow + amount) + " as changed in an archetype of size " + std::to_string(versions.size()) + "!");
+
+        std::fill(versions.begin() + firstRow, versions.begin() + firstRow + amount, version);
+        mLatestChanges[column] = std::max(mLatestChanges[column], version);
+    }
+
+    uint32_t Archetype::getChangeVersion(uint32_t attribute, uint32_t row) const
+    {
+        return mChangeVersions[mColumnIndices[attribute]][row];
+    }
+
+    uint32_t Archetype::getLatestChange(uint32_t attribute) const
+    {
+        return mLatestChanges[mColumnIndices[attribute]];
+    }
+
+    void Archetype::collectMemoryStats(std::vector<AttributeMemoryStats>& attributes, EntityMemoryStats& stats) const
+    {
+        for(size_t i = 0; i < mColumns.size(); i++)
+        {
+            AttributeMemoryStats& attribute = attributes[mAttributes[i]];
+            mColumns[i]->collectMemoryStats(attribute);
+            attribute.mArchetypeCount++;
+
+            //change versions are kept per value, so they count towards the attribute
+            attribute.mUsedBytes += mChangeVersions[i].size() * sizeof(uint32_t);
+            attribute.mReservedBytes += mChangeVersions[i].capacity() * sizeof(uint32_t);
+            attribute.mAllocationCount += mChangeVersions[i].capacity() > 0 ? 1 : 0;
+        }
+
+        stats.mUsedBytes += mEntities.size() * sizeof(uint32_t);
+        stats.mReservedBytes += mEntities.capacity() * sizeof(uint32_t);
+        stats.mAllocationCount += mEntities.capacity() > 0 ? 1 : 0;
+    }
+
+    const std::vector<uint32_t>& Archetype::getEntities() const
+    {
+        return mEntities;
+    }
+
+    uint32_t Archetype::size() const
+    {
+        return static_cast<uint32_t>(mEntities.size());
+    }
+
+    void Archetype::clear()
+    {
+        for(auto& column : mColumns)
+            column->clear();
+
+        for(auto& versions : mChangeVersions)
+            versions.clear();
+
+        mEntities.clear();
+    }
+}
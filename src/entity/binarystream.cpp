@@ -0,0 +1,69 @@
+#include <fea/entity/binarystream.hpp>
+
+namespace fea
+{
+    BinaryWriter::BinaryWriter(std::vector<uint8_t>& buffer) :
+        mBuffer(buffer)
+    {
+    }
+
+    void BinaryWriter::writeBytes(const void* data, size_t size)
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        mBuffer.insert(mBuffer.end(), bytes, bytes + size);
+    }
+
+    void BinaryWriter::writeString(const std::string& string)
+    {
+        write(static_cast<uint32_t>(string.size()));
+        writeBytes(string.data(), string.size());
+    }
+
+    size_t BinaryWriter::size() const
+    {
+        return mBuffer.size();
+    }
+
+    BinaryReader::BinaryReader(const uint8_t* data, size_t size) :
+        mCurrent(data),
+        mEnd(data + size),
+        mValid(data != nullptr || size == 0)
+    {
+    }
+
+    const uint8_t* BinaryReader::readBytes(size_t size)
+    {
+        if(!mValid || static_cast<size_t>(mEnd - mCurrent) < size)
+        {
+            mValid = false;
+            return nullptr;
+        }
+
+        const uint8_t* data = mCurrent;
+        mCurrent += size;
+        return data;
+    }
+
+    std::string BinaryReader::readString()
+    {
+        uint32_t length = read<uint32_t>();
+        const uint8_t* data = readBytes(length);
+
+        return data ? std::string(reinterpret_cast<const char*>(data), length) : std::string();
+    }
+
+    bool BinaryReader::isValid() const
+    {
+        return mValid;
+    }
+
+    bool BinaryReader::isAtEnd() const
+    {
+        return mCurrent == mEnd;
+    }
+
+    void BinaryReader::invalidate()
+    {
+        mValid = false;
+    }
+}
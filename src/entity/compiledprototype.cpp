@@ -0,0 +1,167 @@
+#include <fea/entity/compiledprototype.hpp>
+#include <algorithm>
+#include <utility>
+
+namespace fea
+{
+    CompiledPrototype::CompiledPrototype() :
+        mData(nullptr),
+        mSize(0),
+        mCapacity(0),
+        mArchetype(static_cast<uint32_t>(-1))
+    {
+    }
+
+    CompiledPrototype::CompiledPrototype(const CompiledPrototype& other) :
+        mAttributes(other.mAttributes),
+        mValues(other.mValues),
+        mData(nullptr),
+        mSize(other.mSize),
+        mCapacity(0),
+        mArchetype(other.mArchetype)
+    {
+        if(mSize > 0)
+        {
+            mData = static_cast<uint8_t*>(::operator new(mSize));
+            mCapacity = mSize;
+        }
+
+        for(const Value& value : mValues)
+            value.mOperations->mCopy(mData + value.mOffset, other.mData + value.mOffset);
+    }
+
+    CompiledPrototype::CompiledPrototype(CompiledPrototype&& other) :
+        mAttributes(std::move(other.mAttributes)),
+        mValues(std::move(other.mValues)),
+        mData(other.mData),
+        mSize(other.mSize),
+        mCapacity(other.mCapacity),
+        mArchetype(other.mArchetype)
+    {
+        other.mValues.clear();
+        other.mData = nullptr;
+        other.mSize = 0;
+        other.mCapacity = 0;
+    }
+
+    CompiledPrototype& CompiledPrototype::operator=(CompiledPrototype other)
+    {
+        std::swap(mAttributes, other.mAttributes);
+        std::swap(mValues, other.mValues);
+        std::swap(mData, other.mData);
+        std::swap(mSize, other.mSize);
+        std::swap(mCapacity, other.mCapacity);
+        std::swap(mArchetype, other.mArchetype);
+        return *this;
+    }
+
+    void CompiledPrototype::addAttribute(uint32_t attribute)
+    {
+        auto position = std::lower_bound(mAttributes.begin(), mAttributes.end(), attribute);
+
+        if(position == mAttributes.end() || *position != attribute)
+        {
+            mAttributes.insert(position, attribute);
+            mArchetype = static_cast<uint32_t>(-1);
+        }
+    }
+
+    void CompiledPrototype::clearValue(uint32_t attribute)
+    {
+        auto value = std::lower_bound(mValues.begin(), mValues.end(), attribute, [] (const Value& a, uint32_t b) { return a.mAttribute < b; });
+
+        if(value != mValues.end() && value->mAttribute == attribute)
+        {
+            //the space stays unused until the prototype is copied
+            value->mOperations->mDestroy(mData + value->mOffset);
+            mValues.erase(value);
+        }
+    }
+
+    void CompiledPrototype::merge(const CompiledPrototype& other)
+    {
+        for(uint32_t attribute : other.mAttributes)
+            addAttribute(attribute);
+
+        for(const Value& value : other.mValues)
+            insertValue(value.mAttribute, value.mOperations, other.mData + value.mOffset);
+    }
+
+    const std::vector<uint32_t>& CompiledPrototype::getAttributes() const
+    {
+        return mAttributes;
+    }
+
+    const std::vector<CompiledPrototype::Value>& CompiledPrototype::getValues() const
+    {
+        return mValues;
+    }
+
+    const void* CompiledPrototype::getValueData(const Value& value) const
+    {
+        return mData + value.mOffset;
+    }
+
+    void CompiledPrototype::setArchetype(uint32_t archetype)
+    {
+        mArchetype = archetype;
+    }
+
+    uint32_t CompiledPrototype::getArchetype() const
+    {
+        return mArchetype;
+    }
+
+    CompiledPrototype::~CompiledPrototype()
+    {
+        for(const Value& value : mValues)
+            value.mOperations->mDestroy(mData + value.mOffset);
+
+        ::operator delete(mData);
+    }
+
+    void CompiledPrototype::insertValue(uint32_t attribute, const ValueOperations* operations, const void* source)
+    {
+        auto existing = std::lower_bound(mValues.begin(), mValues.end(), attribute, [] (const Value& a, uint32_t b) { return a.mAttribute < b; });
+
+        if(existing != mValues.end() && existing->mAttribute == attribute)
+        {
+            FEA_ASSERT(existing->mOperations == operations, "Trying to replace the prototype value of attribute index " + std::to_string(attribute) + " with a value of another type!");
+            existing->mOperations->mDestroy(mData + existing->mOffset);
+            operations->mCopy(mData + existing->mOffset, source);
+            return;
+        }
+
+        size_t position = existing - mValues.begin();
+        uint32_t offset = allocate(operations->mSize, operations->mAlignment);
+        operations->mCopy(mData + offset, source);
+        mValues.insert(mValues.begin() + position, Value{attribute, offset, operations});
+    }
+
+    uint32_t CompiledPrototype::allocate(uint32_t size, uint32_t alignment)
+    {
+        uint32_t offset = (mSize + alignment - 1) / alignment * alignment;
+
+        if(offset + size > mCapacity)
+            reallocate(std::max(offset + size, mCapacity * 2));
+
+        mSize = offset + size;
+        return offset;
+    }
+
+    void CompiledPrototype::reallocate(uint32_t capacity)
+    {
+        uint8_t* newData = static_cast<uint8_t*>(::operator new(capacity));
+
+        //values are not necessarily trivially copyable so they are copied one by one
+        for(const Value& value : mValues)
+        {
+            value.mOperations->mCopy(newData + value.mOffset, mData + value.mOffset);
+            value.mOperations->mDestroy(mData + value.mOffset);
+        }
+
+        ::operator delete(mData);
+        mData = newData;
+        mCapacity = capacity;
+    }
+}
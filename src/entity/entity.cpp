@@ -11,6 +11,16 @@ namespace fea
         return mEntityManager.hasAttribute(mId, attribute);
     }
     
+    void Entity::addAttribute(const std::string& attribute) const
+    {
+        mEntityManager.addAttribute(mId, attribute);
+    }
+
+    void Entity::removeAttribute(const std::string& attribute) const
+    {
+        mEntityManager.removeAttribute(mId, attribute);
+    }
+    
     EntityId Entity::getId() const
     {
         return mId;
@@ -0,0 +1,125 @@
+#include <fea/entity/entitycommandbuffer.hpp>
+
+namespace fea
+{
+    DeferredEntity EntityCommandBuffer::createEntity(const std::set<std::string>& attributes)
+    {
+        //handles from the previous playback are dropped once new creations are recorded
+        if(mCreations.empty())
+            mCreated.clear();
+
+        auto group = mGroupIndices.find(attributes);
+
+        if(group == mGroupIndices.end())
+        {
+            group = mGroupIndices.emplace(attributes, static_cast<uint32_t>(mGroupAttributes.size())).first;
+            mGroupAttributes.push_back(&group->first);
+        }
+
+        mCreations.push_back(group->second);
+        return DeferredEntity(static_cast<uint32_t>(mCreations.size() - 1));
+    }
+
+    void EntityCommandBuffer::removeEntity(EntityHandle handle)
+    {
+        mRemovals.push_back(handle);
+    }
+
+    EntityHandle EntityCommandBuffer::getCreatedEntity(DeferredEntity entity) const
+    {
+        FEA_ASSERT(entity.mIndex < mCreated.size(), "Trying to get the handle of a deferred entity which has not been created!");
+        return mCreated[entity.mIndex];
+    }
+
+    bool EntityCommandBuffer::isEmpty() const
+    {
+        if(!mCreations.empty() || !mRemovals.empty())
+            return false;
+
+        for(const auto& writes : mWrites)
+        {
+            if(writes && !writes->isEmpty())
+                return false;
+        }
+
+        return true;
+    }
+
+    void EntityCommandBuffer::clear()
+    {
+        clearCommands();
+        mCreated.clear();
+    }
+
+    void EntityCommandBuffer::playbackCreations(EntityStorage& storage)
+    {
+        mCreated.assign(mCreations.size(), EntityHandle());
+
+        std::vector<uint32_t> groupSizes(mGroupAttributes.size(), 0);
+
+        for(uint32_t group : mCreations)
+            groupSizes[group]++;
+
+        //every group is created in one go so that its entities end up next to each other in storage
+        std::vector<std::vector<EntityHandle>> groupHandles(mGroupAttributes.size());
+
+        for(uint32_t group = 0; group < mGroupAttributes.size(); group++)
+            groupHandles[group] = storage.addEntities(*mGroupAttributes[group], groupSizes[group]);
+
+        std::vector<uint32_t> groupPositions(mGroupAttributes.size(), 0);
+
+        for(uint32_t i = 0; i < mCreations.size(); i++)
+        {
+            uint32_t group = mCreations[i];
+            mCreated[i] = groupHandles[group][groupPositions[group]++];
+        }
+    }
+
+    void EntityCommandBuffer::playbackWrites(EntityStorage& storage)
+    {
+        for(auto& writes : mWrites)
+        {
+            if(writes)
+                writes->playback(storage, mCreated);
+        }
+    }
+
+    std::vector<uint32_t> EntityCommandBuffer::collectRemovals(const EntityStorage& storage) const
+    {
+        std::vector<std::pair<uint64_t, uint32_t>> removals;
+        removals.reserve(mRemovals.size());
+
+        for(EntityHandle handle : mRemovals)
+        {
+            if(storage.isValid(handle))
+                removals.emplace_back(storage.getStorageOrder(handle.mIndex), handle.mIndex);
+        }
+
+        //removing the highest rows first means no entity pending removal is moved by an earlier removal
+        std::sort(removals.begin(), removals.end(), [] (const std::pair<uint64_t, uint32_t>& a, const std::pair<uint64_t, uint32_t>& b) { return a.first > b.first; });
+        removals.erase(std::unique(removals.begin(), removals.end()), removals.end());
+
+        std::vector<uint32_t> ids;
+        ids.reserve(removals.size());
+
+        for(const auto& removal : removals)
+            ids.push_back(removal.second);
+
+        return ids;
+    }
+
+    void EntityCommandBuffer::clearCommands()
+    {
+        mGroupIndices.clear();
+        mGroupAttributes.clear();
+        mCreations.clear();
+        mRemovals.clear();
+
+        //the typed write lists are kept so that their memory is reused by the next recording
+        for(auto& writes : mWrites)
+        {
+            if(writes)
+                writes->clear();
+        }
+    }
+}
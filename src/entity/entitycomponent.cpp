@@ -1,7 +1,13 @@
 #include <fea/entity/entitycomponent.hpp>
+#include <algorithm>
 
 namespace fea
 {
+    EntityComponent::EntityComponent() :
+        mManager(nullptr)
+    {
+    }
+
     void EntityComponent::entityCreated(WeakEntityPtr entity)
     {
         if(keepEntity(entity))
@@ -33,12 +39,121 @@ namespace fea
     {
     }
 
+    void EntityComponent::memberAdded(EntityId id)
+    {
+    }
+
+    void EntityComponent::memberRemoved(EntityId id)
+    {
+    }
+
     const std::unordered_map<EntityId, WeakEntityPtr>& EntityComponent::getEntities() const
     {
         return mEntities;
     }
     
+    void EntityComponent::update(SystemScheduler& scheduler)
+    {
+    }
+
+    const std::vector<uint32_t>& EntityComponent::getReadAttributes() const
+    {
+        return mReadAttributes;
+    }
+
+    const std::vector<uint32_t>& EntityComponent::getWrittenAttributes() const
+    {
+        return mWrittenAttributes;
+    }
+
+    bool EntityComponent::conflictsWith(const EntityComponent& other) const
+    {
+        bool undeclared = mReadAttributes.empty() && mWrittenAttributes.empty();
+        bool otherUndeclared = other.mReadAttributes.empty() && other.mWrittenAttributes.empty();
+
+        if(undeclared || otherUndeclared)
+            return true;
+
+        for(uint32_t attribute : mWrittenAttributes)
+        {
+            if(std::binary_search(other.mWrittenAttributes.begin(), other.mWrittenAttributes.end(), attribute) ||
+               std::binary_search(other.mReadAttributes.begin(), other.mReadAttributes.end(), attribute))
+                return true;
+        }
+
+        for(uint32_t attribute : other.mWrittenAttributes)
+        {
+            if(std::binary_search(mReadAttributes.begin(), mReadAttributes.end(), attribute))
+                return true;
+        }
+
+        return false;
+    }
+    
+    const std::vector<uint32_t>& EntityComponent::getSignature() const
+    {
+        return mSignature;
+    }
+
+    bool EntityComponent::matchesSignature(const std::vector<uint32_t>& attributes) const
+    {
+        return std::includes(attributes.begin(), attributes.end(), mSignature.begin(), mSignature.end());
+    }
+
+    const std::vector<EntityId>& EntityComponent::getMembers() const
+    {
+        return mMembers;
+    }
+
+    bool EntityComponent::isMember(EntityId id) const
+    {
+        return id < mMemberIndices.size() && mMemberIndices[id] != static_cast<uint32_t>(-1);
+    }
+    
     EntityComponent::~EntityComponent()
     {
+        if(mManager)
+            mManager->removeComponent(*this);
+    }
+
+    void EntityComponent::addAccess(std::vector<uint32_t>& accessList, uint32_t attribute)
+    {
+        auto position = std::lower_bound(accessList.begin(), accessList.end(), attribute);
+
+        if(position == accessList.end() || *position != attribute)
+            accessList.insert(position, attribute);
+    }
+
+    void EntityComponent::addMember(EntityId id)
+    {
+        if(id >= mMemberIndices.size())
+            mMemberIndices.resize(id + 1, static_cast<uint32_t>(-1));
+
+        mMemberIndices[id] = static_cast<uint32_t>(mMembers.size());
+        mMembers.push_back(id);
+        memberAdded(id);
+    }
+
+    void EntityComponent::removeMember(EntityId id)
+    {
+        uint32_t index = mMemberIndices[id];
+        EntityId last = mMembers.back();
+
+        mMembers[index] = last;
+        mMemberIndices[last] = index;
+        mMembers.pop_back();
+        mMemberIndices[id] = static_cast<uint32_t>(-1);
+        memberRemoved(id);
+    }
+
+    void EntityComponent::clearMembers()
+    {
+        //moved out first so that the component looks empty from within memberRemoved, both to getMembers and isMember
+        std::vector<EntityId> members;
+        members.swap(mMembers);
+        mMemberIndices.clear();
+
+        for(EntityId id : members)
+            memberRemoved(id);
     }
 }
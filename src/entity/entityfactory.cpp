@@ -1,14 +1,8 @@
 #include <fea/entity/entityfactory.hpp>
 #include <fea/entity/entity.hpp>
-#include <algorithm>
 
 namespace fea
 {
-    bool EntityFactory::Prototype::Value::operator<(const Value& other) const
-    {
-        return mKey < other.mKey;
-    }
-
     EntityFactory::EntityFactory(EntityManager& entityManager) : mManager(entityManager)
     {
     }
@@ -25,22 +19,12 @@ namespace fea
     {
         FEA_ASSERT(mPrototypes.find(name) == mPrototypes.end(), "Trying to add entity template '" + name + "' but there exists already such a template!");
 
-        Prototype prototype;
+        CompiledPrototype prototype;
 
         for(const auto& parentTemplate : entityTemplate.mInherits)
         {
             FEA_ASSERT(mPrototypes.find(parentTemplate) != mPrototypes.end(), "Trying to let entity template '" +name + "' inherit template called '" + parentTemplate + "' which has not been added!");
-            auto& parent = mPrototypes.at(parentTemplate);
-            
-            std::set<std::string> result;
-            std::set_union(parent.attributes.begin(), parent.attributes.end(), prototype.attributes.begin(), prototype.attributes.end(), std::inserter(result, result.begin()));
-
-            prototype.attributes = result;
-
-            std::set<Prototype::Value> result2;
-            std::set_union(parent.values.begin(), parent.values.end(), prototype.values.begin(), prototype.values.end(), std::inserter(result2, result2.begin()));
-
-            prototype.values = result2;
+            prototype.merge(mPrototypes.at(parentTemplate));
         }
 
         for(const auto& element : entityTemplate.mAttributes)
@@ -50,24 +34,17 @@ namespace fea
 
             FEA_ASSERT(mParsers.find(attribute) != mParsers.end(), "Trying to add a template with the attribute '" + attribute + "' which doesn't exist!");
 
-            if(prototype.attributes.find(attribute) == prototype.attributes.end())
-            {
-                prototype.attributes.insert(attribute);
-                if(arguments.size() > 0)
-                {
-                    prototype.values.insert({attribute, mParsers.at(attribute)(arguments)}); 
-                }
-            }
-            else
-            {
-                prototype.values.erase({attribute});
-                if(arguments.size() > 0)
-                {
-                    prototype.values.insert({attribute, mParsers.at(attribute)(arguments)}); 
-                }
-            }
+            mParsers.at(attribute)(prototype, arguments);
         }
 
+        addTemplate(name, std::move(prototype));
+    }
+
+    void EntityFactory::addTemplate(const std::string& name, CompiledPrototype prototype)
+    {
+        FEA_ASSERT(mPrototypes.find(name) == mPrototypes.end(), "Trying to add entity template '" + name + "' but there exists already such a template!");
+
+        mManager.resolvePrototype(prototype);
         mPrototypes.emplace(name, std::move(prototype));
     }
     
@@ -77,14 +54,58 @@ namespace fea
     }
 
     WeakEntityPtr EntityFactory::instantiate(const std::string& name)
+    {
+        return mManager.findEntity(mManager.createEntities(getPrototype(name), 1)[0]);
+    }
+
+    std::vector<EntityHandle> EntityFactory::instantiate(const std::string& name, uint32_t amount)
+    {
+        return mManager.createEntities(getPrototype(name), amount);
+    }
+
+    std::vector<EntityHandle> EntityFactory::instantiate(const std::string& name, uint32_t amount, const InstanceOverrides& overrides)
+    {
+        std::vector<EntityHandle> entities = instantiate(name, amount);
+        overrides.apply(mManager, entities);
+
+        return entities;
+    }
+
+    const CompiledPrototype& EntityFactory::getPrototype(const std::string& name) const
     {
         FEA_ASSERT(mPrototypes.find(name) != mPrototypes.end(), "Trying to instantiate entity template '" + name + "' but such a template does not exist!");
-        const Prototype& entityPrototype = mPrototypes.at(name);
-        EntityPtr entity = mManager.createEntity(entityPrototype.attributes).lock();
-        for(const auto& value : entityPrototype.values)
-            value.mSetter(entity);
+        return mPrototypes.at(name);
+    }
+
+    bool EntityFactory::hasAttribute(const std::string& attribute) const
+    {
+        return mParsers.find(attribute) != mParsers.end();
+    }
+
+    void EntityFactory::parseValue(CompiledPrototype& prototype, const std::string& attribute, const std::string& arguments) const
+    {
+        FEA_ASSERT(mParsers.find(attribute) != mParsers.end(), "Trying to parse a value of the attribute '" + attribute + "' which doesn't exist!");
+        mParsers.at(attribute)(prototype, arguments);
+    }
+
+    uint32_t EntityFactory::getRawValueSize(const std::string& attribute) const
+    {
+        FEA_ASSERT(mParsers.find(attribute) != mParsers.end(), "Trying to get the raw value size of the attribute '" + attribute + "' which doesn't exist!");
+        auto rawParser = mRawParsers.find(attribute);
+
+        return rawParser != mRawParsers.end() ? rawParser->second.mSize : 0;
+    }
 
-        return entity;
+    const std::string& EntityFactory::getRawValueType(const std::string& attribute) const
+    {
+        FEA_ASSERT(mRawParsers.find(attribute) != mRawParsers.end(), "Trying to get the raw value type of the attribute '" + attribute + "' which doesn't exist or can't be given as raw bytes!");
+        return mRawParsers.at(attribute).mType;
+    }
+
+    void EntityFactory::setRawValue(CompiledPrototype& prototype, const std::string& attribute, const void* data) const
+    {
+        FEA_ASSERT(mRawParsers.find(attribute) != mRawParsers.end(), "Trying to set a raw value of the attribute '" + attribute + "' which doesn't exist or can't be given as raw bytes!");
+        mRawParsers.at(attribute).mParse(prototype, data);
     }
 
     Parameters EntityFactory::splitByDelimeter(const std::string& in, char delimeter) const
@@ -1,5 +1,7 @@
 #include <fea/entity/entitymanager.hpp>
 #include <fea/entity/entity.hpp>
+#include <fea/entity/entitycomponent.hpp>
+#include <algorithm>
 #include <sstream>
 
 namespace fea
@@ -7,36 +9,111 @@ namespace fea
     WeakEntityPtr EntityManager::createEntity(const std::set<std::string>& attributes)
     {
         EntityId createdId = mStorage.addEntity(attributes);
-        EntityPtr created = std::make_shared<Entity>(createdId, *this);
-        mEntities.insert(std::pair<EntityId, EntityPtr>(createdId, created));
-        return WeakEntityPtr(created);
+        updateMemberships(createdId);
+        return findEntity(createdId);
+    }
+
+    EntityHandle EntityManager::createEntityHandle(const std::set<std::string>& attributes)
+    {
+        EntityId createdId = mStorage.addEntity(attributes);
+        updateMemberships(createdId);
+        return mStorage.getHandle(createdId);
+    }
+
+    std::vector<EntityHandle> EntityManager::createEntities(const std::set<std::string>& attributes, uint32_t amount)
+    {
+        std::vector<EntityHandle> handles = mStorage.addEntities(attributes, amount);
+        updateMemberships(handles);
+        return handles;
+    }
+
+    std::vector<EntityHandle> EntityManager::createEntities(const CompiledPrototype& prototype, uint32_t amount)
+    {
+        std::vector<EntityHandle> handles = mStorage.addEntities(prototype, amount);
+        updateMemberships(handles);
+        return handles;
+    }
+
+    void EntityManager::resolvePrototype(CompiledPrototype& prototype)
+    {
+        prototype.setArchetype(mStorage.findOrCreateArchetype(prototype.getAttributes()));
+    }
+
+    void EntityManager::reserveEntities(const std::set<std::string>& attributes, uint32_t amount)
+    {
+        mStorage.reserveEntities(attributes, amount);
     }
 
     WeakEntityPtr EntityManager::findEntity(EntityId id) const
     {
-        try
-        {
-            return mEntities.at(id);
-        }
-        catch(std::out_of_range e)
-        {
+        if(!mStorage.hasEntity(id))
             return WeakEntityPtr();
-        }
+
+        if(id >= mEntities.size())
+            mEntities.resize(id + 1);
+
+        //Entity instances are only allocated once someone asks for a pointer to them
+        if(!mEntities[id])
+            mEntities[id] = std::allocate_shared<Entity>(mEntityAllocator, id, const_cast<EntityManager&>(*this));
+
+        return mEntities[id];
+    }
+
+    WeakEntityPtr EntityManager::findEntity(EntityHandle handle) const
+    {
+        if(!mStorage.isValid(handle))
+            return WeakEntityPtr();
+
+        return findEntity(handle.mIndex);
+    }
+
+    EntityHandle EntityManager::getHandle(EntityId id) const
+    {
+        FEA_ASSERT(mStorage.hasEntity(id), "Trying to get a handle to entity ID '" + std::to_string(id) + "' but it doesn't exist!");
+        return mStorage.getHandle(id);
+    }
+
+    bool EntityManager::isValid(EntityHandle handle) const
+    {
+        return mStorage.isValid(handle);
     }
     
     void EntityManager::removeEntity(const EntityId id)
     {
-        FEA_ASSERT(mEntities.find(id) != mEntities.end(), "Trying to delete entity ID '" + std::to_string(id) + "' but it doesn't exist!");
+        FEA_ASSERT(mStorage.hasEntity(id), "Trying to delete entity ID '" + std::to_string(id) + "' but it doesn't exist!");
         mStorage.removeEntity(id);
-        mEntities.erase(id);
+        updateMemberships(id);
+
+        if(id < mEntities.size())
+            mEntities[id].reset();
+    }
+
+    void EntityManager::removeEntity(EntityHandle handle)
+    {
+        FEA_ASSERT(mStorage.isValid(handle), "Trying to delete entity ID '" + std::to_string(handle.mIndex) + "' through a handle which is no longer valid!");
+        removeEntity(handle.mIndex);
     }
     
     bool EntityManager::hasAttribute(const EntityId id, const std::string& attribute) const
     {
-        FEA_ASSERT(mEntities.find(id) != mEntities.end(), "Trying to check if entity ID '" + std::to_string(id) + "' has attribute '" + attribute + "' but that entity doesn't exist!");
+        FEA_ASSERT(mStorage.hasEntity(id), "Trying to check if entity ID '" + std::to_string(id) + "' has attribute '" + attribute + "' but that entity doesn't exist!");
         return mStorage.hasData(id, attribute);
     }
     
+    void EntityManager::addAttribute(const EntityId id, const std::string& attribute)
+    {
+        FEA_ASSERT(mStorage.hasEntity(id), "Trying to add attribute '" + attribute + "' to entity ID '" + std::to_string(id) + "' but that entity doesn't exist!");
+        mStorage.addAttribute(id, attribute);
+        updateMemberships(id);
+    }
+
+    void EntityManager::removeAttribute(const EntityId id, const std::string& attribute)
+    {
+        FEA_ASSERT(mStorage.hasEntity(id), "Trying to remove attribute '" + attribute + "' from entity ID '" + std::to_string(id) + "' but that entity doesn't exist!");
+        mStorage.removeAttribute(id, attribute);
+        updateMemberships(id);
+    }
+
     bool EntityManager::attributeIsValid(const std::string& attributeName) const
     {
         return mStorage.attributeIsValid(attributeName);
@@ -45,26 +122,204 @@ namespace fea
     EntitySet EntityManager::getAll() const
     {
         EntitySet all;
-        for(const auto& pair : mEntities)
-            all.insert(pair.second);
+        for(EntityId id = 0; id < mStorage.getIdLimit(); id++)
+        {
+            if(mStorage.hasEntity(id))
+                all.insert(findEntity(id));
+        }
         return all;
     }
 
+    uint32_t EntityManager::getChangeVersion() const
+    {
+        return mStorage.getChangeVersion();
+    }
+
+    uint32_t EntityManager::advanceChangeVersion()
+    {
+        return mStorage.advanceChangeVersion();
+    }
+
+    void EntityManager::addComponent(EntityComponent& component)
+    {
+        FEA_ASSERT(!component.getSignature().empty(), "Trying to add a component which does not require any attributes to an EntityManager!");
+        FEA_ASSERT(component.mManager == nullptr, "Trying to add a component which has already been added to an EntityManager!");
+        component.mManager = this;
+        mComponents.push_back(&component);
+
+        for(EntityId id = 0; id < mStorage.getIdLimit(); id++)
+        {
+            if(mStorage.hasEntity(id) && component.matchesSignature(mStorage.getArchetype(mStorage.getArchetypeIndex(id)).getAttributes()))
+                component.addMember(id);
+        }
+    }
+
+    void EntityManager::removeComponent(EntityComponent& component)
+    {
+        auto position = std::find(mComponents.begin(), mComponents.end(), &component);
+
+        if(position == mComponents.end())
+            return;
+
+        mComponents.erase(position);
+        component.mManager = nullptr;
+        component.clearMembers();
+    }
+
+    void EntityManager::playback(EntityCommandBuffer& commandBuffer)
+    {
+        commandBuffer.playbackCreations(mStorage);
+        updateMemberships(commandBuffer.mCreated);
+        commandBuffer.playbackWrites(mStorage);
+
+        for(EntityId id : commandBuffer.collectRemovals(mStorage))
+            removeEntity(id);
+
+        commandBuffer.clearCommands();
+    }
+
+    EntitySnapshot EntityManager::createSnapshot() const
+    {
+        return mStorage.createSnapshot(nullptr);
+    }
+
+    EntitySnapshot EntityManager::createSnapshot(const EntitySnapshot& base) const
+    {
+        return mStorage.createSnapshot(&base);
+    }
+
+    bool EntityManager::restoreSnapshot(const EntitySnapshot& snapshot)
+    {
+        return restoreSnapshot(snapshot, EntitySnapshot());
+    }
+
+    bool EntityManager::restoreSnapshot(const EntitySnapshot& snapshot, const EntitySnapshot& base)
+    {
+        //Entity instances survive only if the exact same entity exists after restoring
+        std::vector<EntityHandle> allocated;
+        for(EntityId id = 0; id < mEntities.size(); id++)
+        {
+            if(mEntities[id])
+                allocated.push_back(mStorage.getHandle(id));
+        }
+
+        //a failed restore leaves the storage unchanged
+        if(!mStorage.restoreSnapshot(snapshot, base.isEmpty() ? nullptr : &base))
+            return false;
+
+        rebuildMemberships();
+
+        for(EntityHandle handle : allocated)
+        {
+            if(!mStorage.isValid(handle))
+                mEntities[handle.mIndex].reset();
+        }
+
+        return true;
+    }
+
     void EntityManager::removeAll()
     {
-        while(mEntities.size() > 0)
-            removeEntity(mEntities.begin()->first);
+        for(EntityId id = 0; id < mStorage.getIdLimit(); id++)
+        {
+            if(mStorage.hasEntity(id))
+                removeEntity(id);
+        }
     }
 
     void EntityManager::clear()
     {
+        while(!mComponents.empty())
+            removeComponent(*mComponents.back());
+
         mEntities.clear();
         mStorage.clear();
     }
     
     std::unordered_set<std::string> EntityManager::getAttributes(EntityId id) const
     {
-        FEA_ASSERT(mEntities.find(id) != mEntities.end(), "Trying to get the attributes of entity entity ID '" + std::to_string(id) + "' but such an entity doesn't exist!");
+        FEA_ASSERT(mStorage.hasEntity(id), "Trying to get the attributes of entity entity ID '" + std::to_string(id) + "' but such an entity doesn't exist!");
         return mStorage.getAttributes(id);
     }
+
+    EntityMemoryStats EntityManager::getMemoryStats() const
+    {
+        EntityMemoryStats stats = mStorage.getMemoryStats();
+
+        for(const EntityPtr& entity : mEntities)
+        {
+            if(entity)
+                stats.mEntityInstanceCount++;
+        }
+
+        stats.mUsedBytes += mEntities.size() * sizeof(EntityPtr);
+        stats.mReservedBytes += mEntities.capacity() * sizeof(EntityPtr);
+        stats.mAllocationCount += mEntities.capacity() > 0 ? 1 : 0;
+
+        if(const FixedSizePool* pool = mEntityAllocator.getPool())
+        {
+            stats.mUsedBytes += stats.mEntityInstanceCount * pool->getBlockSize();
+            stats.mReservedBytes += pool->getAllocatedBytes();
+            stats.mAllocationCount += static_cast<uint32_t>(pool->getSlabCount());
+        }
+
+        return stats;
+    }
+
+    EntityManager::~EntityManager()
+    {
+        while(!mComponents.empty())
+            removeComponent(*mComponents.back());
+    }
+
+    void EntityManager::updateMemberships(EntityId id)
+    {
+        const std::vector<uint32_t>* attributes = mStorage.hasEntity(id) ? &mStorage.getArchetype(mStorage.getArchetypeIndex(id)).getAttributes() : nullptr;
+
+        for(EntityComponent* component : mComponents)
+        {
+            bool matches = attributes && component->matchesSignature(*attributes);
+
+            if(matches && !component->isMember(id))
+                component->addMember(id);
+            else if(!matches && component->isMember(id))
+                component->removeMember(id);
+        }
+    }
+
+    void EntityManager::updateMemberships(const std::vector<EntityHandle>& handles)
+    {
+        for(EntityComponent* component : mComponents)
+        {
+            //entities created together mostly share an archetype, so the signature is only checked when the archetype changes
+            uint32_t archetype = static_cast<uint32_t>(-1);
+            bool matches = false;
+
+            for(EntityHandle handle : handles)
+            {
+                uint32_t current = mStorage.getArchetypeIndex(handle.mIndex);
+
+                if(current != archetype)
+                {
+                    archetype = current;
+                    matches = component->matchesSignature(mStorage.getArchetype(archetype).getAttributes());
+                }
+
+                if(matches && !component->isMember(handle.mIndex))
+                    component->addMember(handle.mIndex);
+            }
+        }
+    }
+
+    void EntityManager::rebuildMemberships()
+    {
+        for(EntityComponent* component : mComponents)
+            component->clearMembers();
+
+        for(EntityId id = 0; id < mStorage.getIdLimit(); id++)
+        {
+            if(mStorage.hasEntity(id))
+                updateMemberships(id);
+        }
+    }
 }
@@ -0,0 +1,54 @@
+#include <fea/entity/entitymemorystats.hpp>
+#include <iomanip>
+
+namespace fea
+{
+    AttributeMemoryStats::AttributeMemoryStats() :
+        mValueCount(0),
+        mSlotCount(0),
+        mArchetypeCount(0),
+        mUsedBytes(0),
+        mReservedBytes(0),
+        mAllocationCount(0)
+    {
+    }
+
+    EntityMemoryStats::EntityMemoryStats() :
+        mEntityCount(0),
+        mIdLimit(0),
+        mFreeIdCount(0),
+        mArchetypeCount(0),
+        mQueryCount(0),
+        mEntityInstanceCount(0),
+        mUsedBytes(0),
+        mReservedBytes(0),
+        mAllocationCount(0),
+        mAttributeIndexLoadFactor(0.0f),
+        mSerializerLoadFactor(0.0f)
+    {
+    }
+
+    std::ostream& operator<<(std::ostream& stream, const EntityMemoryStats& stats)
+    {
+        stream << "entities: " << stats.mEntityCount << " (id limit " << stats.mIdLimit << ", free ids " << stats.mFreeIdCount << ", entity instances " << stats.mEntityInstanceCount << ")\n";
+        stream << "archetypes: " << stats.mArchetypeCount << ", queries: " << stats.mQueryCount << "\n";
+        stream << "total: " << stats.mUsedBytes << " bytes used, " << stats.mReservedBytes << " bytes reserved, " << stats.mAllocationCount << " allocations\n";
+        stream << "load factors: attribute names " << stats.mAttributeIndexLoadFactor << ", serializers " << stats.mSerializerLoadFactor << "\n";
+
+        stream << std::left << std::setw(24) << "attribute" << std::right << std::setw(10) << "values" << std::setw(10) << "slots" << std::setw(12) << "archetypes" << std::setw(14) << "used" << std::setw(14) << "reserved" << std::setw(13) << "allocations" << "  type\n";
+
+        for(const AttributeMemoryStats& attribute : stats.mAttributes)
+        {
+            stream << std::left << std::setw(24) << attribute.mName << std::right
+                   << std::setw(10) << attribute.mValueCount
+                   << std::setw(10) << attribute.mSlotCount
+                   << std::setw(12) << attribute.mArchetypeCount
+                   << std::setw(14) << attribute.mUsedBytes
+                   << std::setw(14) << attribute.mReservedBytes
+                   << std::setw(13) << attribute.mAllocationCount
+                   << "  " << attribute.mType << "\n";
+        }
+
+        return stream;
+    }
+}
@@ -0,0 +1,30 @@
+#include <fea/entity/entitysnapshot.hpp>
+#include <utility>
+
+namespace fea
+{
+    EntitySnapshot::EntitySnapshot()
+    {
+    }
+
+    EntitySnapshot::EntitySnapshot(std::vector<uint8_t> data) :
+        mData(std::move(data))
+    {
+    }
+
+    const std::vector<uint8_t>& EntitySnapshot::getData() const
+    {
+        return mData;
+    }
+
+    bool EntitySnapshot::isEmpty() const
+    {
+        return mData.empty();
+    }
+
+    bool EntitySnapshot::isDelta() const
+    {
+        //the flag directly follows the magic number and the version
+        return mData.size() > 8 && mData[8] != 0;
+    }
+}
@@ -1,84 +1,945 @@
 #include <string>
+#include <algorithm>
+#include <cstring>
 #include <fea/entity/entitystorage.hpp>
 
-namespace fea
+namespace
 {
-    EntityStorage::StorageEntity::StorageEntity(const std::set<std::string>& attributeList)
+    const uint8_t snapshotMagic[4] = {'F', 'E', 'A', 'S'};
+    const uint32_t snapshotVersion = 1;
+    //granularity of the byte ranges stored for changed sections in delta snapshots
+    const uint32_t snapshotDeltaBlock = 64;
+
+    enum SnapshotSectionKind : uint8_t { FULL_SECTION, UNCHANGED_SECTION, PATCHED_SECTION };
+
+    //block of bytes which a delta snapshot can store as the changes compared to the same block in the base snapshot
+    struct SnapshotSection
     {
-        for(const auto& attribute : attributeList)
-            attributeData.emplace(attribute, std::shared_ptr<void>());
-    }
+        uint8_t mKind;
+        const uint8_t* mData;
+        uint32_t mSize;
+        uint32_t mPatchCount;
+        uint32_t mPatchBytes;
+    };
+
+    struct SnapshotArchetype
+    {
+        std::vector<uint32_t> mAttributes;
+        SnapshotSection mEntities;
+        std::vector<SnapshotSection> mColumns;
+    };
 
-    bool EntityStorage::StorageEntity::hasData(const std::string& attribute) const
+    struct SnapshotLayout
     {
-        return attributeData.find(attribute) != attributeData.end();
+        bool mDelta;
+        std::vector<std::pair<std::string, std::string>> mAttributes;
+        SnapshotSection mLocations;
+        SnapshotSection mFreeIds;
+        std::vector<SnapshotArchetype> mArchetypes;
+    };
+
+    uint32_t readUint32(const uint8_t* data, uint32_t index)
+    {
+        uint32_t value;
+        std::memcpy(&value, data + index * sizeof(uint32_t), sizeof(uint32_t));
+        return value;
     }
-    
-    std::unordered_set<std::string> EntityStorage::StorageEntity::getAttributes() const
+
+    bool parseSection(fea::BinaryReader& reader, SnapshotSection& section)
     {
-        std::unordered_set<std::string> result;
+        section = {reader.read<uint8_t>(), nullptr, 0, 0, 0};
+
+        if(section.mKind == FULL_SECTION)
+        {
+            section.mSize = reader.read<uint32_t>();
+            section.mData = reader.readBytes(section.mSize);
+        }
+        else if(section.mKind == PATCHED_SECTION)
+        {
+            section.mSize = reader.read<uint32_t>();
+            section.mPatchCount = reader.read<uint32_t>();
+            section.mData = reader.readBytes(0);
 
-        for(auto& attribute : attributeData)
-            result.insert(attribute.first);
+            for(uint32_t i = 0; i < section.mPatchCount && reader.isValid(); i++)
+            {
+                uint32_t offset = reader.read<uint32_t>();
+                uint32_t length = reader.read<uint32_t>();
 
-        return result;
-    }
+                if(offset > section.mSize || length > section.mSize - offset)
+                    return false;
+
+                reader.readBytes(length);
+            }
 
+            const uint8_t* end = reader.readBytes(0);
+            section.mPatchBytes = end ? static_cast<uint32_t>(end - section.mData) : 0;
+        }
+        else if(section.mKind != UNCHANGED_SECTION)
+        {
+            return false;
+        }
+
+        return reader.isValid();
+    }
 
-    EntityStorage::EntityStorage() : mNextId(0)
+    //checks the structure of a snapshot and finds all of its parts, without copying any data
+    bool parseSnapshot(const std::vector<uint8_t>& data, SnapshotLayout& layout)
     {
+        fea::BinaryReader reader(data.data(), data.size());
+        const uint8_t* magic = reader.readBytes(sizeof(snapshotMagic));
+        uint32_t version = reader.read<uint32_t>();
+        layout.mDelta = reader.read<uint8_t>() != 0;
+
+        if(!reader.isValid() || std::memcmp(magic, snapshotMagic, sizeof(snapshotMagic)) != 0 || version != snapshotVersion)
+            return false;
+
+        uint32_t attributeCount = reader.read<uint32_t>();
+        for(uint32_t i = 0; i < attributeCount && reader.isValid(); i++)
+        {
+            std::string name = reader.readString();
+            layout.mAttributes.emplace_back(name, reader.readString());
+        }
+
+        if(!parseSection(reader, layout.mLocations) || !parseSection(reader, layout.mFreeIds))
+            return false;
+
+        uint32_t archetypeCount = reader.read<uint32_t>();
+        for(uint32_t i = 0; i < archetypeCount && reader.isValid(); i++)
+        {
+            SnapshotArchetype archetype;
+            uint32_t columnCount = reader.read<uint32_t>();
+
+            for(uint32_t j = 0; j < columnCount && reader.isValid(); j++)
+            {
+                uint32_t attribute = reader.read<uint32_t>();
+
+                if(attribute >= attributeCount || (!archetype.mAttributes.empty() && attribute <= archetype.mAttributes.back()))
+                    return false;
+
+                archetype.mAttributes.push_back(attribute);
+            }
+
+            if(!parseSection(reader, archetype.mEntities))
+                return false;
+
+            archetype.mColumns.resize(archetype.mAttributes.size());
+            for(SnapshotSection& column : archetype.mColumns)
+            {
+                if(!parseSection(reader, column))
+                    return false;
+            }
+
+            layout.mArchetypes.push_back(std::move(archetype));
+        }
+
+        return reader.isValid() && reader.isAtEnd();
     }
 
-    uint32_t EntityStorage::addEntity(const std::set<std::string>& attributeList)
+    //gives the full bytes of a section, applying the changes stored in a delta snapshot to the base snapshot when needed
+    bool resolveSection(const SnapshotSection& section, const SnapshotSection* baseSection, std::vector<uint8_t>& patched, const uint8_t*& data, uint32_t& size)
     {
-        uint32_t newId;
+        if(section.mKind == FULL_SECTION)
+        {
+            data = section.mData;
+            size = section.mSize;
+            return true;
+        }
 
-        if(mFreeIds.size() != 0)
+        if(baseSection == nullptr || baseSection->mKind != FULL_SECTION)
+            return false;
+
+        if(section.mKind == UNCHANGED_SECTION)
         {
-            newId = mFreeIds.top();
-            mFreeIds.pop();
+            data = baseSection->mData;
+            size = baseSection->mSize;
+            return true;
         }
-        else
+
+        if(baseSection->mSize != section.mSize)
+            return false;
+
+        patched.assign(baseSection->mData, baseSection->mData + baseSection->mSize);
+        fea::BinaryReader reader(section.mData, section.mPatchBytes);
+
+        for(uint32_t i = 0; i < section.mPatchCount; i++)
         {
-            newId = mNextId;
-            mNextId++;
+            uint32_t offset = reader.read<uint32_t>();
+            uint32_t length = reader.read<uint32_t>();
+            std::memcpy(patched.data() + offset, reader.readBytes(length), length);
         }
 
-        for(auto& attribute : attributeList)
+        data = patched.data();
+        size = static_cast<uint32_t>(patched.size());
+        return true;
+    }
+
+    void writeSection(fea::BinaryWriter& writer, const std::vector<uint8_t>& section, const SnapshotSection* baseSection)
+    {
+        if(baseSection != nullptr && baseSection->mKind == FULL_SECTION && section.size() == baseSection->mSize)
         {
-            FEA_ASSERT(mAttributes.find(attribute) != mAttributes.end(), "Trying to create an entity with the attribute '" + attribute + "' which is invalid!");
+            if(std::memcmp(section.data(), baseSection->mData, section.size()) == 0)
+            {
+                writer.write(UNCHANGED_SECTION);
+                return;
+            }
+
+            //find runs of changed blocks
+            std::vector<std::pair<uint32_t, uint32_t>> patches;
+            size_t patchedBytes = 0;
+
+            for(uint32_t offset = 0; offset < section.size(); offset += snapshotDeltaBlock)
+            {
+                uint32_t length = std::min(snapshotDeltaBlock, static_cast<uint32_t>(section.size()) - offset);
+
+                if(std::memcmp(section.data() + offset, baseSection->mData + offset, length) == 0)
+                    continue;
+
+                if(!patches.empty() && patches.back().first + patches.back().second == offset)
+                    patches.back().second += length;
+                else
+                    patches.emplace_back(offset, length);
+
+                patchedBytes += length;
+            }
+
+            if(patchedBytes + patches.size() * 2 * sizeof(uint32_t) < section.size())
+            {
+                writer.write(PATCHED_SECTION);
+                writer.write(static_cast<uint32_t>(section.size()));
+                writer.write(static_cast<uint32_t>(patches.size()));
+
+                for(const auto& patch : patches)
+                {
+                    writer.write(patch.first);
+                    writer.write(patch.second);
+                    writer.writeBytes(section.data() + patch.first, patch.second);
+                }
+                return;
+            }
         }
 
-        mEntities.emplace(newId, StorageEntity(attributeList));
+        writer.write(FULL_SECTION);
+        writer.write(static_cast<uint32_t>(section.size()));
+        writer.writeBytes(section.data(), section.size());
+    }
+}
+
+namespace fea
+{
+    EntityStorage::AttributeInfo::AttributeInfo(const std::string& name, std::type_index type, std::unique_ptr<AttributeColumnBase> emptyColumn) :
+        mName(name),
+        mType(type),
+        mEmptyColumn(std::move(emptyColumn))
+    {
+    }
+
+    EntityStorage::EntityStorage() :
+        mChangeVersion(1)
+    {
+        AttributeSerializer<std::string> stringSerializer;
+        stringSerializer.mSerialize = [] (const std::string& value, BinaryWriter& writer) { writer.writeString(value); };
+        stringSerializer.mDeserialize = [] (BinaryReader& reader) { return reader.readString(); };
+        registerSerializer(std::move(stringSerializer));
+    }
+
+    uint32_t EntityStorage::addEntity(const std::set<std::string>& attributeList)
+    {
+        uint32_t archetype = findOrCreateArchetype(attributeList);
+        uint32_t newId = acquireId();
+
+        mLocations[newId].mArchetype = archetype;
+        mLocations[newId].mRow = mArchetypes[archetype].addRow(newId);
         return newId;
     }
-    
+
+    std::vector<EntityHandle> EntityStorage::addEntities(const std::set<std::string>& attributeList, uint32_t amount)
+    {
+        return addEntities(findOrCreateArchetype(attributeList), amount);
+    }
+
+    std::vector<EntityHandle> EntityStorage::addEntities(const CompiledPrototype& prototype, uint32_t amount)
+    {
+        FEA_ASSERT(prototype.getArchetype() < mArchetypes.size() && mArchetypes[prototype.getArchetype()].getAttributes() == prototype.getAttributes(), "Trying to create entities from a prototype which has not been resolved!");
+        std::vector<EntityHandle> handles = addEntities(prototype.getArchetype(), amount);
+
+        if(amount == 0)
+            return handles;
+
+        Archetype& target = mArchetypes[prototype.getArchetype()];
+        uint32_t firstRow = mLocations[handles.front().mIndex].mRow;
+
+        for(const auto& value : prototype.getValues())
+        {
+            target.getColumn(value.mAttribute).fillFrom(firstRow, amount, prototype.getValueData(value));
+            target.markChanged(value.mAttribute, firstRow, amount, mChangeVersion);
+        }
+
+        return handles;
+    }
+
+    std::vector<EntityHandle> EntityStorage::addEntities(uint32_t archetype, uint32_t amount)
+    {
+        Archetype& target = mArchetypes[archetype];
+        target.reserve(target.size() + amount);
+
+        std::vector<EntityHandle> handles;
+        handles.reserve(amount);
+
+        //the rows are added in order so the created entities occupy a contiguous range of every column
+        for(uint32_t i = 0; i < amount; i++)
+        {
+            uint32_t newId = acquireId();
+            mLocations[newId].mArchetype = archetype;
+            mLocations[newId].mRow = target.addRow(newId);
+            handles.push_back(EntityHandle(newId, mLocations[newId].mGeneration));
+        }
+
+        return handles;
+    }
+
+    void EntityStorage::reserveEntities(const std::set<std::string>& attributeList, uint32_t amount)
+    {
+        Archetype& target = mArchetypes[findOrCreateArchetype(attributeList)];
+        target.reserve(target.size() + amount);
+
+        //removed IDs are handed out again before new locations are needed
+        size_t locations = mLocations.size() + amount - std::min(static_cast<size_t>(amount), mFreeIds.size());
+
+        if(locations > mLocations.capacity())
+            mLocations.reserve(std::max(locations, mLocations.capacity() * 2));
+    }
+
     void EntityStorage::removeEntity(uint32_t id)
     {
-        mEntities.erase(id);
+        FEA_ASSERT(hasEntity(id), "Trying to remove entity ID '" + std::to_string(id) + "' which does not exist!");
+        EntityLocation& location = mLocations[id];
+
+        uint32_t movedId = mArchetypes[location.mArchetype].removeRow(location.mRow);
+
+        if(movedId != static_cast<uint32_t>(-1))
+            mLocations[movedId].mRow = location.mRow;
+
+        location.mArchetype = static_cast<uint32_t>(-1);
+        location.mGeneration++;
         mFreeIds.push(id);
     }
 
+    bool EntityStorage::hasEntity(uint32_t id) const
+    {
+        return id < mLocations.size() && mLocations[id].mArchetype != static_cast<uint32_t>(-1);
+    }
+
+    EntityHandle EntityStorage::getHandle(uint32_t id) const
+    {
+        FEA_ASSERT(hasEntity(id), "Trying to get a handle to entity ID '" + std::to_string(id) + "' which does not exist!");
+        return EntityHandle(id, mLocations[id].mGeneration);
+    }
+
+    bool EntityStorage::isValid(EntityHandle handle) const
+    {
+        return handle.mIndex < mLocations.size() && mLocations[handle.mIndex].mGeneration == handle.mGeneration && mLocations[handle.mIndex].mArchetype != static_cast<uint32_t>(-1);
+    }
+
+    uint32_t EntityStorage::getIdLimit() const
+    {
+        return static_cast<uint32_t>(mLocations.size());
+    }
+
+    uint64_t EntityStorage::getStorageOrder(uint32_t id) const
+    {
+        FEA_ASSERT(hasEntity(id), "Trying to get the storage order of entity ID '" + std::to_string(id) + "' which does not exist!");
+        return (static_cast<uint64_t>(mLocations[id].mArchetype) << 32) | mLocations[id].mRow;
+    }
+
+    uint32_t EntityStorage::getArchetypeIndex(uint32_t id) const
+    {
+        FEA_ASSERT(hasEntity(id), "Trying to get the archetype of entity ID '" + std::to_string(id) + "' which does not exist!");
+        return mLocations[id].mArchetype;
+    }
+
+    void EntityStorage::addAttribute(uint32_t id, const std::string& attribute)
+    {
+        FEA_ASSERT(mAttributeIndices.find(attribute) != mAttributeIndices.end(), "Trying to add the attribute '" + attribute + "' to an entity but such an attribute has not been registered!");
+        FEA_ASSERT(hasEntity(id), "Trying to add the attribute '" + attribute + "' to entity ID '" + std::to_string(id) + "' which does not exist!");
+        uint32_t index = getAttributeIndex(attribute);
+        const Archetype& current = mArchetypes[mLocations[id].mArchetype];
+
+        if(current.hasAttribute(index))
+            return;
+
+        std::vector<uint32_t> attributes = current.getAttributes();
+        attributes.insert(std::upper_bound(attributes.begin(), attributes.end(), index), index);
+
+        moveEntity(id, findOrCreateArchetype(attributes));
+    }
+
+    void EntityStorage::removeAttribute(uint32_t id, const std::string& attribute)
+    {
+        FEA_ASSERT(mAttributeIndices.find(attribute) != mAttributeIndices.end(), "Trying to remove the attribute '" + attribute + "' from an entity but such an attribute has not been registered!");
+        FEA_ASSERT(hasEntity(id), "Trying to remove the attribute '" + attribute + "' from entity ID '" + std::to_string(id) + "' which does not exist!");
+        uint32_t index = getAttributeIndex(attribute);
+        const Archetype& current = mArchetypes[mLocations[id].mArchetype];
+
+        if(!current.hasAttribute(index))
+            return;
+
+        std::vector<uint32_t> attributes = current.getAttributes();
+        attributes.erase(std::lower_bound(attributes.begin(), attributes.end(), index));
+
+        moveEntity(id, findOrCreateArchetype(attributes));
+    }
+
     bool EntityStorage::hasData(const uint32_t id, const std::string& attribute) const
     {
-        return mEntities.at(id).hasData(attribute); 
+        FEA_ASSERT(hasEntity(id), "Trying to check the attribute '" + attribute + "' on entity ID '" + std::to_string(id) + "' which does not exist!");
+        auto index = mAttributeIndices.find(attribute);
+
+        if(index == mAttributeIndices.end())
+            return false;
+
+        return mArchetypes[mLocations[id].mArchetype].hasAttribute(index->second);
     }
 
     bool EntityStorage::attributeIsValid(const std::string& attribute) const
     {
-        return mAttributes.find(attribute) != mAttributes.end();
+        return mAttributeIndices.find(attribute) != mAttributeIndices.end();
+    }
+
+    uint32_t EntityStorage::getChangeVersion() const
+    {
+        return mChangeVersion;
+    }
+
+    uint32_t EntityStorage::advanceChangeVersion()
+    {
+        return mChangeVersion++;
+    }
+
+    uint32_t EntityStorage::findOrCreateQuery(std::vector<uint32_t> attributes)
+    {
+        std::sort(attributes.begin(), attributes.end());
+        attributes.erase(std::unique(attributes.begin(), attributes.end()), attributes.end());
+
+        auto existing = mQueryIndices.find(attributes);
+
+        if(existing != mQueryIndices.end())
+            return existing->second;
+
+        Query query;
+        query.mAttributes = attributes;
+
+        for(uint32_t i = 0; i < mArchetypes.size(); i++)
+        {
+            const std::vector<uint32_t>& archetypeAttributes = mArchetypes[i].getAttributes();
+
+            if(std::includes(archetypeAttributes.begin(), archetypeAttributes.end(), attributes.begin(), attributes.end()))
+                query.mArchetypes.push_back(i);
+        }
+
+        uint32_t index = static_cast<uint32_t>(mQueries.size());
+        mQueries.push_back(std::move(query));
+        mQueryIndices.emplace(attributes, index);
+        return index;
+    }
+
+    const std::vector<uint32_t>& EntityStorage::getQueryArchetypes(uint32_t query) const
+    {
+        return mQueries[query].mArchetypes;
+    }
+
+    Archetype& EntityStorage::getArchetype(uint32_t archetype)
+    {
+        return mArchetypes[archetype];
+    }
+
+    const Archetype& EntityStorage::getArchetype(uint32_t archetype) const
+    {
+        return mArchetypes[archetype];
+    }
+
+    EntitySnapshot EntityStorage::createSnapshot(const EntitySnapshot* base) const
+    {
+        SnapshotLayout baseLayout;
+        bool useBase = false;
+
+        if(base != nullptr)
+        {
+            bool baseIsValid = parseSnapshot(base->getData(), baseLayout) && !baseLayout.mDelta;
+            FEA_ASSERT(baseIsValid, "Trying to create a delta snapshot from a base which is not a valid full snapshot!");
+            useBase = baseIsValid && baseLayout.mAttributes.size() == mAttributes.size();
+
+            for(uint32_t i = 0; useBase && i < mAttributes.size(); i++)
+                useBase = baseLayout.mAttributes[i].first == mAttributes[i].mName && baseLayout.mAttributes[i].second == mAttributes[i].mType.name();
+        }
+
+        std::vector<uint8_t> data;
+        data.reserve(base != nullptr ? base->getData().size() : 0);
+        BinaryWriter writer(data);
+
+        writer.writeBytes(snapshotMagic, sizeof(snapshotMagic));
+        writer.write(snapshotVersion);
+        writer.write(static_cast<uint8_t>(base != nullptr));
+
+        writer.write(static_cast<uint32_t>(mAttributes.size()));
+        for(const AttributeInfo& attribute : mAttributes)
+        {
+            writer.writeString(attribute.mName);
+            writer.writeString(attribute.mType.name());
+        }
+
+        std::vector<uint8_t> section;
+        BinaryWriter sectionWriter(section);
+
+        for(const EntityLocation& location : mLocations)
+        {
+            sectionWriter.write(location.mArchetype);
+            sectionWriter.write(location.mGeneration);
+        }
+        writeSection(writer, section, useBase ? &baseLayout.mLocations : nullptr);
+
+        //stored bottom to top so that restoring hands out the same IDs in the same order
+        std::vector<uint32_t> freeIds;
+        freeIds.reserve(mFreeIds.size());
+        for(std::stack<uint32_t> remaining = mFreeIds; !remaining.empty(); remaining.pop())
+            freeIds.push_back(remaining.top());
+        std::reverse(freeIds.begin(), freeIds.end());
+
+        section.clear();
+        sectionWriter.writeBytes(freeIds.data(), freeIds.size() * sizeof(uint32_t));
+        writeSection(writer, section, useBase ? &baseLayout.mFreeIds : nullptr);
+
+        writer.write(static_cast<uint32_t>(mArchetypes.size()));
+
+        for(uint32_t i = 0; i < mArchetypes.size(); i++)
+        {
+            const Archetype& archetype = mArchetypes[i];
+            const std::vector<uint32_t>& attributes = archetype.getAttributes();
+
+            writer.write(static_cast<uint32_t>(attributes.size()));
+            writer.writeBytes(attributes.data(), attributes.size() * sizeof(uint32_t));
+
+            //archetypes are never removed, so a matching archetype in the base has the same index
+            const SnapshotArchetype* baseArchetype = useBase && i < baseLayout.mArchetypes.size() && baseLayout.mArchetypes[i].mAttributes == attributes ? &baseLayout.mArchetypes[i] : nullptr;
+
+            section.clear();
+            sectionWriter.writeBytes(archetype.getEntities().data(), archetype.size() * sizeof(uint32_t));
+            writeSection(writer, section, baseArchetype ? &baseArchetype->mEntities : nullptr);
+
+            for(uint32_t j = 0; j < attributes.size(); j++)
+            {
+                const AttributeColumnBase& column = archetype.getColumn(attributes[j]);
+
+                if(baseArchetype != nullptr)
+                {
+                    section.clear();
+                    column.serialize(sectionWriter, getSerializer(attributes[j]));
+                    writeSection(writer, section, &baseArchetype->mColumns[j]);
+                }
+                else
+                {
+                    //without a base the column is written in place and its size filled in afterwards
+                    writer.write(FULL_SECTION);
+                    size_t sizePosition = data.size();
+                    writer.write(static_cast<uint32_t>(0));
+                    column.serialize(writer, getSerializer(attributes[j]));
+                    uint32_t columnSize = static_cast<uint32_t>(data.size() - sizePosition - sizeof(uint32_t));
+                    std::memcpy(data.data() + sizePosition, &columnSize, sizeof(uint32_t));
+                }
+            }
+        }
+
+        return EntitySnapshot(std::move(data));
+    }
+
+    bool EntityStorage::restoreSnapshot(const EntitySnapshot& snapshot, const EntitySnapshot* base)
+    {
+        SnapshotLayout layout;
+        SnapshotLayout baseLayout;
+
+        if(!parseSnapshot(snapshot.getData(), layout))
+            return false;
+
+        if(layout.mDelta && (base == nullptr || !parseSnapshot(base->getData(), baseLayout) || baseLayout.mDelta))
+            return false;
+
+        //the sections of the base can only be used if it was taken with the same attributes
+        bool useBase = layout.mDelta && baseLayout.mAttributes == layout.mAttributes;
+
+        //attributes are matched by name so that snapshots survive changes in registration order
+        std::vector<uint32_t> attributeIndices;
+        for(const auto& attribute : layout.mAttributes)
+        {
+            auto index = mAttributeIndices.find(attribute.first);
+
+            if(index == mAttributeIndices.end() || attribute.second != mAttributes[index->second].mType.name())
+                return false;
+
+            attributeIndices.push_back(index->second);
+        }
+
+        //everything is resolved and validated before the current state is touched
+        std::vector<std::vector<uint8_t>> patchedSections;
+        auto resolve = [&] (const SnapshotSection& section, const SnapshotSection* baseSection, const uint8_t*& data, uint32_t& size)
+        {
+            patchedSections.emplace_back();
+            return resolveSection(section, useBase ? baseSection : nullptr, patchedSections.back(), data, size);
+        };
+
+        const uint8_t* locations;
+        uint32_t locationBytes;
+        const uint8_t* freeIds;
+        uint32_t freeIdBytes;
+
+        if(!resolve(layout.mLocations, &baseLayout.mLocations, locations, locationBytes) || !resolve(layout.mFreeIds, &baseLayout.mFreeIds, freeIds, freeIdBytes))
+            return false;
+
+        if(locationBytes % (2 * sizeof(uint32_t)) != 0 || freeIdBytes % sizeof(uint32_t) != 0)
+            return false;
+
+        uint32_t locationCount = locationBytes / (2 * sizeof(uint32_t));
+        uint32_t freeIdCount = freeIdBytes / sizeof(uint32_t);
+        uint32_t archetypeCount = static_cast<uint32_t>(layout.mArchetypes.size());
+        uint32_t liveCount = 0;
+
+        for(uint32_t id = 0; id < locationCount; id++)
+        {
+            uint32_t archetype = readUint32(locations, id * 2);
+
+            if(archetype != static_cast<uint32_t>(-1))
+            {
+                if(archetype >= archetypeCount)
+                    return false;
+                liveCount++;
+            }
+        }
+
+        std::vector<std::vector<uint32_t>> targetAttributes(archetypeCount);
+        std::vector<std::pair<const uint8_t*, uint32_t>> entities(archetypeCount);
+        std::vector<std::vector<std::pair<const uint8_t*, uint32_t>>> columns(archetypeCount);
+        std::vector<uint8_t> placed(locationCount, 0);
+        uint32_t placedCount = 0;
+
+        for(uint32_t i = 0; i < archetypeCount; i++)
+        {
+            const SnapshotArchetype& archetype = layout.mArchetypes[i];
+            const SnapshotArchetype* baseArchetype = i < baseLayout.mArchetypes.size() && baseLayout.mArchetypes[i].mAttributes == archetype.mAttributes ? &baseLayout.mArchetypes[i] : nullptr;
+
+            if(!resolve(archetype.mEntities, baseArchetype ? &baseArchetype->mEntities : nullptr, entities[i].first, entities[i].second) || entities[i].second % sizeof(uint32_t) != 0)
+                return false;
+
+            entities[i].second /= sizeof(uint32_t);
+
+            for(uint32_t row = 0; row < entities[i].second; row++)
+            {
+                uint32_t id = readUint32(entities[i].first, row);
+
+                if(id >= locationCount || placed[id] || readUint32(locations, id * 2) != i)
+                    return false;
+
+                placed[id] = 1;
+                placedCount++;
+            }
+
+            for(uint32_t attribute : archetype.mAttributes)
+                targetAttributes[i].push_back(attributeIndices[attribute]);
+            std::sort(targetAttributes[i].begin(), targetAttributes[i].end());
+
+            columns[i].resize(archetype.mColumns.size());
+            for(uint32_t j = 0; j < archetype.mColumns.size(); j++)
+            {
+                if(!resolve(archetype.mColumns[j], baseArchetype ? &baseArchetype->mColumns[j] : nullptr, columns[i][j].first, columns[i][j].second))
+                    return false;
+            }
+        }
+
+        if(placedCount != liveCount)
+            return false;
+
+        for(uint32_t i = 0; i < freeIdCount; i++)
+        {
+            uint32_t id = readUint32(freeIds, i);
+
+            if(id >= locationCount || readUint32(locations, id * 2) != static_cast<uint32_t>(-1))
+                return false;
+        }
+
+        for(uint32_t i = 0; i < archetypeCount; i++)
+        {
+            for(uint32_t j = i + 1; j < archetypeCount; j++)
+            {
+                if(targetAttributes[i] == targetAttributes[j])
+                    return false;
+            }
+        }
+
+        //columns are read into staging columns first, so that a column failing to deserialize leaves the world unchanged
+        std::vector<std::vector<std::unique_ptr<AttributeColumnBase>>> stagedColumns(archetypeCount);
+        for(uint32_t i = 0; i < archetypeCount; i++)
+        {
+            const SnapshotArchetype& archetype = layout.mArchetypes[i];
+
+            for(uint32_t j = 0; j < archetype.mAttributes.size(); j++)
+            {
+                uint32_t attribute = attributeIndices[archetype.mAttributes[j]];
+                std::unique_ptr<AttributeColumnBase> column = mAttributes[attribute].mEmptyColumn->createEmpty();
+                column->reserve(entities[i].second);
+
+                for(uint32_t row = 0; row < entities[i].second; row++)
+                    column->pushUninitialized();
+
+                BinaryReader reader(columns[i][j].first, columns[i][j].second);
+
+                if(!column->deserialize(reader, getSerializer(attribute)) || !reader.isAtEnd())
+                    return false;
+
+                stagedColumns[i].push_back(std::move(column));
+            }
+        }
+
+        //rebuild the storage
+        for(auto& archetype : mArchetypes)
+            archetype.clear();
+
+        //handles taken after the snapshot must stay invalid, so the generations of free slots never go back and the ids beyond the snapshot are kept as free slots
+        std::vector<EntityLocation> previousLocations;
+        previousLocations.swap(mLocations);
+        uint32_t idCount = std::max(locationCount, static_cast<uint32_t>(previousLocations.size()));
+        mLocations.assign(idCount, {static_cast<uint32_t>(-1), 0, 0});
+
+        for(uint32_t id = 0; id < idCount; id++)
+        {
+            uint32_t generation = id < locationCount ? readUint32(locations, id * 2 + 1) : 0;
+            bool freeInSnapshot = id >= locationCount || readUint32(locations, id * 2) == static_cast<uint32_t>(-1);
+
+            if(freeInSnapshot && id < previousLocations.size())
+                generation = std::max(generation, previousLocations[id].mGeneration + 1);
+
+            mLocations[id].mGeneration = generation;
+        }
+
+        mFreeIds = std::stack<uint32_t>();
+        //the ids beyond the snapshot are reused last and in increasing order, like new ids
+        for(uint32_t id = idCount; id > locationCount; id--)
+            mFreeIds.push(id - 1);
+        for(uint32_t i = 0; i < freeIdCount; i++)
+            mFreeIds.push(readUint32(freeIds, i));
+
+        for(uint32_t i = 0; i < archetypeCount; i++)
+        {
+            const SnapshotArchetype& archetype = layout.mArchetypes[i];
+            uint32_t targetIndex = findOrCreateArchetype(targetAttributes[i]);
+            Archetype& target = mArchetypes[targetIndex];
+            target.reserve(entities[i].second);
+
+            for(uint32_t row = 0; row < entities[i].second; row++)
+            {
+                uint32_t id = readUint32(entities[i].first, row);
+                mLocations[id].mArchetype = targetIndex;
+                mLocations[id].mRow = target.addRow(id);
+            }
+
+            for(uint32_t j = 0; j < archetype.mAttributes.size(); j++)
+            {
+                uint32_t attribute = attributeIndices[archetype.mAttributes[j]];
+                target.replaceColumn(attribute, std::move(stagedColumns[i][j]));
+                target.markChanged(attribute, 0, target.size(), mChangeVersion);
+            }
+        }
+
+        return true;
     }
 
     void EntityStorage::clear()
     {
+        //the locations are kept with their generations bumped, so that handles taken before stay invalid
+        removeAllEntities();
+        mAttributeIndices.clear();
         mAttributes.clear();
-        mEntities.clear();
-        mFreeIds = std::stack<uint32_t>();
-        mNextId = 0;
+        mArchetypes.clear();
+        mArchetypeIndices.clear();
+        mQueries.clear();
+        mQueryIndices.clear();
     }
-    
+
     std::unordered_set<std::string> EntityStorage::getAttributes(uint32_t id) const
     {
-        return mEntities.at(id).getAttributes();
+        FEA_ASSERT(hasEntity(id), "Trying to get the attributes of entity ID '" + std::to_string(id) + "' which does not exist!");
+        std::unordered_set<std::string> result;
+
+        for(uint32_t attribute : mArchetypes[mLocations[id].mArchetype].getAttributes())
+            result.insert(mAttributes[attribute].mName);
+
+        return result;
+    }
+
+    EntityMemoryStats EntityStorage::getMemoryStats() const
+    {
+        EntityMemoryStats stats;
+        stats.mIdLimit = static_cast<uint32_t>(mLocations.size());
+        stats.mFreeIdCount = static_cast<uint32_t>(mFreeIds.size());
+        stats.mArchetypeCount = static_cast<uint32_t>(mArchetypes.size());
+        stats.mQueryCount = static_cast<uint32_t>(mQueries.size());
+        stats.mAttributeIndexLoadFactor = mAttributeIndices.load_factor();
+        stats.mSerializerLoadFactor = mSerializers.load_factor();
+
+        stats.mAttributes.resize(mAttributes.size());
+        for(size_t i = 0; i < mAttributes.size(); i++)
+        {
+            stats.mAttributes[i].mName = mAttributes[i].mName;
+            stats.mAttributes[i].mType = mAttributes[i].mType.name();
+        }
+
+        for(const auto& archetype : mArchetypes)
+        {
+            stats.mEntityCount += archetype.size();
+            archetype.collectMemoryStats(stats.mAttributes, stats);
+        }
+
+        for(const auto& attribute : stats.mAttributes)
+        {
+            stats.mUsedBytes += attribute.mUsedBytes;
+            stats.mReservedBytes += attribute.mReservedBytes;
+            stats.mAllocationCount += attribute.mAllocationCount;
+        }
+
+        stats.mUsedBytes += mLocations.size() * sizeof(EntityLocation);
+        stats.mReservedBytes += mLocations.capacity() * sizeof(EntityLocation);
+        stats.mAllocationCount += mLocations.capacity() > 0 ? 1 : 0;
+
+        //the free ID stack does not expose its capacity, so only its content is counted
+        stats.mUsedBytes += mFreeIds.size() * sizeof(uint32_t);
+        stats.mReservedBytes += mFreeIds.size() * sizeof(uint32_t);
+
+        return stats;
+    }
+
+    uint32_t EntityStorage::getAttributeIndex(const std::string& attribute) const
+    {
+        return mAttributeIndices.at(attribute);
+    }
+
+    uint32_t EntityStorage::acquireId()
+    {
+        uint32_t newId;
+
+        if(mFreeIds.size() != 0)
+        {
+            newId = mFreeIds.top();
+            mFreeIds.pop();
+        }
+        else
+        {
+            newId = static_cast<uint32_t>(mLocations.size());
+            mLocations.push_back({static_cast<uint32_t>(-1), 0, 0});
+        }
+
+        return newId;
+    }
+
+    const AttributeSerializerBase* EntityStorage::getSerializer(uint32_t attribute) const
+    {
+        auto serializer = mSerializers.find(mAttributes[attribute].mType);
+
+        return serializer != mSerializers.end() ? serializer->second.get() : nullptr;
+    }
+
+    void EntityStorage::removeAllEntities()
+    {
+        for(auto& archetype : mArchetypes)
+            archetype.clear();
+
+        mFreeIds = std::stack<uint32_t>();
+
+        for(uint32_t id = 0; id < mLocations.size(); id++)
+        {
+            if(mLocations[id].mArchetype != static_cast<uint32_t>(-1))
+            {
+                mLocations[id].mArchetype = static_cast<uint32_t>(-1);
+                mLocations[id].mGeneration++;
+            }
+
+            mFreeIds.push(id);
+        }
+    }
+
+    bool EntityStorage::findContiguousRows(const std::vector<EntityHandle>& handles, uint32_t& archetype, uint32_t& firstRow) const
+    {
+        if(handles.empty())
+            return false;
+
+        FEA_ASSERT(isValid(handles.front()), "Trying to access entity ID '" + std::to_string(handles.front().mIndex) + "' through a handle which is no longer valid!");
+        const EntityLocation& first = mLocations[handles.front().mIndex];
+        archetype = first.mArchetype;
+        firstRow = first.mRow;
+
+        for(uint32_t i = 0; i < handles.size(); i++)
+        {
+            FEA_ASSERT(isValid(handles[i]), "Trying to access entity ID '" + std::to_string(handles[i].mIndex) + "' through a handle which is no longer valid!");
+            const EntityLocation& location = mLocations[handles[i].mIndex];
+
+            if(location.mArchetype != archetype || location.mRow != firstRow + i)
+                return false;
+        }
+
+        return true;
+    }
+
+    uint32_t EntityStorage::findOrCreateArchetype(const std::set<std::string>& attributeList)
+    {
+        std::vector<uint32_t> attributes;
+        attributes.reserve(attributeList.size());
+
+        for(auto& attribute : attributeList)
+        {
+            FEA_ASSERT(mAttributeIndices.find(attribute) != mAttributeIndices.end(), "Trying to create an entity with the attribute '" + attribute + "' which is invalid!");
+            attributes.push_back(getAttributeIndex(attribute));
+        }
+
+        std::sort(attributes.begin(), attributes.end());
+
+        return findOrCreateArchetype(attributes);
+    }
+
+    uint32_t EntityStorage::findOrCreateArchetype(const std::vector<uint32_t>& attributes)
+    {
+        auto existing = mArchetypeIndices.find(attributes);
+
+        if(existing != mArchetypeIndices.end())
+            return existing->second;
+
+        std::vector<std::unique_ptr<AttributeColumnBase>> columns;
+        columns.reserve(attributes.size());
+
+        for(uint32_t attribute : attributes)
+            columns.push_back(mAttributes[attribute].mEmptyColumn->createEmpty());
+
+        uint32_t index = static_cast<uint32_t>(mArchetypes.size());
+        mArchetypes.emplace_back(attributes, std::move(columns));
+        mArchetypeIndices.emplace(attributes, index);
+
+        //keep cached queries up to date so that views never have to search for archetypes
+        for(auto& query : mQueries)
+        {
+            if(std::includes(attributes.begin(), attributes.end(), query.mAttributes.begin(), query.mAttributes.end()))
+                query.mArchetypes.push_back(index);
+        }
+
+        return index;
+    }
+
+    void EntityStorage::moveEntity(uint32_t id, uint32_t targetArchetype)
+    {
+        EntityLocation& location = mLocations[id];
+        Archetype& source = mArchetypes[location.mArchetype];
+        Archetype& target = mArchetypes[targetArchetype];
+
+        uint32_t newRow = source.moveRowTo(location.mRow, target);
+        uint32_t movedId = source.removeRow(location.mRow);
+
+        if(movedId != static_cast<uint32_t>(-1))
+            mLocations[movedId].mRow = location.mRow;
+
+        location.mArchetype = targetArchetype;
+        location.mRow = newRow;
     }
 }
@@ -0,0 +1,319 @@
+#include <fea/entity/entitytemplatecache.hpp>
+#include <fstream>
+#include <map>
+#include <algorithm>
+#include <iterator>
+#include <cstring>
+#if defined(__unix__) || defined(__APPLE__)
+#define FEA_MAP_CACHE_FILES
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    const char cacheMagic[4] = {'F', 'E', 'A', 'C'};
+    const uint32_t cacheVersion = 2;
+
+    enum CacheContent : uint8_t { ATTRIBUTES, TEMPLATES };
+    enum CachedValue : uint8_t { NO_VALUE, RAW_VALUE, STRING_VALUE };
+
+    void writeHeader(fea::BinaryWriter& writer, uint64_t sourceHash, CacheContent content, uint32_t amount)
+    {
+        writer.writeBytes(cacheMagic, sizeof(cacheMagic));
+        writer.write(cacheVersion);
+        writer.write(sourceHash);
+        writer.write(content);
+        writer.write(amount);
+    }
+
+    bool save(const std::string& path, const std::vector<uint8_t>& buffer)
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+        if(!file)
+            return false;
+
+        file.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+        return static_cast<bool>(file);
+    }
+
+    //reads the amount of entries, and checks that the cache holds the given content
+    bool readHeader(fea::BinaryReader& reader, CacheContent content, uint32_t& amount)
+    {
+        reader.readBytes(sizeof(cacheMagic) + sizeof(cacheVersion) + sizeof(uint64_t));
+        bool matching = reader.read<uint8_t>() == content;
+        amount = reader.read<uint32_t>();
+
+        return reader.isValid() && matching;
+    }
+}
+
+namespace fea
+{
+    EntityTemplateCache::EntityTemplateCache() :
+        mData(nullptr),
+        mSize(0),
+        mMapped(false)
+    {
+    }
+
+    bool EntityTemplateCache::open(const std::string& path, uint64_t sourceHash)
+    {
+        close();
+
+#if defined(FEA_MAP_CACHE_FILES)
+        int file = ::open(path.c_str(), O_RDONLY);
+
+        if(file == -1)
+            return false;
+
+        struct stat status;
+        if(fstat(file, &status) == 0 && status.st_size > 0)
+        {
+            void* mapping = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+
+            if(mapping != MAP_FAILED)
+            {
+                mData = static_cast<const uint8_t*>(mapping);
+                mSize = static_cast<size_t>(status.st_size);
+                mMapped = true;
+            }
+        }
+
+        ::close(file);
+
+        if(!mMapped)
+            return false;
+#else
+        std::ifstream file(path, std::ios::binary);
+
+        if(!file)
+            return false;
+
+        mBuffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        mData = mBuffer.data();
+        mSize = mBuffer.size();
+#endif
+
+        BinaryReader reader(mData, mSize);
+        const uint8_t* magic = reader.readBytes(sizeof(cacheMagic));
+        uint32_t version = reader.read<uint32_t>();
+        uint64_t hash = reader.read<uint64_t>();
+
+        if(!reader.isValid() || std::memcmp(magic, cacheMagic, sizeof(cacheMagic)) != 0 || version != cacheVersion || hash != sourceHash)
+        {
+            close();
+            return false;
+        }
+
+        return true;
+    }
+
+    bool EntityTemplateCache::isOpen() const
+    {
+        return mData != nullptr;
+    }
+
+    void EntityTemplateCache::close()
+    {
+#if defined(FEA_MAP_CACHE_FILES)
+        if(mMapped)
+            munmap(const_cast<uint8_t*>(mData), mSize);
+#endif
+
+        mData = nullptr;
+        mSize = 0;
+        mMapped = false;
+        mBuffer.clear();
+    }
+
+    bool EntityTemplateCache::loadEntityAttributes(std::unordered_map<std::string, std::string>& attributes) const
+    {
+        BinaryReader reader(mData, mSize);
+        uint32_t amount;
+
+        if(!isOpen() || !readHeader(reader, ATTRIBUTES, amount))
+            return false;
+
+        std::unordered_map<std::string, std::string> result;
+
+        for(uint32_t i = 0; i < amount && reader.isValid(); i++)
+        {
+            std::string attribute = reader.readString();
+            result.emplace(attribute, reader.readString());
+        }
+
+        if(!reader.isValid() || !reader.isAtEnd())
+            return false;
+
+        attributes = std::move(result);
+        return true;
+    }
+
+    bool EntityTemplateCache::addTemplates(EntityFactory& factory) const
+    {
+        BinaryReader reader(mData, mSize);
+        uint32_t amount;
+
+        if(!isOpen() || !readHeader(reader, TEMPLATES, amount))
+            return false;
+
+        //everything is compiled before anything is added so that a bad cache leaves the factory untouched
+        std::vector<std::pair<std::string, CompiledPrototype>> prototypes;
+        prototypes.reserve(std::min(static_cast<size_t>(amount), mSize));
+
+        for(uint32_t i = 0; i < amount && reader.isValid(); i++)
+        {
+            std::string name = reader.readString();
+            uint32_t attributeAmount = reader.read<uint32_t>();
+            CompiledPrototype prototype;
+
+            for(uint32_t j = 0; j < attributeAmount && reader.isValid(); j++)
+            {
+                std::string attribute = reader.readString();
+                uint8_t valueType = reader.read<uint8_t>();
+
+                if(!reader.isValid() || !factory.hasAttribute(attribute))
+                    return false;
+
+                if(valueType == RAW_VALUE)
+                {
+                    std::string type = reader.readString();
+                    uint32_t size = reader.read<uint32_t>();
+                    const uint8_t* data = reader.readBytes(size);
+
+                    //the bytes are only meaningful to the same data type, and the size alone does not tell for instance a float from an int32
+                    if(!data || size == 0 || size != factory.getRawValueSize(attribute) || type != factory.getRawValueType(attribute))
+                        return false;
+
+                    factory.setRawValue(prototype, attribute, data);
+                }
+                else if(valueType == STRING_VALUE)
+                {
+                    std::string arguments = reader.readString();
+
+                    if(!reader.isValid())
+                        return false;
+
+                    factory.parseValue(prototype, attribute, arguments);
+                }
+                else if(valueType == NO_VALUE)
+                {
+                    factory.parseValue(prototype, attribute, "");
+                }
+                else
+                {
+                    return false;
+                }
+            }
+
+            prototypes.emplace_back(std::move(name), std::move(prototype));
+        }
+
+        if(!reader.isValid() || !reader.isAtEnd())
+            return false;
+
+        for(auto& prototype : prototypes)
+            factory.addTemplate(prototype.first, std::move(prototype.second));
+
+        return true;
+    }
+
+    bool EntityTemplateCache::writeEntityAttributes(const std::string& path, uint64_t sourceHash, const std::unordered_map<std::string, std::string>& attributes)
+    {
+        std::vector<uint8_t> buffer;
+        BinaryWriter writer(buffer);
+        writeHeader(writer, sourceHash, ATTRIBUTES, static_cast<uint32_t>(attributes.size()));
+
+        for(const auto& attribute : attributes)
+        {
+            writer.writeString(attribute.first);
+            writer.writeString(attribute.second);
+        }
+
+        return save(path, buffer);
+    }
+
+    bool EntityTemplateCache::writeTemplates(const std::string& path, uint64_t sourceHash, const std::vector<std::pair<std::string, EntityTemplate>>& templates, const EntityFactory& factory)
+    {
+        std::vector<uint8_t> buffer;
+        BinaryWriter writer(buffer);
+        writeHeader(writer, sourceHash, TEMPLATES, static_cast<uint32_t>(templates.size()));
+
+        //templates are stored flattened, with inherited values resolved the same way as EntityFactory::addTemplate does
+        std::unordered_map<std::string, std::map<std::string, std::string>> flattened;
+
+        for(const auto& entityTemplate : templates)
+        {
+            std::map<std::string, std::string> attributes;
+
+            for(const auto& parent : entityTemplate.second.mInherits)
+            {
+                auto parentAttributes = flattened.find(parent);
+
+                if(parentAttributes == flattened.end())
+                    return false;
+
+                for(const auto& attribute : parentAttributes->second)
+                    attributes[attribute.first] = attribute.second;
+            }
+
+            for(const auto& attribute : entityTemplate.second.mAttributes)
+                attributes[attribute.first] = attribute.second;
+
+            writer.writeString(entityTemplate.first);
+            writer.write(static_cast<uint32_t>(attributes.size()));
+
+            for(const auto& attribute : attributes)
+            {
+                const std::string& arguments = attribute.second;
+                writer.writeString(attribute.first);
+
+                if(arguments.empty())
+                {
+                    writer.write(NO_VALUE);
+                }
+                else if(uint32_t size = factory.getRawValueSize(attribute.first))
+                {
+                    CompiledPrototype prototype;
+                    factory.parseValue(prototype, attribute.first, arguments);
+
+                    writer.write(RAW_VALUE);
+                    writer.writeString(factory.getRawValueType(attribute.first));
+                    writer.write(size);
+                    writer.writeBytes(prototype.getValueData(prototype.getValues().front()), size);
+                }
+                else
+                {
+                    writer.write(STRING_VALUE);
+                    writer.writeString(arguments);
+                }
+            }
+
+            flattened.emplace(entityTemplate.first, std::move(attributes));
+        }
+
+        return save(path, buffer);
+    }
+
+    uint64_t EntityTemplateCache::hash(const char* data, size_t size)
+    {
+        uint64_t result = 14695981039346656037ULL;
+
+        for(size_t i = 0; i < size; i++)
+        {
+            result ^= static_cast<uint8_t>(data[i]);
+            result *= 1099511628211ULL;
+        }
+
+        return result;
+    }
+
+    EntityTemplateCache::~EntityTemplateCache()
+    {
+        close();
+    }
+}
@@ -0,0 +1,21 @@
+#include <fea/entity/instanceoverrides.hpp>
+
+namespace fea
+{
+    void InstanceOverrides::apply(EntityManager& entityManager, const std::vector<EntityHandle>& entities) const
+    {
+        for(const auto& attributeOverride : mOverrides)
+        {
+            if(attributeOverride)
+            {
+                FEA_ASSERT(attributeOverride->size() == entities.size(), "Trying to apply " + std::to_string(attributeOverride->size()) + " override values to " + std::to_string(entities.size()) + " entities!");
+                attributeOverride->apply(entityManager, entities);
+            }
+        }
+    }
+
+    void InstanceOverrides::clear()
+    {
+        mOverrides.clear();
+    }
+}
@@ -1,5 +1,6 @@
 #include <fea/entity/jsonentityloader.hpp>
 #include <fstream>
+#include <iterator>
 #include <json/reader.h>
 #include <json/value.h>
 
@@ -17,16 +18,66 @@ namespace fea
 
     std::vector<std::pair<std::string, EntityTemplate>> JsonEntityLoader::loadEntityTemplates(const std::string& path)
     {
-        std::ifstream file(path);
+        return parseEntityTemplates(readFile(path));
+    }
+
+    std::unordered_map<std::string, std::string> JsonEntityLoader::loadEntityAttributes(const std::string& path)
+    {
+        return parseEntityAttributes(readFile(path));
+    }
+
+    void JsonEntityLoader::loadEntityTemplates(const std::string& path, const std::string& cachePath, EntityFactory& factory)
+    {
+        std::string content = readFile(path);
+        uint64_t hash = EntityTemplateCache::hash(content.data(), content.size());
+
+        EntityTemplateCache cache;
+        if(cache.open(cachePath, hash) && cache.addTemplates(factory))
+            return;
+        cache.close();
+
+        std::vector<std::pair<std::string, EntityTemplate>> templates = parseEntityTemplates(content);
+
+        for(const auto& entityTemplate : templates)
+            factory.addTemplate(entityTemplate.first, entityTemplate.second);
+
+        EntityTemplateCache::writeTemplates(cachePath, hash, templates, factory);
+    }
+
+    std::unordered_map<std::string, std::string> JsonEntityLoader::loadEntityAttributes(const std::string& path, const std::string& cachePath)
+    {
+        std::string content = readFile(path);
+        uint64_t hash = EntityTemplateCache::hash(content.data(), content.size());
+
+        std::unordered_map<std::string, std::string> attributes;
+
+        EntityTemplateCache cache;
+        if(cache.open(cachePath, hash) && cache.loadEntityAttributes(attributes))
+            return attributes;
+        cache.close();
+
+        attributes = parseEntityAttributes(content);
+        EntityTemplateCache::writeEntityAttributes(cachePath, hash, attributes);
+
+        return attributes;
+    }
+
+    std::string JsonEntityLoader::readFile(const std::string& path) const
+    {
+        std::ifstream file(path, std::ios::binary);
 
         if(!file)
             throw FileNotFoundException("Error! Entity file not found: " + path + '\n');
 
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    std::vector<std::pair<std::string, EntityTemplate>> JsonEntityLoader::parseEntityTemplates(const std::string& content)
+    {
         Json::Value root;
         Json::Reader reader;
 
-        reader.parse(file, root, false);
-        file.close();
+        reader.parse(content, root, false);
 
         std::vector<std::pair<std::string, EntityTemplate>> result;
 
@@ -54,18 +105,12 @@ namespace fea
         return result;
     }
 
-    std::unordered_map<std::string, std::string> JsonEntityLoader::loadEntityAttributes(const std::string& path)
+    std::unordered_map<std::string, std::string> JsonEntityLoader::parseEntityAttributes(const std::string& content)
     {
-        std::ifstream file(path);
-
-        if(!file)
-            throw FileNotFoundException("Error! Entity file not found: " + path + '\n');
-
         Json::Value root;
         Json::Reader reader;
 
-        reader.parse(file, root, false);
-        file.close();
+        reader.parse(content, root, false);
 
         return jsonObjToStringMap(root);
     }
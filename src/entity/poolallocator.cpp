@@ -0,0 +1,67 @@
+#include <fea/entity/poolallocator.hpp>
+#include <algorithm>
+
+namespace fea
+{
+    FixedSizePool::FixedSizePool(size_t blockSize, uint32_t blocksPerSlab) :
+        mBlockSize(std::max(blockSize, sizeof(FreeBlock))),
+        mBlocksPerSlab(std::max(blocksPerSlab, 1u)),
+        mFreeList(nullptr)
+    {
+        //slabs come from operator new, so rounding the block size keeps every block aligned as well
+        size_t alignment = alignof(std::max_align_t);
+        mBlockSize = (mBlockSize + alignment - 1) / alignment * alignment;
+    }
+
+    void* FixedSizePool::allocate()
+    {
+        if(!mFreeList)
+            addSlab();
+
+        FreeBlock* block = mFreeList;
+        mFreeList = block->mNext;
+        return block;
+    }
+
+    void FixedSizePool::deallocate(void* block)
+    {
+        FreeBlock* freed = static_cast<FreeBlock*>(block);
+        freed->mNext = mFreeList;
+        mFreeList = freed;
+    }
+
+    size_t FixedSizePool::getBlockSize() const
+    {
+        return mBlockSize;
+    }
+
+    size_t FixedSizePool::getSlabCount() const
+    {
+        return mSlabs.size();
+    }
+
+    size_t FixedSizePool::getAllocatedBytes() const
+    {
+        return mSlabs.size() * mBlockSize * mBlocksPerSlab;
+    }
+
+    FixedSizePool::~FixedSizePool()
+    {
+        for(void* slab : mSlabs)
+            ::operator delete(slab);
+    }
+
+    void FixedSizePool::addSlab()
+    {
+        char* slab = static_cast<char*>(::operator new(mBlockSize * mBlocksPerSlab));
+        mSlabs.push_back(slab);
+
+        //blocks are linked in address order so that consecutive allocations are adjacent
+        for(uint32_t i = mBlocksPerSlab; i > 0; i--)
+        {
+            FreeBlock* block = reinterpret_cast<FreeBlock*>(slab + mBlockSize * (i - 1));
+            block->mNext = mFreeList;
+            mFreeList = block;
+        }
+    }
+}
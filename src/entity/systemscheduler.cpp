@@ -0,0 +1,105 @@
+#include <fea/entity/systemscheduler.hpp>
+#include <algorithm>
+#include <atomic>
+
+namespace fea
+{
+    SystemScheduler::SystemScheduler(uint32_t threadAmount) :
+        mThreadPool(threadAmount)
+    {
+    }
+
+    void SystemScheduler::addComponent(EntityComponent& component)
+    {
+        FEA_ASSERT(std::find(mComponents.begin(), mComponents.end(), &component) == mComponents.end(), "Trying to add a component to the scheduler twice!");
+        mComponents.push_back(&component);
+    }
+
+    void SystemScheduler::removeComponent(EntityComponent& component)
+    {
+        mComponents.erase(std::remove(mComponents.begin(), mComponents.end(), &component), mComponents.end());
+    }
+
+    void SystemScheduler::run()
+    {
+        uint32_t amount = static_cast<uint32_t>(mComponents.size());
+
+        if(amount == 0)
+            return;
+
+        //components may change their declared access between frames so the graph is rebuilt every run
+        std::vector<std::vector<uint32_t>> dependents(amount);
+        std::vector<std::atomic<uint32_t>> dependencyCounts(amount);
+        std::vector<uint32_t> roots;
+
+        for(uint32_t i = 0; i < amount; i++)
+        {
+            dependencyCounts[i] = 0;
+
+            for(uint32_t j = 0; j < i; j++)
+            {
+                if(mComponents[j]->conflictsWith(*mComponents[i]))
+                {
+                    dependents[j].push_back(i);
+                    dependencyCounts[i]++;
+                }
+            }
+
+            if(dependencyCounts[i] == 0)
+                roots.push_back(i);
+        }
+
+        std::atomic<uint32_t> remaining(amount);
+        std::function<void(uint32_t)> runComponent = [&] (uint32_t index)
+        {
+            mComponents[index]->update(*this);
+
+            for(uint32_t dependent : dependents[index])
+            {
+                if(--dependencyCounts[dependent] == 0)
+                    mThreadPool.submit([&runComponent, dependent] () { runComponent(dependent); });
+            }
+
+            remaining--;
+        };
+
+        for(uint32_t root : roots)
+            mThreadPool.submit([&runComponent, root] () { runComponent(root); });
+
+        mThreadPool.wait(remaining);
+    }
+
+    void SystemScheduler::parallelFor(size_t amount, size_t chunkSize, const std::function<void(size_t, size_t)>& function)
+    {
+        FEA_ASSERT(chunkSize > 0, "Trying to split work into chunks of size 0!");
+
+        if(amount <= chunkSize)
+        {
+            if(amount > 0)
+                function(0, amount);
+            return;
+        }
+
+        uint32_t chunkAmount = static_cast<uint32_t>((amount + chunkSize - 1) / chunkSize);
+        std::atomic<uint32_t> remaining(chunkAmount);
+
+        for(uint32_t i = 0; i < chunkAmount; i++)
+        {
+            size_t begin = i * chunkSize;
+            size_t end = std::min(begin + chunkSize, amount);
+
+            mThreadPool.submit([&function, &remaining, begin, end] ()
+            {
+                function(begin, end);
+                remaining--;
+            });
+        }
+
+        mThreadPool.wait(remaining);
+    }
+
+    ThreadPool& SystemScheduler::getThreadPool()
+    {
+        return mThreadPool;
+    }
+}
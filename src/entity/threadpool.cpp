@@ -0,0 +1,156 @@
+#include <fea/entity/threadpool.hpp>
+
+namespace fea
+{
+    ThreadPool::ThreadPool(uint32_t threadAmount) :
+        mPendingTasks(0),
+        mNextQueue(0),
+        mStopping(false)
+    {
+        if(threadAmount == 0)
+        {
+            uint32_t hardwareThreads = std::thread::hardware_concurrency();
+            threadAmount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+        }
+
+        //queue 0 belongs to threads which are not part of the pool
+        for(uint32_t i = 0; i < threadAmount + 1; i++)
+            mQueues.push_back(std::unique_ptr<TaskQueue>(new TaskQueue()));
+
+        mThreads.reserve(threadAmount);
+
+        for(uint32_t i = 0; i < threadAmount; i++)
+        {
+            mThreads.push_back(std::thread(&ThreadPool::workerLoop, this, i + 1));
+            mThreadIds.push_back(mThreads.back().get_id());
+        }
+    }
+
+    void ThreadPool::submit(Task task)
+    {
+        uint32_t queueIndex = getQueueIndex();
+
+        if(queueIndex == 0)
+            queueIndex = mNextQueue++ % static_cast<uint32_t>(mQueues.size());
+
+        mPendingTasks++;
+
+        {
+            std::lock_guard<std::mutex> lock(mQueues[queueIndex]->mMutex);
+            mQueues[queueIndex]->mTasks.push_back(std::move(task));
+        }
+
+        std::lock_guard<std::mutex> lock(mWakeMutex);
+        mWakeCondition.notify_one();
+    }
+
+    bool ThreadPool::runPendingTask()
+    {
+        uint32_t queueIndex = getQueueIndex();
+        Task task;
+
+        if(popOwnTask(queueIndex, task) || stealTask(queueIndex, task))
+        {
+            mPendingTasks--;
+            task();
+            return true;
+        }
+
+        return false;
+    }
+
+    void ThreadPool::wait(const std::atomic<uint32_t>& remaining)
+    {
+        while(remaining != 0)
+        {
+            if(!runPendingTask())
+                std::this_thread::yield();
+        }
+    }
+
+    uint32_t ThreadPool::getThreadAmount() const
+    {
+        return static_cast<uint32_t>(mThreads.size());
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mWakeMutex);
+            mStopping = true;
+            mWakeCondition.notify_all();
+        }
+
+        for(auto& thread : mThreads)
+            thread.join();
+
+        while(runPendingTask());
+    }
+
+    void ThreadPool::workerLoop(uint32_t queueIndex)
+    {
+        while(true)
+        {
+            Task task;
+
+            if(popOwnTask(queueIndex, task) || stealTask(queueIndex, task))
+            {
+                mPendingTasks--;
+                task();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(mWakeMutex);
+            mWakeCondition.wait(lock, [this] () { return mStopping || mPendingTasks != 0; });
+
+            if(mStopping && mPendingTasks == 0)
+                return;
+        }
+    }
+
+    uint32_t ThreadPool::getQueueIndex() const
+    {
+        std::thread::id current = std::this_thread::get_id();
+
+        for(uint32_t i = 0; i < mThreadIds.size(); i++)
+        {
+            if(mThreadIds[i] == current)
+                return i + 1;
+        }
+
+        return 0;
+    }
+
+    bool ThreadPool::popOwnTask(uint32_t queueIndex, Task& task)
+    {
+        TaskQueue& queue = *mQueues[queueIndex];
+        std::lock_guard<std::mutex> lock(queue.mMutex);
+
+        if(queue.mTasks.empty())
+            return false;
+
+        task = std::move(queue.mTasks.back());
+        queue.mTasks.pop_back();
+        return true;
+    }
+
+    bool ThreadPool::stealTask(uint32_t queueIndex, Task& task)
+    {
+        uint32_t queueAmount = static_cast<uint32_t>(mQueues.size());
+
+        for(uint32_t i = 1; i < queueAmount; i++)
+        {
+            TaskQueue& queue = *mQueues[(queueIndex + i) % queueAmount];
+            std::lock_guard<std::mutex> lock(queue.mMutex);
+
+            if(!queue.mTasks.empty())
+            {
+                task = std::move(queue.mTasks.front());
+                queue.mTasks.pop_front();
+                return true;
+            }
+        }
+
+        return false;
+    }
+}
@@ -112,4 +112,79 @@ void main()
     gl_FragColor = texture2D(texture, texCoords) * vec4(color, opacity) * vec4(vColor.rgb, 1.0);
 })";
 #endif
+
+#ifndef EMSCRIPTEN
+    std::string DefaultShader::instancedVertexSource = R"(#version 140
+uniform mat4 projection;
+uniform vec2 camZoom;
+uniform vec2 camPosition;
+uniform mat2 camRotation;
+uniform vec2 halfViewSize;
+
+uniform samplerBuffer instances;
+uniform float instanceOffset;
+
+in vec2 corner;
+
+out vec2 vTex;
+out vec4 vColor;
+out vec4 vConstraints;
+
+void main()
+{
+    //every instance is five texels: position and origin, size and rotation and opacity, color, texture rectangle, constraints
+    int base = (int(instanceOffset) + gl_InstanceID) * 5;
+    vec4 placement = texelFetch(instances, base);
+    vec4 transform = texelFetch(instances, base + 1);
+    vec4 color = texelFetch(instances, base + 2);
+    vec4 texRect = texelFetch(instances, base + 3);
+
+    float sinRot = sin(transform.z);
+    float cosRot = cos(transform.z);
+    mat2 rotMat = mat2(cosRot, -sinRot, sinRot, cosRot);
+
+    vec2 worldSpaceCoords = (rotMat * (transform.xy * corner - placement.zw)) + placement.xy;
+    vec2 transformedPoint = camRotation * (camZoom * (worldSpaceCoords - camPosition)) + halfViewSize;
+    gl_Position = projection * vec4(transformedPoint.xy, 0.0, 1.0);
+    vTex = mix(texRect.xy, texRect.zw, corner);
+    vColor = vec4(color.rgb, transform.w);
+    vConstraints = texelFetch(instances, base + 4);
+})";
+
+    std::string DefaultShader::instancedFragmentSource = R"(#version 140
+uniform sampler2D spriteTexture;
+uniform vec2 textureScroll;
+
+in vec2 vTex;
+in vec4 vColor;
+in vec4 vConstraints;
+
+out vec4 fragColor;
+
+float boundBetween(float val, float lowerBound, float upperBound)
+{
+    if(lowerBound > upperBound)
+    {
+        float temp = lowerBound;
+        lowerBound = upperBound;
+        upperBound = temp;
+    }
+    
+    val = val - lowerBound;
+    float rangeSize = upperBound - lowerBound;
+    if(rangeSize == 0.0)
+    {
+        return upperBound;
+    }
+    return val - (rangeSize * floor(val/rangeSize)) + lowerBound;
+}
+
+void main()
+{
+    vec2 constraintSize = abs(vec2(vConstraints[1] - vConstraints[0] , vConstraints[3] - vConstraints[2]));
+    vec2 texCoords = constraintSize * vTex.st + vec2(vConstraints[0], vConstraints[2]) - textureScroll;
+    texCoords = vec2(boundBetween(texCoords.s, vConstraints[0], vConstraints[1]), boundBetween(texCoords.t, vConstraints[2], vConstraints[3]));
+    fragColor = texture(spriteTexture, texCoords) * vColor;
+})";
+#endif
 }
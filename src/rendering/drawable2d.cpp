@@ -1,9 +1,10 @@
 #include <fea/rendering/drawable2d.hpp>
+#include <fea/rendering/shaderslots.hpp>
 #include <fea/assert.hpp>
 
 namespace fea
 {
-    Drawable2D::Drawable2D() : mDrawMode(0), mRotation(0.0f), mScaling(glm::vec2(1.0f, 1.0f)), mParallax(glm::vec2(1.0f, 1.0f)), mColor(1.0f, 1.0f, 1.0f, 1.0f)
+    Drawable2D::Drawable2D() : mDrawMode(0), mRotation(0.0f), mScaling(glm::vec2(1.0f, 1.0f)), mParallax(glm::vec2(1.0f, 1.0f)), mColor(1.0f, 1.0f, 1.0f, 1.0f), mStreaming(false)
     {
     }
 
@@ -98,6 +99,24 @@ namespace fea
         return mColor.aAsFloat();
     }
 
+    void Drawable2D::setStreaming(bool enabled)
+    {
+        //the buffers of the drawable are not updated while streaming
+        if(mStreaming && !enabled)
+        {
+            markVerticesDirty();
+            markTexCoordsDirty();
+            markVertexColorsDirty();
+        }
+
+        mStreaming = enabled;
+    }
+
+    bool Drawable2D::isStreaming() const
+    {
+        return mStreaming;
+    }
+
     std::vector<RenderEntity> Drawable2D::getRenderInfo() const
     {
         RenderEntity temp;
@@ -130,6 +149,63 @@ namespace fea
         return {temp};
     }
 
+    void Drawable2D::queueRenderInfo(DrawList& drawList) const
+    {
+        for(const auto& renderEntity : getRenderInfo())
+            drawList.addRenderEntity(renderEntity);
+    }
+
+    void Drawable2D::queueBaseRenderInfo(DrawList& drawList) const
+    {
+        drawList.addDraw(mDrawMode, mVertices.size() / 2);
+
+        if(mStreaming)
+        {
+            if(mVertices.size() > 0)
+                drawList.addStreamedVertexAttribute(ShaderSlots::VERTEX, 2, &mVertices[0], mVertices.size() / 2);
+            if(mTexCoords.size() > 0)
+                drawList.addStreamedVertexAttribute(ShaderSlots::TEX_COORDS, 2, &mTexCoords[0], mTexCoords.size() / 2);
+            if(mVertexColors.size() > 0)
+                drawList.addStreamedVertexAttribute(ShaderSlots::COLORS, 4, &mVertexColors[0], mVertexColors.size() / 4);
+        }
+        else
+        {
+            if(mVertices.size() > 0)
+                drawList.addVertexAttribute(ShaderSlots::VERTEX, 2, &mVertices[0], mVertexBuffer.update(mVertices));
+            if(mTexCoords.size() > 0)
+                drawList.addVertexAttribute(ShaderSlots::TEX_COORDS, 2, &mTexCoords[0], mTexCoordBuffer.update(mTexCoords));
+            if(mVertexColors.size() > 0)
+                drawList.addVertexAttribute(ShaderSlots::COLORS, 4, &mVertexColors[0], mVertexColorBuffer.update(mVertexColors));
+        }
+
+        drawList.addUniform(ShaderSlots::POSITION, mPosition);
+        drawList.addUniform(ShaderSlots::ORIGIN, mOrigin);
+        drawList.addUniform(ShaderSlots::ROTATION, mRotation);
+        drawList.addUniform(ShaderSlots::SCALING, mScaling);
+        drawList.addUniform(ShaderSlots::PARALLAX, mParallax);
+        drawList.addUniform(ShaderSlots::CONSTRAINTS, glm::vec4(0.0f, 1.0f, 0.0f, 1.0f));
+        drawList.addUniform(ShaderSlots::COLOR, glm::vec3(mColor.rAsFloat(), mColor.gAsFloat(), mColor.bAsFloat()));
+        drawList.addUniform(ShaderSlots::OPACITY, mColor.aAsFloat());
+
+        for(const auto& uniform : mExtraUniforms)
+            drawList.addUniform(uniform.second);
+    }
+
+    void Drawable2D::markVerticesDirty(size_t start, size_t end)
+    {
+        mVertexBuffer.markDirty(start, end);
+    }
+
+    void Drawable2D::markTexCoordsDirty(size_t start, size_t end)
+    {
+        mTexCoordBuffer.markDirty(start, end);
+    }
+
+    void Drawable2D::markVertexColorsDirty(size_t start, size_t end)
+    {
+        mVertexColorBuffer.markDirty(start, end);
+    }
+
     void Drawable2D::setExtraUniform(const Uniform& uniform)
     {
         mExtraUniforms[uniform.mName] = uniform;
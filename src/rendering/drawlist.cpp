@@ -0,0 +1,163 @@
+#include <fea/rendering/drawlist.hpp>
+#include <fea/rendering/shaderslots.hpp>
+#include <fea/assert.hpp>
+#include <cstring>
+
+namespace fea
+{
+    DrawList::DrawList() : mStreamBuffer(nullptr)
+    {
+    }
+
+    void DrawList::addDraw(GLenum drawMode, uint32_t elementAmount)
+    {
+        mDraws.push_back(Draw{drawMode, elementAmount, ALPHA, 0, static_cast<uint32_t>(mUniforms.size()), 0, static_cast<uint32_t>(mAttributes.size()), 0});
+    }
+
+    void DrawList::addUniform(uint32_t slot, float value)
+    {
+        addUniformData(slot, FLOAT, &value, 1);
+    }
+
+    void DrawList::addUniform(uint32_t slot, const glm::vec2& value)
+    {
+        addUniformData(slot, VEC2, &value[0], 2);
+    }
+
+    void DrawList::addUniform(uint32_t slot, const glm::vec3& value)
+    {
+        addUniformData(slot, VEC3, &value[0], 3);
+    }
+
+    void DrawList::addUniform(uint32_t slot, const glm::vec4& value)
+    {
+        addUniformData(slot, VEC4, &value[0], 4);
+    }
+
+    void DrawList::addUniform(uint32_t slot, const glm::mat2x2& value)
+    {
+        addUniformData(slot, MAT2X2, &value[0][0], 4);
+    }
+
+    void DrawList::addUniform(uint32_t slot, const glm::mat4x4& value)
+    {
+        addUniformData(slot, MAT4X4, &value[0][0], 16);
+    }
+
+    void DrawList::addTexture(uint32_t slot, GLuint texture)
+    {
+        //the texture ID is kept bit for bit among the floats, the same way Uniform stores it
+        float data;
+        static_assert(sizeof(data) == sizeof(texture), "Texture IDs must fit in a float");
+        std::memcpy(&data, &texture, sizeof(texture));
+        addUniformData(slot, TEXTURE, &data, 1);
+    }
+
+    void DrawList::addUniform(const Uniform& uniform)
+    {
+        addUniformData(ShaderSlots::get(uniform.mName), uniform.mType, &uniform.mFloatVal, Uniform::getFloatAmount(uniform.mType));
+    }
+
+    void DrawList::addVertexAttribute(uint32_t slot, uint32_t floatAmount, const float* data, GLuint buffer)
+    {
+        FEA_ASSERT(!mDraws.empty(), "Trying to add a vertex attribute to a draw list without draws!");
+        mAttributes.push_back(AttributeValue{slot, floatAmount, data, buffer, 0});
+        mDraws.back().mAttributeAmount++;
+    }
+
+    void DrawList::addStreamedVertexAttribute(uint32_t slot, uint32_t floatAmount, const float* data, size_t vertexAmount)
+    {
+        if(!mStreamBuffer)
+        {
+            addVertexAttribute(slot, floatAmount, data);
+            return;
+        }
+
+        FEA_ASSERT(!mDraws.empty(), "Trying to add a vertex attribute to a draw list without draws!");
+        StreamBuffer::Allocation allocation = mStreamBuffer->allocate(floatAmount * vertexAmount);
+        std::memcpy(allocation.mData, data, floatAmount * vertexAmount * sizeof(float));
+        //the data of the drawable is kept for batching, since mapped memory must not be read
+        mAttributes.push_back(AttributeValue{slot, floatAmount, data, allocation.mBuffer, allocation.mOffset});
+        mDraws.back().mAttributeAmount++;
+    }
+
+    float* DrawList::addTransientVertexAttribute(uint32_t slot, uint32_t floatAmount, size_t vertexAmount)
+    {
+        FEA_ASSERT(!mDraws.empty(), "Trying to add a vertex attribute to a draw list without draws!");
+        FEA_ASSERT(mStreamBuffer != nullptr, "Trying to add transient vertex data to a draw list without a stream buffer!");
+        StreamBuffer::Allocation allocation = mStreamBuffer->allocate(floatAmount * vertexAmount);
+        mAttributes.push_back(AttributeValue{slot, floatAmount, allocation.mBuffer ? nullptr : allocation.mData, allocation.mBuffer, allocation.mOffset});
+        mDraws.back().mAttributeAmount++;
+        return allocation.mData;
+    }
+
+    void DrawList::setStreamBuffer(StreamBuffer* streamBuffer)
+    {
+        mStreamBuffer = streamBuffer;
+    }
+
+    void DrawList::addRenderEntity(const RenderEntity& renderEntity)
+    {
+        addDraw(renderEntity.mDrawMode, renderEntity.mElementAmount);
+
+        for(const auto& uniform : renderEntity.mUniforms)
+            addUniform(uniform);
+
+        for(const auto& vertexAttribute : renderEntity.mVertexAttributes)
+            addVertexAttribute(ShaderSlots::get(vertexAttribute.mName), vertexAttribute.mFloatAmount, vertexAttribute.mData);
+    }
+
+    void DrawList::setBlendMode(size_t firstDraw, BlendMode mode)
+    {
+        for(size_t i = firstDraw; i < mDraws.size(); i++)
+            mDraws[i].mBlendMode = mode;
+    }
+
+    void DrawList::setLayer(size_t firstDraw, uint16_t layer)
+    {
+        for(size_t i = firstDraw; i < mDraws.size(); i++)
+            mDraws[i].mLayer = layer;
+    }
+
+    const std::vector<DrawList::Draw>& DrawList::getDraws() const
+    {
+        return mDraws;
+    }
+
+    const DrawList::UniformValue* DrawList::getUniforms(const Draw& draw) const
+    {
+        return mUniforms.data() + draw.mUniformStart;
+    }
+
+    const DrawList::AttributeValue* DrawList::getVertexAttributes(const Draw& draw) const
+    {
+        return mAttributes.data() + draw.mAttributeStart;
+    }
+
+    const void* DrawList::getUniformData(const UniformValue& uniform) const
+    {
+        return mUniformData.data() + uniform.mOffset;
+    }
+
+    size_t DrawList::getDrawAmount() const
+    {
+        return mDraws.size();
+    }
+
+    void DrawList::clear()
+    {
+        mDraws.clear();
+        mUniforms.clear();
+        mAttributes.clear();
+        mUniformData.clear();
+    }
+
+    void DrawList::addUniformData(uint32_t slot, UniformType type, const float* data, uint32_t floatAmount)
+    {
+        FEA_ASSERT(!mDraws.empty(), "Trying to add a uniform to a draw list without draws!");
+        FEA_ASSERT(type != NO_TYPE, "Trying to add a null uniform to a draw list!");
+        mUniforms.push_back(UniformValue{slot, type, static_cast<uint32_t>(mUniformData.size())});
+        mUniformData.insert(mUniformData.end(), data, data + floatAmount);
+        mDraws.back().mUniformAmount++;
+    }
+}
@@ -1,4 +1,5 @@
 #include <fea/rendering/quad.hpp>
+#include <fea/rendering/shaderslots.hpp>
 #include <fea/assert.hpp>
 
 namespace fea
@@ -54,6 +55,7 @@ namespace fea
                      xnum, 0.0f, 
                      0.0f, ynum, 
                      xnum, ynum};
+        markVerticesDirty();
     }
 
     glm::vec2 Quad::getSize() const
@@ -89,6 +91,7 @@ namespace fea
                       texCoordsX[1], texCoordsY[1]};
                       
                       //Make nice
+        markTexCoordsDirty();
     }
 
     void Quad::setVFlip(bool enabled)
@@ -107,6 +110,7 @@ namespace fea
                       texCoordsX[1], texCoordsY[0],
                       texCoordsX[0], texCoordsY[1],
                       texCoordsX[1], texCoordsY[1]};
+        markTexCoordsDirty();
     }
     
     std::vector<RenderEntity> Quad::getRenderInfo() const
@@ -122,4 +126,16 @@ namespace fea
         
         return temp;
     }
+
+    void Quad::queueRenderInfo(DrawList& drawList) const
+    {
+        queueBaseRenderInfo(drawList);
+
+        if(mTexture != nullptr)
+        {
+            drawList.addTexture(ShaderSlots::TEXTURE, getTexture().getId());
+        }
+
+        drawList.addUniform(ShaderSlots::CONSTRAINTS, mConstraints);
+    }
 }
@@ -3,13 +3,340 @@
 #include <fea/rendering/drawable2d.hpp>
 #include <fea/rendering/projection.hpp>
 #include <fea/rendering/defaultshader.hpp>
+#include <fea/rendering/shaderslots.hpp>
 #include <fea/assert.hpp>
 #include <sstream>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <cstdio>
+
+namespace
+{
+    struct BatchedDraw
+    {
+        glm::vec2 mPosition;
+        glm::vec2 mOrigin;
+        float mRotation;
+        glm::vec2 mScaling;
+        glm::vec2 mParallax;
+        glm::vec3 mColor;
+        GLuint mTexture;
+        const float* mVertices;
+        const float* mTexCoords;
+        const float* mColors;
+    };
+
+    //uniforms which are applied to the vertices of a batch instead of being sent to the shader
+    bool isBatchedUniform(uint32_t slot)
+    {
+        return slot == fea::ShaderSlots::POSITION || slot == fea::ShaderSlots::ORIGIN || slot == fea::ShaderSlots::ROTATION || slot == fea::ShaderSlots::SCALING || slot == fea::ShaderSlots::PARALLAX || slot == fea::ShaderSlots::COLOR || slot == fea::ShaderSlots::TEXTURE;
+    }
+
+    bool readBatchedDraw(const fea::DrawList& drawList, const fea::DrawList::Draw& draw, GLuint defaultTextureId, BatchedDraw& result)
+    {
+        if(draw.mDrawMode != GL_TRIANGLES)
+            return false;
+
+        result = BatchedDraw{glm::vec2(0.0f, 0.0f), glm::vec2(0.0f, 0.0f), 0.0f, glm::vec2(1.0f, 1.0f), glm::vec2(1.0f, 1.0f), glm::vec3(1.0f, 1.0f, 1.0f), defaultTextureId, nullptr, nullptr, nullptr};
+
+        const fea::DrawList::AttributeValue* vertexAttributes = drawList.getVertexAttributes(draw);
+        for(uint32_t i = 0; i < draw.mAttributeAmount; i++)
+        {
+            const fea::DrawList::AttributeValue& attribute = vertexAttributes[i];
+
+            if(attribute.mSlot == fea::ShaderSlots::VERTEX && attribute.mFloatAmount == 2)
+                result.mVertices = attribute.mData;
+            else if(attribute.mSlot == fea::ShaderSlots::TEX_COORDS && attribute.mFloatAmount == 2)
+                result.mTexCoords = attribute.mData;
+            else if(attribute.mSlot == fea::ShaderSlots::COLORS && attribute.mFloatAmount == 4)
+                result.mColors = attribute.mData;
+            else
+                return false;
+        }
+
+        if(!result.mVertices || !result.mTexCoords || !result.mColors)
+            return false;
+
+        const fea::DrawList::UniformValue* uniforms = drawList.getUniforms(draw);
+        for(uint32_t i = 0; i < draw.mUniformAmount; i++)
+        {
+            const fea::DrawList::UniformValue& uniform = uniforms[i];
+            const float* data = static_cast<const float*>(drawList.getUniformData(uniform));
+
+            switch(uniform.mSlot)
+            {
+                case fea::ShaderSlots::POSITION:
+                    if(uniform.mType != fea::VEC2)
+                        return false;
+                    result.mPosition = glm::vec2(data[0], data[1]);
+                    break;
+                case fea::ShaderSlots::ORIGIN:
+                    if(uniform.mType != fea::VEC2)
+                        return false;
+                    result.mOrigin = glm::vec2(data[0], data[1]);
+                    break;
+                case fea::ShaderSlots::ROTATION:
+                    if(uniform.mType != fea::FLOAT)
+                        return false;
+                    result.mRotation = data[0];
+                    break;
+                case fea::ShaderSlots::SCALING:
+                    if(uniform.mType != fea::VEC2)
+                        return false;
+                    result.mScaling = glm::vec2(data[0], data[1]);
+                    break;
+                case fea::ShaderSlots::PARALLAX:
+                    if(uniform.mType != fea::VEC2)
+                        return false;
+                    result.mParallax = glm::vec2(data[0], data[1]);
+                    break;
+                case fea::ShaderSlots::COLOR:
+                    if(uniform.mType != fea::VEC3)
+                        return false;
+                    result.mColor = glm::vec3(data[0], data[1], data[2]);
+                    break;
+                case fea::ShaderSlots::TEXTURE:
+                    if(uniform.mType != fea::TEXTURE)
+                        return false;
+                    std::memcpy(&result.mTexture, data, sizeof(GLuint));
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        return true;
+    }
+
+    bool haveSameUniforms(const fea::DrawList& drawList, const fea::DrawList::Draw& a, const fea::DrawList::Draw& b, bool (*isSkipped)(uint32_t))
+    {
+        const fea::DrawList::UniformValue* uniformsA = drawList.getUniforms(a);
+        const fea::DrawList::UniformValue* uniformsB = drawList.getUniforms(b);
+        uint32_t i = 0;
+        uint32_t j = 0;
+
+        while(true)
+        {
+            while(i < a.mUniformAmount && isSkipped(uniformsA[i].mSlot))
+                i++;
+            while(j < b.mUniformAmount && isSkipped(uniformsB[j].mSlot))
+                j++;
+
+            if(i == a.mUniformAmount || j == b.mUniformAmount)
+                return i == a.mUniformAmount && j == b.mUniformAmount;
+
+            if(uniformsA[i].mSlot != uniformsB[j].mSlot || uniformsA[i].mType != uniformsB[j].mType)
+                return false;
+
+            if(std::memcmp(drawList.getUniformData(uniformsA[i]), drawList.getUniformData(uniformsB[j]), fea::Uniform::getFloatAmount(uniformsA[i].mType) * sizeof(float)) != 0)
+                return false;
+
+            i++;
+            j++;
+        }
+    }
+
+#ifndef EMSCRIPTEN
+    struct InstancedDraw
+    {
+        BatchedDraw mBase;
+        glm::vec2 mSize;
+        glm::vec4 mTexRect;
+        glm::vec3 mVertexColor;
+        float mOpacity;
+        glm::vec4 mConstraints;
+    };
+
+    const uint32_t instanceFloatAmount = 20;
+
+    //parses version strings such as "3.1.0 vendor info" or "1.40"
+    bool isVersionAtLeast(const GLubyte* version, int major, int minor)
+    {
+        int versionMajor = 0;
+        int versionMinor = 0;
+
+        if(!version || std::sscanf(reinterpret_cast<const char*>(version), "%d.%d", &versionMajor, &versionMinor) != 2)
+            return false;
+
+        return versionMajor > major || (versionMajor == major && versionMinor >= minor);
+    }
+
+    //uniforms which are packed into the instance buffer instead of being sent to the shader
+    bool isInstancedUniform(uint32_t slot)
+    {
+        return isBatchedUniform(slot) || slot == fea::ShaderSlots::OPACITY || slot == fea::ShaderSlots::CONSTRAINTS;
+    }
+
+    //the six corners of the two triangles of a quad, in the order the built in quads use
+    bool isQuadLayout(const float* values, float x0, float y0, float x1, float y1)
+    {
+        const float expected[12] = {x0, y0, x0, y1, x1, y0, x1, y0, x0, y1, x1, y1};
+
+        for(uint32_t i = 0; i < 12; i++)
+        {
+            if(values[i] != expected[i])
+                return false;
+        }
+
+        return true;
+    }
+
+    bool readInstancedDraw(const fea::DrawList& drawList, const fea::DrawList::Draw& draw, GLuint defaultTextureId, const fea::Shader& shader, InstancedDraw& result)
+    {
+        if(draw.mElementAmount != 6 || !readBatchedDraw(drawList, draw, defaultTextureId, result.mBase))
+            return false;
+
+        //only quads starting at the origin can be rebuilt from their size
+        const float* vertices = result.mBase.mVertices;
+        const float* texCoords = result.mBase.mTexCoords;
+        const float* colors = result.mBase.mColors;
+
+        if(!isQuadLayout(vertices, 0.0f, 0.0f, vertices[10], vertices[11]) || !isQuadLayout(texCoords, texCoords[0], texCoords[1], texCoords[10], texCoords[11]))
+            return false;
+
+        for(uint32_t i = 1; i < 6; i++)
+        {
+            if(std::memcmp(colors, colors + i * 4, 4 * sizeof(float)) != 0)
+                return false;
+        }
+
+        result.mSize = glm::vec2(vertices[10], vertices[11]);
+        result.mTexRect = glm::vec4(texCoords[0], texCoords[1], texCoords[10], texCoords[11]);
+        result.mVertexColor = glm::vec3(colors[0], colors[1], colors[2]);
+        result.mOpacity = 1.0f;
+        result.mConstraints = glm::vec4(0.0f, 1.0f, 0.0f, 1.0f);
+
+        const fea::DrawList::UniformValue* uniforms = drawList.getUniforms(draw);
+        for(uint32_t i = 0; i < draw.mUniformAmount; i++)
+        {
+            const fea::DrawList::UniformValue& uniform = uniforms[i];
+            const float* data = static_cast<const float*>(drawList.getUniformData(uniform));
+
+            if(uniform.mSlot == fea::ShaderSlots::OPACITY)
+            {
+                if(uniform.mType != fea::FLOAT)
+                    return false;
+                result.mOpacity = data[0];
+            }
+            else if(uniform.mSlot == fea::ShaderSlots::CONSTRAINTS)
+            {
+                if(uniform.mType != fea::VEC4)
+                    return false;
+                result.mConstraints = glm::vec4(data[0], data[1], data[2], data[3]);
+            }
+            else if(!isInstancedUniform(uniform.mSlot) && !shader.hasUniform(uniform.mSlot))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void appendInstance(const InstancedDraw& draw, const glm::vec2& camPosition, std::vector<float>& data)
+    {
+        //same layout as read by the instanced default shader. the parallax is folded into the position like when batching
+        const BatchedDraw& base = draw.mBase;
+        glm::vec2 position = base.mPosition - camPosition * (base.mParallax - glm::vec2(1.0f, 1.0f));
+        glm::vec2 size = base.mScaling * draw.mSize;
+
+        const float values[instanceFloatAmount] =
+        {
+            position.x, position.y, base.mOrigin.x, base.mOrigin.y,
+            size.x, size.y, base.mRotation, draw.mOpacity,
+            base.mColor.x * draw.mVertexColor.x, base.mColor.y * draw.mVertexColor.y, base.mColor.z * draw.mVertexColor.z, 1.0f,
+            draw.mTexRect.x, draw.mTexRect.y, draw.mTexRect.z, draw.mTexRect.w,
+            draw.mConstraints.x, draw.mConstraints.y, draw.mConstraints.z, draw.mConstraints.w
+        };
+
+        data.insert(data.end(), values, values + instanceFloatAmount);
+    }
+#endif
+
+    //stable least significant byte first radix sort, moving the values along with their keys
+    void radixSort(std::vector<uint64_t>& keys, std::vector<uint32_t>& values, std::vector<uint64_t>& keyBuffer, std::vector<uint32_t>& valueBuffer)
+    {
+        if(keys.empty())
+            return;
+
+        keyBuffer.resize(keys.size());
+        valueBuffer.resize(values.size());
+
+        for(uint32_t shift = 0; shift < 64; shift += 8)
+        {
+            size_t counts[256] = {};
+
+            for(uint64_t key : keys)
+                counts[(key >> shift) & 0xff]++;
+
+            //a byte which is the same in every key does not change the order
+            if(counts[(keys[0] >> shift) & 0xff] == keys.size())
+                continue;
+
+            size_t offset = 0;
+            for(size_t& count : counts)
+            {
+                size_t amount = count;
+                count = offset;
+                offset += amount;
+            }
+
+            for(size_t i = 0; i < keys.size(); i++)
+            {
+                size_t destination = counts[(keys[i] >> shift) & 0xff]++;
+                keyBuffer[destination] = keys[i];
+                valueBuffer[destination] = values[i];
+            }
+
+            keys.swap(keyBuffer);
+            values.swap(valueBuffer);
+        }
+    }
+
+    void appendBatchedDraw(const BatchedDraw& draw, uint32_t elementAmount, const glm::vec2& camPosition, std::vector<float>& vertices, std::vector<float>& texCoords, std::vector<float>& colors)
+    {
+        //same transform as the default shader. the parallax is folded into the position so that the batch can be drawn with a parallax of one
+        float sinRot = std::sin(draw.mRotation);
+        float cosRot = std::cos(draw.mRotation);
+        glm::vec2 offset = draw.mPosition - camPosition * (draw.mParallax - glm::vec2(1.0f, 1.0f));
+
+        for(uint32_t i = 0; i < elementAmount; i++)
+        {
+            glm::vec2 local = draw.mScaling * glm::vec2(draw.mVertices[i * 2], draw.mVertices[i * 2 + 1]) - draw.mOrigin;
+            vertices.push_back(cosRot * local.x + sinRot * local.y + offset.x);
+            vertices.push_back(-sinRot * local.x + cosRot * local.y + offset.y);
+
+            texCoords.push_back(draw.mTexCoords[i * 2]);
+            texCoords.push_back(draw.mTexCoords[i * 2 + 1]);
+
+            colors.push_back(draw.mColors[i * 4] * draw.mColor.x);
+            colors.push_back(draw.mColors[i * 4 + 1] * draw.mColor.y);
+            colors.push_back(draw.mColors[i * 4 + 2] * draw.mColor.z);
+            colors.push_back(draw.mColors[i * 4 + 3]);
+        }
+    }
+}
 
 namespace fea
 {
-    Renderer2D::Renderer2D(const Viewport& v) : mCurrentViewport(v), mCurrentBlendMode(ALPHA)
+    RenderStats::RenderStats() : mDrawAmount(0), mDrawCallAmount(0), mBatchAmount(0), mInstanceAmount(0)
+    {
+        for(uint32_t i = 0; i < BATCH_BREAK_AMOUNT; i++)
+            mBatchBreaks[i] = 0;
+    }
+
+    Renderer2D::Renderer2D(const Viewport& v) : mCurrentViewport(v), mCurrentBlendMode(ALPHA), mBatching(false), mSorting(false), mInstancing(false), mInstancingChecked(false), mInstancingSupported(false), mCurrentLayer(0), mGlBlendMode(ALPHA), mGlBlendModeSet(false), mInstanceBuffer(0), mInstanceBufferSize(0), mInstanceTexture(0), mMaxInstances(0), mSpriteTextureSlot(0), mInstancesSlot(0), mInstanceOffsetSlot(0), mCornerSlot(0)
+    {
+        mRenderQueue.setStreamBuffer(&mStreamBuffer);
+    }
+
+    Renderer2D::~Renderer2D()
     {
+        if(mInstanceTexture)
+            glDeleteTextures(1, &mInstanceTexture);
+        if(mInstanceBuffer)
+            glDeleteBuffers(1, &mInstanceBuffer);
     }
     
     void Renderer2D::setup()
@@ -29,6 +356,10 @@ namespace fea
         mDefaultShader.setSource(DefaultShader::vertexSource, DefaultShader::fragmentSource);
         mDefaultShader.compile();
 
+        //the instanced shader is only set up once instancing is used, since the context may be too old for it
+        mInstancingChecked = false;
+        mInstancingSupported = false;
+
         setViewport(mCurrentViewport);
     }
 
@@ -58,10 +389,10 @@ namespace fea
     
     void Renderer2D::queue(const Drawable2D& drawable)
     {
-        for(const auto& renderEntity : drawable.getRenderInfo())
-            mRenderQueue.push_back(renderEntity);
-
-        mRenderQueue.back().mBlendMode = mCurrentBlendMode;
+        size_t firstDraw = mRenderQueue.getDrawAmount();
+        drawable.queueRenderInfo(mRenderQueue);
+        mRenderQueue.setBlendMode(firstDraw, mCurrentBlendMode);
+        mRenderQueue.setLayer(firstDraw, mCurrentLayer);
     }
 
     void Renderer2D::render()
@@ -77,38 +408,42 @@ namespace fea
     void Renderer2D::render(const Shader& shader)
     {
         shader.activate();
-
-        shader.setUniform("camPosition", VEC2, &mCurrentViewport.getCamera().getPosition());
-        shader.setUniform("camZoom", VEC2, &mCurrentViewport.getCamera().getZoom());
-        glm::mat2x2 camRot = mCurrentViewport.getCamera().getRotationMatrix();
-        shader.setUniform("camRotation", MAT2X2, &camRot);
-        glm::vec2 halfViewSize = glm::vec2((float)mCurrentViewport.getSize().x / 2.0f, (float)mCurrentViewport.getSize().y / 2.0f);
-        shader.setUniform("halfViewSize", VEC2, &halfViewSize);
-        shader.setUniform("projection", MAT4X4, &mProjection);
+        setCameraUniforms(shader);
 
         GLuint defaultTextureId = mDefaultTexture.getId();
 
-        for(auto& renderOperation : mRenderQueue)
-        {
-            shader.setUniform("texture", TEXTURE, &defaultTextureId); //may be overriden
-            setBlendModeGl(renderOperation.mBlendMode);
+        mStats = RenderStats();
+        mStats.mDrawAmount = static_cast<uint32_t>(mRenderQueue.getDrawAmount());
+        //the blend function may have been changed outside of the renderer
+        mGlBlendModeSet = false;
 
-            for(auto& uniform : renderOperation.mUniforms)
-            {
-                shader.setUniform(uniform.mName, uniform.mType, &uniform.mFloatVal);
-            }
-            
-            for(auto& vertexAttribute : renderOperation.mVertexAttributes)
-            {
-                shader.setVertexAttribute(vertexAttribute.mName, vertexAttribute.mFloatAmount, vertexAttribute.mData);
-            }
+        //the streamed vertex data must be unmapped before it is drawn from
+        mStreamBuffer.unmap();
+
+        if(mSorting)
+            sortQueue(defaultTextureId);
 
-            glDrawArrays(renderOperation.mDrawMode, 0, renderOperation.mElementAmount);
+#ifndef EMSCRIPTEN
+        if(mInstancing && &shader == &mDefaultShader && setupInstancing())
+        {
+            renderInstanced(shader, defaultTextureId);
+        }
+        else
+#endif
+        if(mBatching)
+        {
+            renderBatched(shader, defaultTextureId);
+        }
+        else
+        {
+            for(size_t i = 0; i < mRenderQueue.getDrawAmount(); i++)
+                renderDraw(shader, getQueuedDraw(i), defaultTextureId);
         }
 
         setBlendMode(ALPHA);
         shader.deactivate();
         mRenderQueue.clear();
+        mStreamBuffer.endRegion();
     }
 
     void Renderer2D::render(const RenderTarget& target, const Shader& shader)
@@ -139,8 +474,70 @@ namespace fea
         mCurrentBlendMode = mode;
     }
     
+    void Renderer2D::setBatching(bool enabled)
+    {
+        mBatching = enabled;
+    }
+
+    bool Renderer2D::isBatching() const
+    {
+        return mBatching;
+    }
+
+    void Renderer2D::setSorting(bool enabled)
+    {
+        mSorting = enabled;
+    }
+
+    bool Renderer2D::isSorting() const
+    {
+        return mSorting;
+    }
+
+    void Renderer2D::setInstancing(bool enabled)
+    {
+        mInstancing = enabled;
+    }
+
+    bool Renderer2D::isInstancing() const
+    {
+        return mInstancing;
+    }
+
+    void Renderer2D::setLayer(uint16_t layer)
+    {
+        mCurrentLayer = layer;
+    }
+
+    uint16_t Renderer2D::getLayer() const
+    {
+        return mCurrentLayer;
+    }
+
+    const RenderStats& Renderer2D::getRenderStats() const
+    {
+        return mStats;
+    }
+
+    void Renderer2D::setCameraUniforms(const Shader& shader)
+    {
+        shader.setUniform(ShaderSlots::CAM_POSITION, VEC2, &mCurrentViewport.getCamera().getPosition());
+        shader.setUniform(ShaderSlots::CAM_ZOOM, VEC2, &mCurrentViewport.getCamera().getZoom());
+        glm::mat2x2 camRot = mCurrentViewport.getCamera().getRotationMatrix();
+        shader.setUniform(ShaderSlots::CAM_ROTATION, MAT2X2, &camRot);
+        glm::vec2 halfViewSize = glm::vec2((float)mCurrentViewport.getSize().x / 2.0f, (float)mCurrentViewport.getSize().y / 2.0f);
+        shader.setUniform(ShaderSlots::HALF_VIEW_SIZE, VEC2, &halfViewSize);
+        shader.setUniform(ShaderSlots::PROJECTION, MAT4X4, &mProjection);
+    }
+
     void Renderer2D::setBlendModeGl(BlendMode mode)
     {
+        if(mGlBlendModeSet && mGlBlendMode == mode)
+            return;
+
+        mGlBlendMode = mode;
+        mGlBlendModeSet = true;
+
         switch(mode)
         {
             case NONE:
@@ -163,4 +560,315 @@ namespace fea
                 break;
         }
     }
+
+    void Renderer2D::renderDraw(const Shader& shader, const DrawList::Draw& draw, GLuint defaultTextureId)
+    {
+        setBlendModeGl(draw.mBlendMode);
+
+        const DrawList::UniformValue* uniforms = mRenderQueue.getUniforms(draw);
+        bool hasTexture = false;
+        for(uint32_t i = 0; i < draw.mUniformAmount; i++)
+        {
+            hasTexture = hasTexture || uniforms[i].mSlot == ShaderSlots::TEXTURE;
+            shader.setUniform(uniforms[i].mSlot, uniforms[i].mType, mRenderQueue.getUniformData(uniforms[i]));
+        }
+
+        if(!hasTexture)
+            shader.setUniform(ShaderSlots::TEXTURE, TEXTURE, &defaultTextureId);
+        
+        const DrawList::AttributeValue* vertexAttributes = mRenderQueue.getVertexAttributes(draw);
+        for(uint32_t i = 0; i < draw.mAttributeAmount; i++)
+        {
+            if(vertexAttributes[i].mBuffer)
+                shader.setVertexBuffer(vertexAttributes[i].mSlot, vertexAttributes[i].mFloatAmount, vertexAttributes[i].mBuffer, vertexAttributes[i].mOffset);
+            else
+                shader.setVertexAttribute(vertexAttributes[i].mSlot, vertexAttributes[i].mFloatAmount, vertexAttributes[i].mData);
+        }
+
+        glDrawArrays(draw.mDrawMode, 0, draw.mElementAmount);
+        mStats.mDrawCallAmount++;
+    }
+
+    void Renderer2D::renderBatched(const Shader& shader, GLuint defaultTextureId)
+    {
+        size_t drawAmount = mRenderQueue.getDrawAmount();
+        glm::vec2 camPosition = mCurrentViewport.getCamera().getPosition();
+        BatchedDraw first;
+        BatchedDraw next;
+        size_t start = 0;
+
+        while(start < drawAmount)
+        {
+            if(!readBatchedDraw(mRenderQueue, getQueuedDraw(start), defaultTextureId, first))
+            {
+                renderDraw(shader, getQueuedDraw(start), defaultTextureId);
+                start++;
+                continue;
+            }
+
+            mBatchVertices.clear();
+            mBatchTexCoords.clear();
+            mBatchColors.clear();
+            const DrawList::Draw& batch = getQueuedDraw(start);
+            appendBatchedDraw(first, batch.mElementAmount, camPosition, mBatchVertices, mBatchTexCoords, mBatchColors);
+
+            size_t end = start + 1;
+            for(; end < drawAmount; end++)
+            {
+                const DrawList::Draw& draw = getQueuedDraw(end);
+                BatchBreak reason;
+
+                if(!readBatchedDraw(mRenderQueue, draw, defaultTextureId, next))
+                    reason = UNBATCHABLE_DRAW;
+                else if(next.mTexture != first.mTexture)
+                    reason = TEXTURE_CHANGE;
+                else if(draw.mBlendMode != batch.mBlendMode)
+                    reason = BLEND_MODE_CHANGE;
+                else if(!haveSameUniforms(mRenderQueue, batch, draw, isBatchedUniform))
+                    reason = UNIFORM_CHANGE;
+                else
+                {
+                    appendBatchedDraw(next, draw.mElementAmount, camPosition, mBatchVertices, mBatchTexCoords, mBatchColors);
+                    continue;
+                }
+
+                mStats.mBatchBreaks[reason]++;
+                break;
+            }
+
+            setBlendModeGl(batch.mBlendMode);
+            shader.setUniform(ShaderSlots::TEXTURE, TEXTURE, &first.mTexture);
+
+            const DrawList::UniformValue* uniforms = mRenderQueue.getUniforms(batch);
+            for(uint32_t i = 0; i < batch.mUniformAmount; i++)
+            {
+                if(!isBatchedUniform(uniforms[i].mSlot))
+                    shader.setUniform(uniforms[i].mSlot, uniforms[i].mType, mRenderQueue.getUniformData(uniforms[i]));
+            }
+
+            //the vertices are already transformed
+            glm::vec2 zero(0.0f, 0.0f);
+            glm::vec2 one(1.0f, 1.0f);
+            glm::vec3 white(1.0f, 1.0f, 1.0f);
+            float rotation = 0.0f;
+            shader.setUniform(ShaderSlots::POSITION, VEC2, &zero);
+            shader.setUniform(ShaderSlots::ORIGIN, VEC2, &zero);
+            shader.setUniform(ShaderSlots::ROTATION, FLOAT, &rotation);
+            shader.setUniform(ShaderSlots::SCALING, VEC2, &one);
+            shader.setUniform(ShaderSlots::PARALLAX, VEC2, &one);
+            shader.setUniform(ShaderSlots::COLOR, VEC3, &white);
+
+            shader.setVertexAttribute(ShaderSlots::VERTEX, 2, mBatchVertices.data());
+            shader.setVertexAttribute(ShaderSlots::TEX_COORDS, 2, mBatchTexCoords.data());
+            shader.setVertexAttribute(ShaderSlots::COLORS, 4, mBatchColors.data());
+
+            glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(mBatchVertices.size() / 2));
+            mStats.mDrawCallAmount++;
+            mStats.mBatchAmount++;
+            start = end;
+        }
+    }
+
+#ifndef EMSCRIPTEN
+    bool Renderer2D::setupInstancing()
+    {
+        if(mInstancingChecked)
+            return mInstancingSupported;
+
+        mInstancingChecked = true;
+
+        //buffer textures and instanced draws need GL 3.1 and the instanced shader is written in GLSL 1.40. on older contexts, draws are rendered as without instancing
+        if(!isVersionAtLeast(glGetString(GL_VERSION), 3, 1) || !isVersionAtLeast(glGetString(GL_SHADING_LANGUAGE_VERSION), 1, 40))
+            return false;
+
+        //GL 3.2 has no per instance vertex attributes, so the instance data is read from a buffer texture by instance ID
+        mInstancedShader.setSource(DefaultShader::instancedVertexSource, DefaultShader::instancedFragmentSource);
+        mInstancedShader.compile();
+        mSpriteTextureSlot = ShaderSlots::get("spriteTexture");
+        mInstancesSlot = ShaderSlots::get("instances");
+        mInstanceOffsetSlot = ShaderSlots::get("instanceOffset");
+        mCornerSlot = ShaderSlots::get("corner");
+
+        if(!mInstanceTexture)
+            glGenTextures(1, &mInstanceTexture);
+
+        GLint maxTexels = 0;
+        glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &maxTexels);
+        mMaxInstances = static_cast<uint32_t>(maxTexels) / (instanceFloatAmount / 4);
+        mInstanceCorners = {0.0f, 0.0f,
+                            0.0f, 1.0f,
+                            1.0f, 0.0f,
+                            1.0f, 0.0f,
+                            0.0f, 1.0f,
+                            1.0f, 1.0f};
+
+        mInstancingSupported = true;
+        return true;
+    }
+
+    void Renderer2D::renderInstanced(const Shader& shader, GLuint defaultTextureId)
+    {
+        size_t drawAmount = mRenderQueue.getDrawAmount();
+        glm::vec2 camPosition = mCurrentViewport.getCamera().getPosition();
+        InstancedDraw first;
+        InstancedDraw next;
+        uint32_t instanceAmount = 0;
+        size_t start = 0;
+
+        mInstanceRuns.clear();
+        mInstanceData.clear();
+
+        //first gather all instances so that the instance buffer is uploaded once
+        while(start < drawAmount)
+        {
+            const DrawList::Draw& batch = getQueuedDraw(start);
+
+            if(instanceAmount == mMaxInstances || !readInstancedDraw(mRenderQueue, batch, defaultTextureId, mInstancedShader, first))
+            {
+                mInstanceRuns.push_back(InstanceRun{static_cast<uint32_t>(start), 1, 0, 0, false});
+                start++;
+                continue;
+            }
+
+            appendInstance(first, camPosition, mInstanceData);
+
+            size_t end = start + 1;
+            for(; end < drawAmount && instanceAmount + (end - start) < mMaxInstances; end++)
+            {
+                const DrawList::Draw& draw = getQueuedDraw(end);
+                BatchBreak reason;
+
+                if(!readInstancedDraw(mRenderQueue, draw, defaultTextureId, mInstancedShader, next))
+                    reason = UNBATCHABLE_DRAW;
+                else if(next.mBase.mTexture != first.mBase.mTexture)
+                    reason = TEXTURE_CHANGE;
+                else if(draw.mBlendMode != batch.mBlendMode)
+                    reason = BLEND_MODE_CHANGE;
+                else if(!haveSameUniforms(mRenderQueue, batch, draw, isInstancedUniform))
+                    reason = UNIFORM_CHANGE;
+                else
+                {
+                    appendInstance(next, camPosition, mInstanceData);
+                    continue;
+                }
+
+                mStats.mBatchBreaks[reason]++;
+                break;
+            }
+
+            mInstanceRuns.push_back(InstanceRun{static_cast<uint32_t>(start), static_cast<uint32_t>(end - start), instanceAmount, first.mBase.mTexture, true});
+            instanceAmount += static_cast<uint32_t>(end - start);
+            start = end;
+        }
+
+        if(instanceAmount > 0)
+        {
+            bool created = mInstanceBuffer == 0;
+            size_t dataSize = mInstanceData.size() * sizeof(float);
+            mInstanceBufferSize = std::max(mInstanceBufferSize, dataSize);
+
+            if(created)
+                glGenBuffers(1, &mInstanceBuffer);
+
+            //the previous render may still be drawing from the buffer, so its storage is orphaned instead of overwritten to not wait for the GPU
+            glBindBuffer(GL_TEXTURE_BUFFER, mInstanceBuffer);
+            glBufferData(GL_TEXTURE_BUFFER, (GLsizeiptr)mInstanceBufferSize, nullptr, GL_STREAM_DRAW);
+            glBufferSubData(GL_TEXTURE_BUFFER, 0, (GLsizeiptr)dataSize, mInstanceData.data());
+            glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+            //the texture refers to the buffer object, so it sees the new storage without being attached again
+            if(created)
+            {
+                glBindTexture(GL_TEXTURE_BUFFER, mInstanceTexture);
+                glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, mInstanceBuffer);
+                glBindTexture(GL_TEXTURE_BUFFER, 0);
+            }
+        }
+
+        bool instancedActive = false;
+
+        for(const InstanceRun& run : mInstanceRuns)
+        {
+            const DrawList::Draw& batch = getQueuedDraw(run.mStart);
+
+            if(!run.mInstanced)
+            {
+                if(instancedActive)
+                {
+                    mInstancedShader.deactivate();
+                    shader.activate();
+                    instancedActive = false;
+                }
+
+                renderDraw(shader, batch, defaultTextureId);
+                continue;
+            }
+
+            if(!instancedActive)
+            {
+                shader.deactivate();
+                mInstancedShader.activate();
+                setCameraUniforms(mInstancedShader);
+                mInstancedShader.setTextureBuffer(mInstancesSlot, 1, mInstanceTexture);
+                mInstancedShader.setVertexBuffer(mCornerSlot, 2, mInstanceCornerBuffer.update(mInstanceCorners));
+                instancedActive = true;
+            }
+
+            setBlendModeGl(batch.mBlendMode);
+            mInstancedShader.setUniform(mSpriteTextureSlot, TEXTURE, &run.mTexture);
+
+            const DrawList::UniformValue* uniforms = mRenderQueue.getUniforms(batch);
+            for(uint32_t i = 0; i < batch.mUniformAmount; i++)
+            {
+                if(!isInstancedUniform(uniforms[i].mSlot))
+                    mInstancedShader.setUniform(uniforms[i].mSlot, uniforms[i].mType, mRenderQueue.getUniformData(uniforms[i]));
+            }
+
+            float instanceOffset = static_cast<float>(run.mFirstInstance);
+            mInstancedShader.setUniform(mInstanceOffsetSlot, FLOAT, &instanceOffset);
+
+            glDrawArraysInstanced(GL_TRIANGLES, 0, 6, static_cast<GLsizei>(run.mDrawAmount));
+            mStats.mDrawCallAmount++;
+            mStats.mBatchAmount++;
+            mStats.mInstanceAmount += run.mDrawAmount;
+        }
+
+        if(instancedActive)
+        {
+            mInstancedShader.deactivate();
+            shader.activate();
+        }
+    }
+#endif
+
+    void Renderer2D::sortQueue(GLuint defaultTextureId)
+    {
+        const std::vector<DrawList::Draw>& draws = mRenderQueue.getDraws();
+        mSortKeys.clear();
+        mDrawOrder.clear();
+
+        for(size_t i = 0; i < draws.size(); i++)
+        {
+            const DrawList::Draw& draw = draws[i];
+            GLuint texture = defaultTextureId;
+
+            const DrawList::UniformValue* uniforms = mRenderQueue.getUniforms(draw);
+            for(uint32_t j = 0; j < draw.mUniformAmount; j++)
+            {
+                if(uniforms[j].mSlot == ShaderSlots::TEXTURE)
+                    std::memcpy(&texture, mRenderQueue.getUniformData(uniforms[j]), sizeof(GLuint));
+            }
+
+            //layer in the highest bits so that layers are never mixed, then the state which is most expensive to change
+            mSortKeys.push_back(static_cast<uint64_t>(draw.mLayer) << 48 | static_cast<uint64_t>(draw.mBlendMode & 0xffff) << 32 | static_cast<uint64_t>(texture));
+            mDrawOrder.push_back(static_cast<uint32_t>(i));
+        }
+
+        radixSort(mSortKeys, mDrawOrder, mSortKeysBuffer, mDrawOrderBuffer);
+    }
+
+    const DrawList::Draw& Renderer2D::getQueuedDraw(size_t index) const
+    {
+        return mRenderQueue.getDraws()[mSorting ? mDrawOrder[index] : index];
+    }
 }
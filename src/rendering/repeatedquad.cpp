@@ -63,5 +63,7 @@ namespace fea
             mTexCoords[i] = newCoords.x;
             mTexCoords[i+1] = newCoords.y;
         }
+
+        markTexCoordsDirty();
     }
 }
@@ -1,7 +1,9 @@
 #include <fea/rendering/shader.hpp>
+#include <fea/rendering/shaderslots.hpp>
 #include <fea/assert.hpp>
 #include <vector>
 #include <sstream>
+#include <cstring>
 #define GLM_FORCE_RADIANS
 #include <glm/gtc/type_ptr.hpp>
 
@@ -12,22 +14,23 @@ namespace fea
     }
 
     Shader::Shader() :
+        mProgramId(0),
         mVertexShader(0),
         mFragmentShader(0),
-        mProgramId(0)
+        mBoundTexture(0)
     {
     }
 
     Shader::Shader(Shader&& other) :
+        mProgramId(0),
         mVertexShader(0),
         mFragmentShader(0),
-        mProgramId(0)
+        mBoundTexture(0)
     {
-        mUniformLocations = std::move(other.mUniformLocations);
-        mVertexAttributeLocations = std::move(other.mVertexAttributeLocations);
+        mUniformSlots = std::move(other.mUniformSlots);
+        mAttributeSlots = std::move(other.mAttributeSlots);
         mVertexSource = std::move(other.mVertexSource);
         mFragmentSource = std::move(other.mFragmentSource);
-        mEnabledVertexAttributes = std::move(other.mEnabledVertexAttributes);
         std::swap(mProgramId, other.mProgramId);
         std::swap(mVertexShader, other.mVertexShader);
         std::swap(mFragmentShader, other.mFragmentShader);
@@ -35,11 +38,10 @@ namespace fea
 
     Shader& Shader::operator=(Shader&& other)
     {
-        mUniformLocations = std::move(other.mUniformLocations);
-        mVertexAttributeLocations = std::move(other.mVertexAttributeLocations);
+        mUniformSlots = std::move(other.mUniformSlots);
+        mAttributeSlots = std::move(other.mAttributeSlots);
         mVertexSource = std::move(other.mVertexSource);
         mFragmentSource = std::move(other.mFragmentSource);
-        mEnabledVertexAttributes = std::move(other.mEnabledVertexAttributes);
         std::swap(mProgramId, other.mProgramId);
         std::swap(mVertexShader, other.mVertexShader);
         std::swap(mFragmentShader, other.mFragmentShader);
@@ -65,62 +67,78 @@ namespace fea
     void Shader::activate() const
     {
         glUseProgram(mProgramId);
+        //other code may have bound textures since the shader was last active
+        mBoundTexture = 0;
     }
 
     void Shader::deactivate() const
     {
-        for(auto location : mEnabledVertexAttributes)
+        for(auto& attribute : mAttributeSlots)
         {
-            glDisableVertexAttribArray(location);
+            if(attribute.mEnabled)
+            {
+                glDisableVertexAttribArray(attribute.mLocation);
+                attribute.mEnabled = false;
+            }
         }
-        mEnabledVertexAttributes.clear();
         glUseProgram(0);
     }
 
     void Shader::setUniform(const std::string& name, UniformType type, const void* value) const
     {
+        setUniform(ShaderSlots::get(name), type, value);
+    }
+
+    void Shader::setUniform(const std::string& name, UniformType type, int32_t count, const void* value) const
+    {
+        UniformSlot* uniform = getUniformSlot(ShaderSlots::get(name));
+        if(!uniform)
+            return;
+
+        GLint location = uniform->mLocation;
+        //values set as arrays are not remembered
+        uniform->mCached = false;
+
         switch(type)
         {
             case FLOAT:
             {
-                glUniform1f(mUniformLocations.at(name), *((float*)value));
+                glUniform1fv(location, count, ((float*)value));
                 break;
             }
             case VEC2:
             {
-                const glm::vec2& val2 = *((glm::vec2*)value);
-                glUniform2f(mUniformLocations.at(name), val2.x, val2.y);
+                glUniform2fv(location, count, ((float*)value));
                 break;
             }
             case VEC3:
             {
-                const glm::vec3& val3 = *((glm::vec3*)value);
-                glUniform3f(mUniformLocations.at(name), val3.x, val3.y, val3.z);
+                glUniform3fv(location, count, ((float*)value));
                 break;
             }
             case VEC4:
             {
-                const glm::vec4& val4 = *((glm::vec4*)value);
-                glUniform4f(mUniformLocations.at(name), val4[0], val4[1], val4[2], val4[3]);
+                glUniform4fv(location, count, ((float*)value));
                 break;
             }
             case MAT2X2:
             {
-                const glm::mat2x2 mat = *((glm::mat2x2*)value);
-                glUniformMatrix2fv(mUniformLocations.at(name), 1, GL_FALSE, glm::value_ptr(mat));
+                const glm::mat2x2* mat = ((glm::mat2x2*)value);
+                glUniformMatrix2fv(location, count, GL_FALSE, glm::value_ptr(*mat));
                 break;
             }
             case MAT4X4:
             {
-                const glm::mat4x4 mat = *((glm::mat4x4*)value);
-                glUniformMatrix4fv(mUniformLocations.at(name), 1, GL_FALSE, glm::value_ptr(mat));
+                const glm::mat4x4* mat = ((glm::mat4x4*)value);
+                glUniformMatrix4fv(location, count, GL_FALSE, glm::value_ptr(*mat));
                 break;
             }
             case TEXTURE:
             {
                 glActiveTexture(GL_TEXTURE0);
-                glUniform1i(mUniformLocations.at(name), 0);
+                glUniform1i(location, 0);
                 glBindTexture(GL_TEXTURE_2D, *((GLuint*)value));
+                mBoundTexture = *((GLuint*)value);
                 break;
             }
             case NO_TYPE:
@@ -131,62 +149,135 @@ namespace fea
         }
     }
 
-    void Shader::setUniform(const std::string& name, UniformType type, int32_t count, const void* value) const
+    void Shader::setVertexAttribute(const std::string& name, const uint32_t floatAmount, const float* data) const
+    {
+        setVertexAttribute(ShaderSlots::get(name), floatAmount, data);
+    }
+
+    void Shader::setVertexBuffer(const std::string& name, const uint32_t floatAmount, GLuint buffer) const
     {
+        setVertexBuffer(ShaderSlots::get(name), floatAmount, buffer);
+    }
+
+    void Shader::setUniform(uint32_t slot, UniformType type, const void* value) const
+    {
+        UniformSlot* uniform = getUniformSlot(slot);
+        if(!uniform)
+            return;
+
+        if(type == TEXTURE)
+        {
+            //the sampler always reads unit 0, so only the bound texture changes
+            if(!uniform->mCached || uniform->mType != TEXTURE)
+            {
+                glUniform1i(uniform->mLocation, 0);
+                uniform->mCached = true;
+                uniform->mType = TEXTURE;
+            }
+
+            GLuint texture = *((const GLuint*)value);
+            if(texture != mBoundTexture)
+            {
+                glActiveTexture(GL_TEXTURE0);
+                glBindTexture(GL_TEXTURE_2D, texture);
+                mBoundTexture = texture;
+            }
+            return;
+        }
+
+        uint32_t floatAmount = Uniform::getFloatAmount(type);
+
+        if(uniform->mCached && uniform->mType == type && std::memcmp(uniform->mValue, value, floatAmount * sizeof(float)) == 0)
+            return;
+
+        const float* floats = (const float*)value;
+
         switch(type)
         {
             case FLOAT:
             {
-                glUniform1fv(mUniformLocations.at(name), count, ((float*)value));
+                glUniform1f(uniform->mLocation, floats[0]);
                 break;
             }
             case VEC2:
             {
-                glUniform2fv(mUniformLocations.at(name), count, ((float*)value));
+                glUniform2f(uniform->mLocation, floats[0], floats[1]);
                 break;
             }
             case VEC3:
             {
-                glUniform3fv(mUniformLocations.at(name), count, ((float*)value));
+                glUniform3f(uniform->mLocation, floats[0], floats[1], floats[2]);
                 break;
             }
             case VEC4:
             {
-                glUniform4fv(mUniformLocations.at(name), count, ((float*)value));
+                glUniform4f(uniform->mLocation, floats[0], floats[1], floats[2], floats[3]);
                 break;
             }
             case MAT2X2:
             {
-                const glm::mat2x2* mat = ((glm::mat2x2*)value);
-                glUniformMatrix2fv(mUniformLocations.at(name), count, GL_FALSE, glm::value_ptr(*mat));
+                glUniformMatrix2fv(uniform->mLocation, 1, GL_FALSE, floats);
                 break;
             }
             case MAT4X4:
             {
-                const glm::mat4x4* mat = ((glm::mat4x4*)value);
-                glUniformMatrix4fv(mUniformLocations.at(name), count, GL_FALSE, glm::value_ptr(*mat));
+                glUniformMatrix4fv(uniform->mLocation, 1, GL_FALSE, floats);
                 break;
             }
             case TEXTURE:
-            {
-                glActiveTexture(GL_TEXTURE0);
-                glUniform1i(mUniformLocations.at(name), 0);
-                glBindTexture(GL_TEXTURE_2D, *((GLuint*)value));
-                break;
-            }
             case NO_TYPE:
             {
                 FEA_ASSERT(false, "Cannot set null uniform on shader!\n");
-                break;
+                return;
             }
         }
+
+        std::memcpy(uniform->mValue, value, floatAmount * sizeof(float));
+        uniform->mType = type;
+        uniform->mCached = true;
     }
 
-    void Shader::setVertexAttribute(const std::string& name, const uint32_t floatAmount, const float* data) const
+    void Shader::setVertexAttribute(uint32_t slot, const uint32_t floatAmount, const float* data) const
+    {
+        setVertexPointer(slot, floatAmount, 0, data);
+    }
+
+    void Shader::setVertexBuffer(uint32_t slot, const uint32_t floatAmount, GLuint buffer, size_t offset) const
     {
-        glEnableVertexAttribArray(mVertexAttributeLocations.at(name));
-        mEnabledVertexAttributes.push_back(mVertexAttributeLocations.at(name));
-        glVertexAttribPointer(mVertexAttributeLocations.at(name), floatAmount, GL_FLOAT, false, 0, data);
+        //GL takes the offset into a buffer in place of the pointer
+        setVertexPointer(slot, floatAmount, buffer, reinterpret_cast<const float*>(offset));
+    }
+
+    void Shader::setTextureBuffer(uint32_t slot, uint32_t unit, GLuint texture) const
+    {
+#ifdef EMSCRIPTEN
+        (void)slot;
+        (void)unit;
+        (void)texture;
+        FEA_ASSERT(false, "Buffer textures are not supported by WebGL!");
+#else
+        UniformSlot* uniform = getUniformSlot(slot);
+        if(!uniform)
+            return;
+
+        glUniform1i(uniform->mLocation, (GLint)unit);
+        //the setter for normal textures is not told about other units, so the uniform is not remembered
+        uniform->mCached = false;
+
+        glActiveTexture(GL_TEXTURE0 + unit);
+        glBindTexture(GL_TEXTURE_BUFFER, texture);
+        glActiveTexture(GL_TEXTURE0);
+#endif
+    }
+
+    bool Shader::hasUniform(uint32_t slot) const
+    {
+        return slot < mUniformSlots.size() && mUniformSlots[slot].mDeclared;
+    }
+
+    bool Shader::hasVertexAttribute(uint32_t slot) const
+    {
+        return slot < mAttributeSlots.size() && mAttributeSlots[slot].mDeclared;
     }
 
     void Shader::compile()
@@ -234,40 +325,87 @@ namespace fea
             throw(GLSLException(ss.str()));
         }
 
-        std::stringstream vertStream(mVertexSource);
+        mUniformSlots.clear();
+        mAttributeSlots.clear();
+        addLocations(mVertexSource, true);
+        addLocations(mFragmentSource, false);
+    }
+
+    void Shader::addLocations(const std::string& source, bool vertexStage)
+    {
+        std::stringstream stream(source);
 
-        for(std::string line; std::getline(vertStream, line);)
+        for(std::string line; std::getline(stream, line);)
         {
-            if(line.find("attribute") != std::string::npos)
+            //GLSL 1.40 and later declare vertex attributes as inputs of the vertex stage
+            if(line.find("attribute") != std::string::npos || (vertexStage && line.compare(0, 3, "in ") == 0))
             {
                 std::string name = line.substr( line.find_first_of(" ", line.find_first_of(" ") + 1) + 1, line.find_first_of(";") - line.find_first_of(" ", line.find_first_of(" ") + 1));
                 name.resize(name.size() - 1);
-                mVertexAttributeLocations.emplace(name, glGetAttribLocation(mProgramId , name.c_str()));
+                uint32_t slot = ShaderSlots::get(name);
+
+                if(slot >= mAttributeSlots.size())
+                    mAttributeSlots.resize(slot + 1, AttributeSlot{-1, false, false, 0, 0, nullptr});
+
+                if(!mAttributeSlots[slot].mDeclared)
+                    mAttributeSlots[slot] = AttributeSlot{glGetAttribLocation(mProgramId , name.c_str()), true, false, 0, 0, nullptr};
             }
             else if(line.find("uniform") != std::string::npos)
             {
                 std::string name = line.substr( line.find_first_of(" ", line.find_first_of(" ") + 1) + 1, line.find_first_of("[;") - line.find_first_of(" ", line.find_first_of(" ") + 1));
                 name.resize(name.size() - 1);
-                mUniformLocations.emplace(name, glGetUniformLocation(mProgramId , name.c_str()));
+                uint32_t slot = ShaderSlots::get(name);
+
+                if(slot >= mUniformSlots.size())
+                    mUniformSlots.resize(slot + 1, UniformSlot{-1, false, false, NO_TYPE, {}});
+
+                if(!mUniformSlots[slot].mDeclared)
+                    mUniformSlots[slot] = UniformSlot{glGetUniformLocation(mProgramId , name.c_str()), true, false, NO_TYPE, {}};
             }
         }
-        
-        std::stringstream fragStream(mFragmentSource);
+    }
+
+    //like a location of -1 in GL, a name the source does not declare is ignored
+    Shader::UniformSlot* Shader::getUniformSlot(uint32_t slot) const
+    {
+        return hasUniform(slot) ? &mUniformSlots[slot] : nullptr;
+    }
+
+    Shader::AttributeSlot* Shader::getAttributeSlot(uint32_t slot) const
+    {
+        return hasVertexAttribute(slot) ? &mAttributeSlots[slot] : nullptr;
+    }
+
+    void Shader::setVertexPointer(uint32_t slot, const uint32_t floatAmount, GLuint buffer, const float* data) const
+    {
+        AttributeSlot* attribute = getAttributeSlot(slot);
+        if(!attribute)
+            return;
+
+        if(!attribute->mEnabled)
+        {
+            glEnableVertexAttribArray(attribute->mLocation);
+            attribute->mEnabled = true;
+        }
+        else if(attribute->mFloatAmount == floatAmount && attribute->mBuffer == buffer && attribute->mData == data)
+        {
+            //client side data is read when drawing, so the same pointer needs no new call even if the data changed
+            return;
+        }
 
-        for(std::string line; std::getline(fragStream, line);)
+        if(buffer)
         {
-            if(line.find("attribute") != std::string::npos)
-            {
-                std::string name = line.substr( line.find_first_of(" ", line.find_first_of(" ") + 1) + 1, line.find_first_of(";") - line.find_first_of(" ", line.find_first_of(" ") + 1));
-                name.resize(name.size() - 1);
-                mVertexAttributeLocations.emplace(name, glGetAttribLocation(mProgramId , name.c_str()));
-            }
-            else if(line.find("uniform") != std::string::npos)
-            {
-                std::string name = line.substr( line.find_first_of(" ", line.find_first_of(" ") + 1) + 1, line.find_first_of("[;") - line.find_first_of(" ", line.find_first_of(" ") + 1));
-                name.resize(name.size() - 1);
-                mUniformLocations.emplace(name, glGetUniformLocation(mProgramId , name.c_str()));
-            }
+            glBindBuffer(GL_ARRAY_BUFFER, buffer);
+            glVertexAttribPointer(attribute->mLocation, floatAmount, GL_FLOAT, false, 0, data);
+            glBindBuffer(GL_ARRAY_BUFFER, 0); //client side arrays need the buffer unbound
         }
+        else
+        {
+            glVertexAttribPointer(attribute->mLocation, floatAmount, GL_FLOAT, false, 0, data);
+        }
+
+        attribute->mFloatAmount = floatAmount;
+        attribute->mBuffer = buffer;
+        attribute->mData = data;
     }
 }
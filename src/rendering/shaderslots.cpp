@@ -0,0 +1,61 @@
+#include <fea/rendering/shaderslots.hpp>
+#include <fea/assert.hpp>
+#include <deque>
+#include <unordered_map>
+
+namespace
+{
+    struct SlotTable
+    {
+        SlotTable()
+        {
+            //must be in the same order as ShaderSlots::BuiltIn
+            for(const char* name : {"position", "origin", "rotation", "scaling", "parallax", "constraints", "color", "opacity", "texture", "camPosition", "camZoom", "camRotation", "halfViewSize", "projection", "vertex", "texCoords", "colors"})
+                add(name);
+        }
+
+        uint32_t add(const std::string& name)
+        {
+            uint32_t slot = static_cast<uint32_t>(mNames.size());
+            mNames.push_back(name);
+            mSlots.emplace(name, slot);
+            return slot;
+        }
+
+        //a deque keeps the names in place so that references to them stay valid
+        std::deque<std::string> mNames;
+        std::unordered_map<std::string, uint32_t> mSlots;
+    };
+
+    SlotTable& getTable()
+    {
+        static SlotTable table;
+        return table;
+    }
+}
+
+namespace fea
+{
+    uint32_t ShaderSlots::get(const std::string& name)
+    {
+        SlotTable& table = getTable();
+        auto slot = table.mSlots.find(name);
+
+        if(slot != table.mSlots.end())
+            return slot->second;
+
+        return table.add(name);
+    }
+
+    const std::string& ShaderSlots::getName(uint32_t slot)
+    {
+        SlotTable& table = getTable();
+        FEA_ASSERT(slot < table.mNames.size(), "Trying to get the name of shader slot " + std::to_string(slot) + " which does not exist!");
+        return table.mNames[slot];
+    }
+
+    uint32_t ShaderSlots::getAmount()
+    {
+        return static_cast<uint32_t>(getTable().mNames.size());
+    }
+}
@@ -0,0 +1,233 @@
+#include <fea/rendering/streambuffer.hpp>
+#include <fea/assert.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#ifndef EMSCRIPTEN
+namespace
+{
+    bool hasExtension(const char* extensions, const char* name)
+    {
+        size_t length = std::strlen(name);
+
+        //names must match whole since some are the start of others
+        for(const char* found = std::strstr(extensions, name); found; found = std::strstr(found + length, name))
+        {
+            if((found == extensions || found[-1] == ' ') && (found[length] == ' ' || found[length] == '\0'))
+                return true;
+        }
+
+        return false;
+    }
+
+    //regions are mapped with glMapBufferRange from GL 3.0 and fenced with sync objects from GL 3.2, which older contexts can only offer as extensions
+    bool canMapRegions()
+    {
+        int major = 0;
+        int minor = 0;
+        const GLubyte* version = glGetString(GL_VERSION);
+
+        if(!version || std::sscanf(reinterpret_cast<const char*>(version), "%d.%d", &major, &minor) != 2)
+            return false;
+
+        if(major > 3 || (major == 3 && minor >= 2))
+            return true;
+
+        const GLubyte* extensions = glGetString(GL_EXTENSIONS);
+
+        if(!extensions)
+            return false;
+
+        const char* names = reinterpret_cast<const char*>(extensions);
+        return hasExtension(names, "GL_ARB_sync") && (major == 3 || hasExtension(names, "GL_ARB_map_buffer_range"));
+    }
+}
+#endif
+
+namespace fea
+{
+    StreamBuffer::StreamBuffer(size_t regionFloatAmount, uint32_t regionAmount) :
+        mId(0),
+        mRegionFloatAmount(regionFloatAmount),
+        mRegionAmount(regionAmount),
+        mRegion(0),
+        mWriteOffset(0),
+        mRequestedAmount(0),
+        mMapped(nullptr),
+        mMappingChecked(false),
+        mMappingSupported(false),
+        mClientChunk(0),
+        mClientOffset(0)
+    {
+        FEA_ASSERT(regionFloatAmount > 0 && regionAmount > 0, "Stream buffers need at least one region with a size bigger than zero!");
+#ifndef EMSCRIPTEN
+        mFences.resize(regionAmount, nullptr);
+#endif
+    }
+
+    StreamBuffer::Allocation StreamBuffer::allocate(size_t floatAmount)
+    {
+        FEA_ASSERT(floatAmount > 0, "Trying to allocate zero floats from a stream buffer!");
+        mRequestedAmount += floatAmount;
+
+#ifndef EMSCRIPTEN
+        //without mapping, nothing is ever written to the GL buffer, so there are no fences to place or wait for either
+        if(!mMappingChecked)
+        {
+            mMappingSupported = canMapRegions();
+            mMappingChecked = true;
+        }
+
+        if(mMappingSupported && mWriteOffset + floatAmount <= mRegionFloatAmount && (mMapped || map()))
+        {
+            Allocation allocation{mMapped + mWriteOffset, mId, (mRegion * mRegionFloatAmount + mWriteOffset) * sizeof(float)};
+            mWriteOffset += floatAmount;
+            return allocation;
+        }
+#endif
+
+        return Allocation{allocateClientSide(floatAmount), 0, 0};
+    }
+
+    void StreamBuffer::unmap()
+    {
+#ifndef EMSCRIPTEN
+        if(!mMapped)
+            return;
+
+        glBindBuffer(GL_ARRAY_BUFFER, mId);
+        if(mWriteOffset > 0)
+            glFlushMappedBufferRange(GL_ARRAY_BUFFER, 0, (GLsizeiptr)(mWriteOffset * sizeof(float)));
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        mMapped = nullptr;
+#endif
+    }
+
+    void StreamBuffer::endRegion()
+    {
+        unmap();
+
+#ifndef EMSCRIPTEN
+        //an unused region needs no fence and can be written again right away
+        if(mWriteOffset > 0)
+        {
+            mFences[mRegion] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            mRegion = (mRegion + 1) % mRegionAmount;
+        }
+
+        if(mRequestedAmount > mRegionFloatAmount)
+        {
+            while(mRegionFloatAmount < mRequestedAmount)
+                mRegionFloatAmount *= 2;
+
+            //orphaning the old storage lets the driver keep it until the GPU is done with it, so no fence has to be waited for
+            if(mId)
+            {
+                glBindBuffer(GL_ARRAY_BUFFER, mId);
+                glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)(mRegionFloatAmount * mRegionAmount * sizeof(float)), nullptr, GL_STREAM_DRAW);
+                glBindBuffer(GL_ARRAY_BUFFER, 0);
+            }
+
+            for(GLsync& fence : mFences)
+            {
+                if(fence)
+                    glDeleteSync(fence);
+                fence = nullptr;
+            }
+
+            mRegion = 0;
+        }
+#endif
+
+        mWriteOffset = 0;
+        mRequestedAmount = 0;
+        mClientChunk = 0;
+        mClientOffset = 0;
+    }
+
+    size_t StreamBuffer::getRegionFloatAmount() const
+    {
+        return mRegionFloatAmount;
+    }
+
+    uint32_t StreamBuffer::getRegionAmount() const
+    {
+        return mRegionAmount;
+    }
+
+    StreamBuffer::~StreamBuffer()
+    {
+#ifndef EMSCRIPTEN
+        for(GLsync fence : mFences)
+        {
+            if(fence)
+                glDeleteSync(fence);
+        }
+
+        //deleting a mapped buffer unmaps it
+        if(mId)
+            glDeleteBuffers(1, &mId);
+#endif
+    }
+
+#ifndef EMSCRIPTEN
+    bool StreamBuffer::map()
+    {
+        if(!mId)
+        {
+            glGenBuffers(1, &mId);
+            FEA_ASSERT(mId != 0, "Failed to create stream buffer. Make sure there is a valid OpenGL context available!");
+            glBindBuffer(GL_ARRAY_BUFFER, mId);
+            glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)(mRegionFloatAmount * mRegionAmount * sizeof(float)), nullptr, GL_STREAM_DRAW);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+        }
+
+        waitForRegion(mRegion);
+
+        //the fence already made sure that the GPU is done with the region, so the driver does not need to synchronise
+        glBindBuffer(GL_ARRAY_BUFFER, mId);
+        mMapped = static_cast<float*>(glMapBufferRange(GL_ARRAY_BUFFER, (GLintptr)(mRegion * mRegionFloatAmount * sizeof(float)), (GLsizeiptr)(mRegionFloatAmount * sizeof(float)), GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_FLUSH_EXPLICIT_BIT));
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        return mMapped != nullptr;
+    }
+
+    void StreamBuffer::waitForRegion(uint32_t region)
+    {
+        GLsync& fence = mFences[region];
+
+        if(!fence)
+            return;
+
+        //a timeout only means that the GPU is still busy, anything else ends the wait
+        while(glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED)
+        {
+        }
+
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+#endif
+
+    float* StreamBuffer::allocateClientSide(size_t floatAmount)
+    {
+        //chunks are never resized while earlier allocations point into them
+        if(mClientChunk < mClientChunks.size() && mClientOffset + floatAmount > mClientChunks[mClientChunk].size())
+        {
+            mClientChunk++;
+            mClientOffset = 0;
+        }
+
+        if(mClientChunk == mClientChunks.size())
+            mClientChunks.emplace_back(std::max(floatAmount, mRegionFloatAmount));
+        else if(mClientChunks[mClientChunk].size() < floatAmount)
+            mClientChunks[mClientChunk].resize(floatAmount);
+
+        float* data = &mClientChunks[mClientChunk][mClientOffset];
+        mClientOffset += floatAmount;
+        return data;
+    }
+}
@@ -24,6 +24,7 @@ namespace fea
                       texCoordsX[1], texCoordsY[0],
                       texCoordsX[0], texCoordsY[1],
                       texCoordsX[1], texCoordsY[1]};
+        markTexCoordsDirty();
     }
 
     std::vector<RenderEntity> SubrectQuad::getRenderInfo() const
@@ -1,5 +1,6 @@
 #include <fea/rendering/textsurface.hpp>
 #include <fea/rendering/font.hpp>
+#include <fea/rendering/shaderslots.hpp>
 #include <fea/assert.hpp>
 #include <iostream>
 
@@ -239,12 +240,22 @@ namespace fea
         temp[0].mUniforms.push_back(Uniform("texture", TEXTURE, mAtlas->id));
         return temp;
     }
+
+    void TextSurface::queueRenderInfo(DrawList& drawList) const
+    {
+        queueBaseRenderInfo(drawList);
+
+        drawList.addTexture(ShaderSlots::TEXTURE, mAtlas->id);
+    }
     
     void TextSurface::rewrite()
     {
         mVertices.clear();
         mTexCoords.clear();
         mVertexColors.clear();
+        markVerticesDirty();
+        markTexCoordsDirty();
+        markVertexColorsDirty();
 
         //const glm::vec2 originalPosition = mPenPosition;
         //const Font* originalFont = mCurrentFont;
@@ -273,6 +284,9 @@ namespace fea
         mVertices.clear();
         mTexCoords.clear();
         mVertexColors.clear();
+        markVerticesDirty();
+        markTexCoordsDirty();
+        markVertexColorsDirty();
 
         mWritings.clear();
 
@@ -1,4 +1,5 @@
 #include <fea/rendering/tilechunk.hpp>
+#include <fea/rendering/shaderslots.hpp>
 
 namespace fea
 {
@@ -147,6 +148,7 @@ namespace fea
             mTexCoords[texCoordIndex + 6] =  coordinates[2].x; mTexCoords[texCoordIndex + 7] =  coordinates[2].y;
             mTexCoords[texCoordIndex + 8] =  coordinates[1].x; mTexCoords[texCoordIndex + 9] =  coordinates[1].y;
             mTexCoords[texCoordIndex + 10] = coordinates[3].x; mTexCoords[texCoordIndex + 11] = coordinates[3].y;
+            markTexCoordsDirty(texCoordIndex, texCoordIndex + 12);
         }
     }
     
@@ -167,6 +169,11 @@ namespace fea
             mTexCoords.erase(mTexCoords.begin() + texCoordIndex, mTexCoords.begin() + texCoordIndex + 12);
             mVertexColors.erase(mVertexColors.begin() + colorIndex, mVertexColors.begin() + colorIndex + 24);
 
+            //everything after the removed tile moved down
+            markVerticesDirty(vertexIndex);
+            markTexCoordsDirty(texCoordIndex);
+            markVertexColorsDirty(colorIndex);
+
             mTileInfo.erase(tile);
 
             for(auto& info : mTileInfo)
@@ -204,6 +211,7 @@ namespace fea
             mVertexColors[colorIndex + 12] = color.rAsFloat(); mVertexColors[colorIndex + 13] = color.gAsFloat(); mVertexColors[colorIndex + 14] = color.bAsFloat(); mVertexColors[colorIndex + 15] = color.aAsFloat();
             mVertexColors[colorIndex + 16] = color.rAsFloat(); mVertexColors[colorIndex + 17] = color.gAsFloat(); mVertexColors[colorIndex + 18] = color.bAsFloat(); mVertexColors[colorIndex + 19] = color.aAsFloat();
             mVertexColors[colorIndex + 20] = color.rAsFloat(); mVertexColors[colorIndex + 21] = color.gAsFloat(); mVertexColors[colorIndex + 22] = color.bAsFloat(); mVertexColors[colorIndex + 23] = color.aAsFloat();
+            markVertexColorsDirty(colorIndex, colorIndex + 24);
         }
     }
     
@@ -212,6 +220,9 @@ namespace fea
         mTexCoords.clear();
         mVertexColors.clear();
         mVertices.clear();
+        markTexCoordsDirty();
+        markVertexColorsDirty();
+        markVerticesDirty();
         mTileInfo.clear();
     }
             
@@ -230,6 +241,13 @@ namespace fea
 
         return temp;
     }
+
+    void TileChunk::queueRenderInfo(DrawList& drawList) const
+    {
+        queueBaseRenderInfo(drawList);
+
+        drawList.addTexture(ShaderSlots::TEXTURE, getTexture().getId());
+    }
     
     void TileChunk::setOriginalOrigin(const glm::vec2& origin)
     {
@@ -116,4 +116,25 @@ namespace fea
                 break;
         }
     }
+
+    uint32_t Uniform::getFloatAmount(UniformType type)
+    {
+        switch(type)
+        {
+            case FLOAT:
+            case TEXTURE:
+                return 1;
+            case VEC2:
+                return 2;
+            case VEC3:
+                return 3;
+            case VEC4:
+            case MAT2X2:
+                return 4;
+            case MAT4X4:
+                return 16;
+            default:
+                return 0;
+        }
+    }
 }
@@ -0,0 +1,137 @@
+#include <fea/rendering/vertexbuffer.hpp>
+#include <fea/assert.hpp>
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace fea
+{
+    VertexBuffer::VertexBuffer() : mId(0), mCapacity(0), mSize(0), mDirtyStart(0), mDirtyEnd(0)
+    {
+    }
+
+    VertexBuffer::VertexBuffer(const VertexBuffer&) : VertexBuffer()
+    {
+    }
+
+    VertexBuffer& VertexBuffer::operator=(const VertexBuffer&)
+    {
+        markDirty();
+        return *this;
+    }
+
+    VertexBuffer::VertexBuffer(VertexBuffer&& other) : VertexBuffer()
+    {
+        std::swap(mId, other.mId);
+        std::swap(mCapacity, other.mCapacity);
+        std::swap(mSize, other.mSize);
+        std::swap(mDirtyStart, other.mDirtyStart);
+        std::swap(mDirtyEnd, other.mDirtyEnd);
+    }
+
+    VertexBuffer& VertexBuffer::operator=(VertexBuffer&& other)
+    {
+        std::swap(mId, other.mId);
+        std::swap(mCapacity, other.mCapacity);
+        std::swap(mSize, other.mSize);
+        std::swap(mDirtyStart, other.mDirtyStart);
+        std::swap(mDirtyEnd, other.mDirtyEnd);
+        return *this;
+    }
+
+    void VertexBuffer::markDirty(size_t start, size_t end)
+    {
+        if(start >= end)
+            return;
+
+        if(mDirtyStart >= mDirtyEnd)
+        {
+            mDirtyStart = start;
+            mDirtyEnd = end;
+        }
+        else
+        {
+            mDirtyStart = std::min(mDirtyStart, start);
+            mDirtyEnd = std::max(mDirtyEnd, end);
+        }
+    }
+
+    void VertexBuffer::markDirty()
+    {
+        markDirty(0, std::numeric_limits<size_t>::max());
+    }
+
+    GLuint VertexBuffer::update(const std::vector<float>& data)
+    {
+        //values past the old end are always new
+        if(data.size() > mSize)
+            markDirty(mSize, data.size());
+
+        mSize = data.size();
+
+        if(mSize == 0)
+        {
+            mDirtyStart = mDirtyEnd = 0;
+            return mId;
+        }
+
+        size_t dirtyEnd = std::min(mDirtyEnd, mSize);
+
+        if(mDirtyStart >= dirtyEnd && mId)
+        {
+            mDirtyStart = mDirtyEnd = 0;
+            return mId;
+        }
+
+        if(!mId)
+        {
+            glGenBuffers(1, &mId);
+            FEA_ASSERT(mId != 0, "Failed to create vertex buffer. Make sure there is a valid OpenGL context available!");
+            mCapacity = 0;
+            mDirtyStart = 0;
+            dirtyEnd = mSize;
+        }
+
+        glBindBuffer(GL_ARRAY_BUFFER, mId);
+
+        if(mSize > mCapacity)
+        {
+            //grow geometrically so that data built up piece by piece does not reallocate every time
+            mCapacity = std::max(mSize, mCapacity * 2);
+            glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)(mCapacity * sizeof(float)), nullptr, GL_STATIC_DRAW);
+            mDirtyStart = 0;
+            dirtyEnd = mSize;
+        }
+
+        if(mDirtyStart < dirtyEnd)
+            glBufferSubData(GL_ARRAY_BUFFER, (GLintptr)(mDirtyStart * sizeof(float)), (GLsizeiptr)((dirtyEnd - mDirtyStart) * sizeof(float)), &data[mDirtyStart]);
+
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        mDirtyStart = mDirtyEnd = 0;
+        return mId;
+    }
+
+    GLuint VertexBuffer::getId() const
+    {
+        return mId;
+    }
+
+    void VertexBuffer::destroy()
+    {
+        if(mId)
+        {
+            glDeleteBuffers(1, &mId);
+            mId = 0;
+        }
+
+        mCapacity = 0;
+        markDirty();
+    }
+
+    VertexBuffer::~VertexBuffer()
+    {
+        if(mId)
+            glDeleteBuffers(1, &mId);
+    }
+}